@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "rapidudf/ast/context.h"
+#include <algorithm>
 #include <array>
 #include <vector>
 #include "absl/strings/str_split.h"
@@ -106,6 +107,10 @@ int ParseContext::GetLineNo() const {
   }
   return lineno;
 }
+int ParseContext::GetLineNo(uint32_t position) const {
+  size_t end = std::min<size_t>(position, source_.size());
+  return 1 + static_cast<int>(std::count(source_.begin(), source_.begin() + end, '\n'));
+}
 std::string ParseContext::GetErrorLine() const {
   uint32_t cursor = 0;
   uint32_t lineno = 1;
@@ -151,6 +156,15 @@ bool ParseContext::CanCastTo(DType from_dtype, DType to_dtype) {
   return v;
 }
 
+bool ParseContext::HasFunction(const std::string& name) const {
+  for (uint32_t i = 0; i <= current_function_cursor_ && i < function_parse_ctxs_.size(); i++) {
+    if (GetFunctionParseContext(i).desc.name == name) {
+      return true;
+    }
+  }
+  return FunctionFactory::GetFunction(name) != nullptr;
+}
+
 absl::StatusOr<const FunctionDesc*> ParseContext::CheckFuncExist(const std::string& name, bool implicit) {
   const FunctionDesc* desc = nullptr;
   bool local_func = false;
@@ -171,7 +185,11 @@ absl::StatusOr<const FunctionDesc*> ParseContext::CheckFuncExist(const std::stri
     return absl::InvalidArgumentError(fmt::format(
         "Function:{} need `rapidudf::Context` arg, missing in expression/udf args, at `{}`", name, GetErrorLine()));
   }
-  if (!local_func) {
+  if (local_func) {
+    if (name != GetFunctionParseContext(current_function_cursor_).desc.name) {
+      GetFunctionParseContext(current_function_cursor_).local_func_calls.emplace(name);
+    }
+  } else {
     if (implicit) {
       GetFunctionParseContext(current_function_cursor_).implicit_func_calls.emplace(name, desc);
     } else {
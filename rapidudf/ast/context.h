@@ -18,6 +18,7 @@
 
 #include <chrono>
 #include <cstdint>
+#include <set>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -64,10 +65,15 @@ class ParseContext {
   std::string GetErrorLine() const;
 
   int GetLineNo() const;
+  // 1-based line of the offset in source
+  int GetLineNo(uint32_t position) const;
+  const std::string& GetSource() const { return source_; }
   std::string GetSourceLine(int line) const;
 
   bool AddLocalVar(const std::string& name, DType dtype, const DynObjectSchema* schema);
 
+  // local udf or registered function with exactly this name
+  bool HasFunction(const std::string& name) const;
   absl::StatusOr<const FunctionDesc*> CheckFuncExist(const std::string& name, bool implicit = false);
   absl::StatusOr<const FunctionDesc*> CheckFuncExist(std::string_view name, bool implicit = false) {
     return CheckFuncExist(std::string(name), implicit);
@@ -87,6 +93,10 @@ class ParseContext {
   const MemberFuncCallMap& GetAllMemberFuncCalls(uint32_t funcion_idx) const {
     return GetFunctionParseContext(funcion_idx).member_func_calls;
   }
+  // udfs defined before in the same source called by the function, exclude itself
+  const std::set<std::string>& GetAllLocalFuncCalls(uint32_t funcion_idx) const {
+    return GetFunctionParseContext(funcion_idx).local_func_calls;
+  }
 
   std::vector<FunctionDesc> GetAllFunctionDescs() const;
 
@@ -117,6 +127,7 @@ class ParseContext {
     FunctionCallMap func_calls;
     FunctionCallMap implicit_func_calls;
     MemberFuncCallMap member_func_calls;
+    std::set<std::string> local_func_calls;
     FunctionDesc desc;
     uint32_t in_loop = 0;
   };
@@ -236,7 +236,8 @@ absl::StatusOr<VarTag> FieldAccess::Validate(ParseContext& ctx, VarTag src) {
       return func_arg_dtypes.status();
     }
     auto arg_dtypes = func_arg_dtypes.value();
-    if (is_table && (field == "topk" || field == "order_by")) {
+    if (is_table && (field == "topk" || field == "topk_filter" || field == "order_by" || field == "mmr" ||
+                     field == "weighted_sample")) {
       if (arg_dtypes.size() > 1) {
         field = GetFunctionName(field, arg_dtypes[0].dtype.Elem());
       }
@@ -750,9 +751,13 @@ absl::StatusOr<VarTag> VarAccessor::Validate(ParseContext& ctx, RPN& rpn, bool&
     return var_dtype;
   } else if (func_args.has_value()) {
     const FunctionDesc* func_desc = nullptr;
+    const FunctionDesc* lane_vector_func_desc = nullptr;
     DType compute_dtype;
     bool has_simd_vector = false;
-    builtin_op = functions::get_buitin_func_op(name);
+    // udfs & registered functions take precedence over builtin ops of the same name, e.g. a udf named `rank`
+    if (!ctx.HasFunction(name)) {
+      builtin_op = functions::get_buitin_func_op(name);
+    }
     int operand_count = get_operand_count(builtin_op);
     bool use_current_rpn = false;
     bool need_compute_dtype = false;
@@ -765,6 +770,8 @@ absl::StatusOr<VarTag> VarAccessor::Validate(ParseContext& ctx, RPN& rpn, bool&
       func_desc = result.value();
       if (func_desc->is_vector_func) {
         use_current_rpn = true;
+      } else {
+        lane_vector_func_desc = FunctionFactory::GetFunction(GetVectorFunctionName(name));
       }
     }
 
@@ -798,6 +805,20 @@ absl::StatusOr<VarTag> VarAccessor::Validate(ParseContext& ctx, RPN& rpn, bool&
       arg_dtypes.emplace_back(arg_dtype.dtype);
     }
 
+    if (has_simd_vector && nullptr != lane_vector_func_desc) {
+      // scalar func registered with a vector kernel, move args into current rpn to evaluate it per vector block.
+      auto result = ctx.CheckFuncExist(lane_vector_func_desc->name);
+      if (!result.ok()) {
+        return result.status();
+      }
+      func_desc = result.value();
+      for (auto& arg_rpn : func_args->rpns) {
+        rpn.nodes.insert(rpn.nodes.end(), arg_rpn.nodes.begin(), arg_rpn.nodes.end());
+      }
+      func_args->rpns.clear();
+      use_current_rpn = true;
+    }
+
     if (builtin_op != OP_INVALID) {
       if (!functions::has_vector_buitin_func(builtin_op, compute_dtype) && has_simd_vector && operand_count > 0) {
         rpn.nodes.emplace_back(builtin_op);
@@ -851,7 +872,7 @@ absl::StatusOr<VarTag> VarAccessor::Validate(ParseContext& ctx, RPN& rpn, bool&
 
     if (use_current_rpn) {  // vector func
       rpn.nodes.emplace_back(FuncInvocation(func_desc));
-      DType ret_dtype = func_desc->LastArg().PtrTo().ToSimdVector();
+      DType ret_dtype = func_desc->VectorOutputArg().PtrTo().ToSimdVector();
       rpn.SetDType(ctx, ret_dtype);
       as_rpn_node = true;
       return ret_dtype;
@@ -50,6 +50,7 @@ boost::parser::symbols<std::pair<DType, DTypeAttr>> Symbols::kDtypeSymbols = {
     {"u64", {DType(DATA_U64), empty_attr}},
     {"i64", {DType(DATA_I64), empty_attr}},
     {"f16", {DType(DATA_F16), empty_attr}},
+    {"bf16", {DType(DATA_BF16), empty_attr}},
     {"f32", {DType(DATA_F32), empty_attr}},
     {"f64", {DType(DATA_F64), empty_attr}},
     {"f80", {DType(DATA_F80), empty_attr}},
@@ -104,7 +105,17 @@ void Symbols::Add(const std::string& name, DType dtype, DTypeAttr attr) {
 }
 void Symbols::Init() {
   static std::mutex mutex;
+  static size_t inited_dtype_num = 0;
+  static size_t inited_schema_num = 0;
   std::lock_guard<std::mutex> guard(mutex);
+  // dtypes & schemas are never removed, skip the walk if nothing registered since last init
+  size_t dtype_num = DTypeFactory::Size();
+  size_t schema_num = DynObjectSchema::Size();
+  if (dtype_num == inited_dtype_num && schema_num == inited_schema_num && dtype_num > 0) {
+    return;
+  }
+  inited_dtype_num = dtype_num;
+  inited_schema_num = schema_num;
   DTypeFactory::Visit([](const std::string& name, DType dtype) {
     std::string_view name_view;
     auto& symbol_cache = get_symbol_token_cache();
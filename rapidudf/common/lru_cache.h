@@ -45,19 +45,23 @@ class lru_cache {
 
   bool contains(const key_type& key) { return m_map.find(key) != m_map.end(); }
 
-  void insert(const key_type& key, const value_type& value) {
+  // returns true if the least recently used item was evicted
+  bool insert(const key_type& key, const value_type& value) {
+    bool evicted = false;
     typename map_type::iterator i = m_map.find(key);
     if (i == m_map.end()) {
       // insert item into the cache, but first check if it is full
       if (size() >= m_capacity) {
         // cache is full, evict the least recently used item
         evict();
+        evicted = true;
       }
 
       // insert the new item
       m_list.push_front(key);
       m_map[key] = std::make_pair(value, m_list.begin());
     }
+    return evicted;
   }
 
   void erase(const key_type& key) {
@@ -14,18 +14,29 @@
  * limitations under the License.
  */
 #include "rapidudf/compiler/codegen.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 #include "fmt/format.h"
 #include "llvm/ADT/APFloat.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ExecutionEngine/Orc/LLJIT.h"
+#include "llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h"
 #include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
+#include "llvm/ExecutionEngine/SectionMemoryManager.h"
 #include "llvm/IR/Argument.h"
+#include "llvm/IR/DebugInfoMetadata.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/GlobalValue.h"
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/MDBuilder.h"
 #include "llvm/IR/Mangler.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
@@ -51,16 +62,52 @@
 #include "llvm/Transforms/Vectorize/SLPVectorizer.h"
 #include "llvm/Transforms/Vectorize/VectorCombine.h"
 
+#include "rapidudf/compiler/jit_listener.h"
 #include "rapidudf/compiler/type.h"
+#include "rapidudf/functions/names.h"
 #include "rapidudf/log/log.h"
 #include "rapidudf/meta/constants.h"
 #include "rapidudf/meta/dtype.h"
 #include "rapidudf/meta/dtype_enums.h"
 #include "rapidudf/meta/optype.h"
+#include "rapidudf/metrics/metrics.h"
 namespace rapidudf {
 namespace compiler {
+namespace {
+// reports the bytes of jit code & data sections alive into the builtin metrics, `gauge` is null if disabled.
+class MeteredMemoryManager : public ::llvm::SectionMemoryManager {
+ public:
+  explicit MeteredMemoryManager(metrics::Gauge* gauge) : gauge_(gauge) {}
+  ~MeteredMemoryManager() override {
+    if (nullptr != gauge_) {
+      gauge_->Add(-allocated_);
+    }
+  }
+
+  uint8_t* allocateCodeSection(uintptr_t size, unsigned alignment, unsigned section_id,
+                               ::llvm::StringRef section_name) override {
+    Record(size);
+    return SectionMemoryManager::allocateCodeSection(size, alignment, section_id, section_name);
+  }
+  uint8_t* allocateDataSection(uintptr_t size, unsigned alignment, unsigned section_id, ::llvm::StringRef section_name,
+                               bool readonly) override {
+    Record(size);
+    return SectionMemoryManager::allocateDataSection(size, alignment, section_id, section_name, readonly);
+  }
 
-CodeGen::CodeGen(const Options& opts) : opts_(opts), label_cursor_(0) {
+ private:
+  void Record(uintptr_t size) {
+    if (nullptr != gauge_) {
+      allocated_ += static_cast<int64_t>(size);
+      gauge_->Add(static_cast<int64_t>(size));
+    }
+  }
+  metrics::Gauge* gauge_ = nullptr;
+  int64_t allocated_ = 0;
+};
+}  // namespace
+
+std::shared_ptr<::llvm::orc::LLJIT> CodeGen::NewJit(const Options& opts) {
   ::llvm::InitializeNativeTarget();
   ::llvm::InitializeNativeTargetAsmPrinter();
   ::llvm::InitializeNativeTargetAsmParser();
@@ -70,9 +117,39 @@ CodeGen::CodeGen(const Options& opts) : opts_(opts), label_cursor_(0) {
   // RUDF_INFO("cpu:{}", JTMB->getCPU());
   ::llvm::orc::LLJITBuilder jit_builder;
   jit_builder.setJITTargetMachineBuilder(*JTMB);
+  metrics::Gauge* gauge = nullptr;
+  if (auto* m = metrics::builtin_metrics()) {
+    gauge = m->jit_code_bytes;
+  }
+  // profiling listeners are only supported by the RuntimeDyld linking layer
+  if (nullptr != gauge || opts.jit_profiling) {
+    jit_builder.setObjectLinkingLayerCreator(
+        [gauge](::llvm::orc::ExecutionSession& es,
+                const ::llvm::Triple&) -> ::llvm::Expected<std::unique_ptr<::llvm::orc::ObjectLayer>> {
+          // generic lambda since the memory manager getter signature differs between llvm versions
+          return std::make_unique<::llvm::orc::RTDyldObjectLinkingLayer>(
+              es, [gauge](auto&&...) { return std::make_unique<MeteredMemoryManager>(gauge); });
+        });
+  }
   // jit_builder.getJITTargetMachineBuilder()->setCPU("haswell");
   auto result = jit_builder.create();
-  jit_ = std::move(*result);
+  std::shared_ptr<::llvm::orc::LLJIT> jit = std::move(*result);
+  if (opts.jit_profiling) {
+    register_profiling_listeners(static_cast<::llvm::orc::RTDyldObjectLinkingLayer&>(jit->getObjLinkingLayer()));
+  }
+  return jit;
+}
+
+CodeGen::CodeGen(const Options& opts, std::shared_ptr<::llvm::orc::LLJIT> jit)
+    : opts_(opts), jit_(std::move(jit)), label_cursor_(0) {
+  if (!jit_) {
+    jit_ = NewJit(opts_);
+  }
+  static std::atomic<uint64_t> dylib_seq = {0};
+  auto dylib = jit_->createJITDylib(fmt::format("rapidudf_{}", dylib_seq.fetch_add(1)));
+  dylib_ = &(*dylib);
+  // process symbols are resolved by the main dylib
+  dylib_->addToLinkOrder(jit_->getMainJITDylib());
   context_ = std::make_unique<::llvm::LLVMContext>();
   module_ = std::make_unique<::llvm::Module>("RapidUDF", *context_);
   builder_ = std::make_unique<::llvm::IRBuilder<>>(*context_);
@@ -142,18 +219,92 @@ CodeGen::CodeGen(const Options& opts) : opts_(opts), label_cursor_(0) {
   func_pass_manager_->addPass(::llvm::LoopVectorizePass());
 }
 
+CodeGen::~CodeGen() {
+  // frees the jit code of this session, the shared jit is kept for later compiles
+  if (nullptr != dylib_) {
+    if (auto err = jit_->getExecutionSession().removeJITDylib(*dylib_)) {
+      RUDF_WARN("Failed to remove jit dylib:{}", ::llvm::toString(std::move(err)));
+    }
+  }
+}
+
 absl::Status CodeGen::Finish() {
+  if (di_builder_) {
+    di_builder_->finalize();
+  }
   if (opts_.print_asm) {
     module_->print(::llvm::errs(), nullptr);
   }
   ::llvm::orc::ThreadSafeModule module(std::move(module_), std::move(context_));
-  auto err = jit_->addIRModule(std::move(module));
+  auto err = jit_->addIRModule(*dylib_, std::move(module));
   RUDF_LOG_RETURN_LLVM_ERROR(err);
   return absl::OkStatus();
 }
 
+// per process directory created by mkdtemp, so udf source files can not be raced or redirected by symlinks
+static const std::string& get_udf_source_dir() {
+  static const std::string dir = []() {
+    char tmpl[] = "/tmp/rapidudf_XXXXXX";
+    if (mkdtemp(tmpl) == nullptr) {
+      RUDF_WARN("Failed to create udf source dir:{}", strerror(errno));
+      return std::string();
+    }
+    return std::string(tmpl);
+  }();
+  return dir;
+}
+
+void CodeGen::SetSource(std::string_view source) {
+  if (!opts_.jit_profiling) {
+    return;
+  }
+  uint64_t hash = 14695981039346656037ULL;
+  for (char c : source) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+  }
+  symbol_suffix_ = fmt::format("{:016x}", hash);
+  if (!opts_.jit_debug_info) {
+    return;
+  }
+  // debuggers & `perf annotate` read the source from the file in line tables
+  std::string dir = get_udf_source_dir();
+  std::string file_name = fmt::format("rapidudf_{}.udf", symbol_suffix_);
+  std::string path = fmt::format("{}/{}", dir, file_name);
+  // same source hash in the private dir means the file is already written
+  int fd = dir.empty() ? -1 : open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, 0600);
+  if (fd >= 0) {
+    if (FILE* fp = fdopen(fd, "w")) {
+      fwrite(source.data(), 1, source.size(), fp);
+      fclose(fp);
+    } else {
+      close(fd);
+    }
+  } else if (dir.empty() || errno != EEXIST) {
+    RUDF_WARN("Failed to write udf source into {}", path);
+  }
+  di_builder_ = std::make_unique<::llvm::DIBuilder>(*module_);
+  di_file_ = di_builder_->createFile(file_name, dir);
+  di_builder_->createCompileUnit(::llvm::dwarf::DW_LANG_C, di_file_, "rapidudf", opts_.optimize_level > 0, "", 0);
+  module_->addModuleFlag(::llvm::Module::Warning, "Debug Info Version", ::llvm::DEBUG_METADATA_VERSION);
+  module_->addModuleFlag(::llvm::Module::Warning, "Dwarf Version", 4);
+}
+
+void CodeGen::SetDebugLine(uint32_t line) {
+  debug_line_ = line;
+  if (nullptr != debug_scope_) {
+    builder_->SetCurrentDebugLocation(::llvm::DILocation::get(*context_, line, 0, debug_scope_));
+  }
+}
+
+std::string CodeGen::GetSymbolName(const std::string& name) const {
+  if (symbol_suffix_.empty()) {
+    return name;
+  }
+  return fmt::format("{}.{}", name, symbol_suffix_);
+}
+
 absl::StatusOr<void*> CodeGen::GetFunctionPtr(const std::string& name) {
-  auto func_addr_result = jit_->lookup(name);
+  auto func_addr_result = jit_->lookup(*dylib_, funcs_.count(name) > 0 ? GetSymbolName(name) : name);
   if (!func_addr_result) {
     RUDF_LOG_RETURN_LLVM_ERROR(func_addr_result.takeError());
   }
@@ -262,11 +413,12 @@ void CodeGen::PrintAsm() {
 absl::Status CodeGen::DeclareExternFunctions(
     std::unordered_map<std::string, const FunctionDesc*>& func_calls,
     std::unordered_map<DType, std::unordered_map<std::string, FunctionDesc>>& member_func_calls) {
-  auto& dylib = jit_->getMainJITDylib();
+  auto& dylib = *dylib_;
   ::llvm::orc::SymbolMap extern_func_map;
   ::llvm::orc::MangleAndInterner mangle(jit_->getExecutionSession(), jit_->getDataLayout());
   for (auto [_, desc] : func_calls) {
-    auto exec_addr = ::llvm::orc::ExecutorAddr::fromPtr(desc->func);
+    void* func = opts_.direct_simd_dispatch ? desc->GetJitFunc() : desc->func;
+    auto exec_addr = ::llvm::orc::ExecutorAddr::fromPtr(func);
     extern_func_map.insert({mangle(desc->name), {exec_addr, ::llvm::JITSymbolFlags::Callable}});
     RUDF_DEBUG("Inject extern func {}", desc->name);
     auto func_type_result = GetFunctionType(*desc);
@@ -329,8 +481,17 @@ absl::Status CodeGen::DefineFunction(const FunctionDesc& desc, const std::vector
   FunctionValuePtr func_value = std::make_shared<FunctionValue>();
   func_value->desc = desc;
   ::llvm::FunctionType* func_type = func_type_result.value();
-  ::llvm::Function* f = ::llvm::Function::Create(func_type, ::llvm::Function::ExternalLinkage, desc.name, *module_);
+  ::llvm::Function* f =
+      ::llvm::Function::Create(func_type, ::llvm::Function::ExternalLinkage, GetSymbolName(desc.name), *module_);
   func_value->func = f;
+  if (di_builder_) {
+    auto* sp_type = di_builder_->createSubroutineType(di_builder_->getOrCreateTypeArray({}));
+    auto* sp = di_builder_->createFunction(di_file_, desc.name, f->getName(), di_file_, debug_line_, sp_type,
+                                           debug_line_, ::llvm::DINode::FlagPrototyped,
+                                           ::llvm::DISubprogram::SPFlagDefinition);
+    f->setSubprogram(sp);
+    debug_scope_ = sp;
+  }
   ::llvm::BasicBlock* entry_block = ::llvm::BasicBlock::Create(*context_, "entry", f);
   func_value->exit_block = ::llvm::BasicBlock::Create(*context_, "exit");
   builder_->SetInsertPoint(entry_block);
@@ -377,6 +538,15 @@ absl::Status CodeGen::DefineFunction(const FunctionDesc& desc, const std::vector
 
   funcs_[desc.name] = func_value;
   current_func_ = func_value;
+  // calls in functions with debug info must have a location
+  SetDebugLine(debug_line_);
+  if (opts_.no_throw) {
+    auto result = CallFunction(functions::kBuiltinErrorCode, {});
+    if (!result.ok()) {
+      return result.status();
+    }
+    func_value->error_code = result.value();
+  }
   return absl::OkStatus();
 }
 
@@ -410,9 +580,17 @@ absl::Status CodeGen::FinishFunction() {
     return absl::InvalidArgumentError(err_str);
   }
 
+  if (nullptr != debug_scope_) {
+    di_builder_->finalizeSubprogram(debug_scope_);
+    builder_->SetCurrentDebugLocation(::llvm::DebugLoc());
+    debug_scope_ = nullptr;
+  }
   // Run the optimizer on the function.
   if (opts_.optimize_level > 0) {
+    auto start_time = std::chrono::high_resolution_clock::now();
     func_pass_manager_->run(*current_func_->func, *func_analysis_manager_);
+    optimize_cost_ +=
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start_time);
   }
   return absl::OkStatus();
 }
@@ -539,13 +717,13 @@ void CodeGen::EndElifCond(Condition condition, size_t i, ValuePtr cond) {
   builder_->SetInsertPoint(condition.elif_bodies[i]);
 }
 void CodeGen::EndElif(Condition condition, size_t i) {
-  if (condition.elif_bodies[i]->getTerminator() == nullptr) {
+  if (builder_->GetInsertBlock()->getTerminator() == nullptr) {
     builder_->CreateBr(condition.end);  // end elif
   }
 }
 void CodeGen::BeginElse(Condition condition) { builder_->SetInsertPoint(condition.else_body); }
 void CodeGen::EndElse(Condition condition) {
-  if (condition.else_body->getTerminator() == nullptr) {
+  if (builder_->GetInsertBlock()->getTerminator() == nullptr) {
     builder_->CreateBr(condition.end);  // end else
   }
 }
@@ -657,9 +835,22 @@ absl::StatusOr<ValuePtr> CodeGen::CallFunction(const std::string& name, const st
     builder_->CreateStore(result, vector_ptr);
     result = vector_ptr;
   }
+  if (current_func_->error_code) {
+    CheckErrorCode();
+  }
   return NewValue(return_type, result, return_val_type);
 }
 
+void CodeGen::CheckErrorCode() {
+  auto* code = current_func_->error_code->LoadValue();
+  auto* failed = builder_->CreateICmpNE(code, builder_->getInt32(0));
+  std::string no_error_label = fmt::format("no_error_{}", GetLabelCursor());
+  auto* no_error_block = ::llvm::BasicBlock::Create(*context_, no_error_label, current_func_->func);
+  auto* weights = ::llvm::MDBuilder(*context_).createBranchWeights(1, 1 << 20);
+  builder_->CreateCondBr(failed, current_func_->exit_block, no_error_block, weights);
+  builder_->SetInsertPoint(no_error_block);
+}
+
 void CodeGen::Store(::llvm::Value* val, ::llvm::Value* ptr) { builder_->CreateStore(val, ptr); }
 
 ::llvm::Value* CodeGen::Load(::llvm::Type* typ, ::llvm::Value* ptr) { return builder_->CreateLoad(typ, ptr); }
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -24,6 +26,7 @@
 #include "llvm/Analysis/LoopAnalysisManager.h"
 #include "llvm/ExecutionEngine/Orc/LLJIT.h"
 #include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/DIBuilder.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/IRBuilder.h"
@@ -60,6 +63,8 @@ struct FunctionValue {
   ValuePtr return_value = nullptr;
   ::llvm::BasicBlock* exit_block = nullptr;
   ValuePtr context_arg_value;
+  // i32 code of the thread error slot, only loaded in no-throw mode
+  ValuePtr error_code;
   std::unordered_map<std::string, ValuePtr> named_values;
   std::vector<LoopBlocks> loop_blocks;
 };
@@ -86,7 +91,13 @@ class CodeGen {
     friend class CodeGen;
   };
 
-  explicit CodeGen(const Options& opts);
+  /**
+  ** LLJIT(with its target machine & linking layer) shared by the compiles of one compiler, `jit` is created if null.
+  ** Every `CodeGen` adds its code into a separate JITDylib, which is removed with the `CodeGen`.
+  */
+  static std::shared_ptr<::llvm::orc::LLJIT> NewJit(const Options& opts);
+  explicit CodeGen(const Options& opts, std::shared_ptr<::llvm::orc::LLJIT> jit = nullptr);
+  ~CodeGen();
 
   absl::Status DeclareExternFunctions(
       std::unordered_map<std::string, const FunctionDesc*>& func_calls,
@@ -129,6 +140,12 @@ class CodeGen {
 
   absl::StatusOr<ValuePtr> CastTo(ValuePtr val, DType dst_dtype);
   absl::StatusOr<::llvm::Value*> CastTo(::llvm::Value* val, DType src_dtype, DType dst_dtype);
+  /**
+  ** f16/bf16 (scalar or vector) to f32 and back, f16 conversions are lowered to hardware instructions(F16C) if
+  ** available.
+  */
+  ::llvm::Value* ExtendHalfFloat(DType src_dtype, ::llvm::Value* val);
+  ::llvm::Value* TruncToHalfFloat(DType dst_dtype, ::llvm::Value* val);
   absl::StatusOr<::llvm::Value*> UnaryOp(OpToken op, DType dtype, ::llvm::Value* val);
   absl::StatusOr<::llvm::Value*> BinaryOp(OpToken op, DType dtype, ::llvm::Value* left, ::llvm::Value* right);
   absl::StatusOr<::llvm::Value*> TernaryOp(OpToken op, DType dtype, ::llvm::Value* a, ::llvm::Value* b,
@@ -169,8 +186,20 @@ class CodeGen {
 
   absl::StatusOr<void*> GetFunctionPtr(const std::string& name);
 
+  /**
+  ** Source of udfs to compile, used to name symbols & emit debug info with `Options::jit_profiling`,
+  ** must be set before defining functions.
+  */
+  void SetSource(std::string_view source);
+  /**
+  ** Source line of the following generated code, only works with `Options::jit_debug_info`.
+  */
+  void SetDebugLine(uint32_t line);
+
   absl::Status Finish();
 
+  std::chrono::microseconds GetOptimizeCost() const { return optimize_cost_; }
+
   ::llvm::LLVMContext& GetContext() { return *context_; }
 
   bool IsExternFunctionExist(const std::string& name);
@@ -182,11 +211,14 @@ class CodeGen {
   ::llvm::Type* GetElementType(::llvm::Type* t);
 
   absl::StatusOr<::llvm::Value*> CallFunction(const std::string& name, const std::vector<::llvm::Value*>& arg_values);
+  void CheckErrorCode();
 
   absl::StatusOr<DType> NormalizeDType(const std::vector<DType>& dtypes);
 
   ExternFunctionPtr GetFunction(const std::string& name);
 
+  std::string GetSymbolName(const std::string& name) const;
+
   Options opts_;
 
   std::vector<std::unique_ptr<std::string>> const_strings_;
@@ -194,7 +226,8 @@ class CodeGen {
   std::unordered_map<std::string, FunctionValuePtr> funcs_;
   FunctionValuePtr current_func_;
 
-  std::unique_ptr<::llvm::orc::LLJIT> jit_;
+  std::shared_ptr<::llvm::orc::LLJIT> jit_;
+  ::llvm::orc::JITDylib* dylib_ = nullptr;
   std::unique_ptr<::llvm::LLVMContext> context_;
   std::unique_ptr<::llvm::Module> module_;
   std::unique_ptr<::llvm::IRBuilder<>> builder_;
@@ -208,6 +241,15 @@ class CodeGen {
   std::unique_ptr<::llvm::StandardInstrumentations> std_insts_;
 
   uint32_t label_cursor_;
+  std::chrono::microseconds optimize_cost_ = std::chrono::microseconds::zero();
+
+  // symbols are named `<udf name>.<symbol_suffix_>` with `Options::jit_profiling`
+  std::string symbol_suffix_;
+  std::unique_ptr<::llvm::DIBuilder> di_builder_;
+  ::llvm::DIFile* di_file_ = nullptr;
+  // subprogram of the function in definition
+  ::llvm::DISubprogram* debug_scope_ = nullptr;
+  uint32_t debug_line_ = 1;
 };
 }  // namespace compiler
 }  // namespace rapidudf
\ No newline at end of file
@@ -31,7 +31,64 @@
 
 namespace rapidudf {
 namespace compiler {
+static ::llvm::Type* get_same_shape_type(::llvm::Value* val, ::llvm::Type* ele_type) {
+  if (val->getType()->isVectorTy()) {
+    ::llvm::VectorType* vtype = reinterpret_cast<::llvm::VectorType*>(val->getType());
+    return ::llvm::VectorType::get(ele_type, vtype->getElementCount());
+  }
+  return ele_type;
+}
+
+::llvm::Value* CodeGen::ExtendHalfFloat(DType src_dtype, ::llvm::Value* val) {
+  auto* f32_type = get_same_shape_type(val, builder_->getFloatTy());
+  if (src_dtype.IsF16()) {
+    return builder_->CreateFPExt(val, f32_type);
+  }
+  // bf16 is the upper half of f32
+  auto* i32_type = get_same_shape_type(val, builder_->getInt32Ty());
+  auto* bits = builder_->CreateShl(builder_->CreateZExt(val, i32_type), ::llvm::ConstantInt::get(i32_type, 16));
+  return builder_->CreateBitCast(bits, f32_type);
+}
+
+::llvm::Value* CodeGen::TruncToHalfFloat(DType dst_dtype, ::llvm::Value* val) {
+  if (dst_dtype.IsF16()) {
+    return builder_->CreateFPTrunc(val, get_same_shape_type(val, builder_->getHalfTy()));
+  }
+  // round to nearest even, keep nan as quiet nan
+  auto* i32_type = get_same_shape_type(val, builder_->getInt32Ty());
+  auto* i16_type = get_same_shape_type(val, builder_->getInt16Ty());
+  auto* bits = builder_->CreateBitCast(val, i32_type);
+  auto* shift = ::llvm::ConstantInt::get(i32_type, 16);
+  auto* lsb = builder_->CreateAnd(builder_->CreateLShr(bits, shift), ::llvm::ConstantInt::get(i32_type, 1));
+  auto* rounded = builder_->CreateAdd(builder_->CreateAdd(bits, ::llvm::ConstantInt::get(i32_type, 0x7fff)), lsb);
+  auto* nan_bits = builder_->CreateOr(builder_->CreateLShr(bits, shift), ::llvm::ConstantInt::get(i32_type, 0x40));
+  auto* is_nan = builder_->CreateFCmpUNO(val, val);
+  auto* result = builder_->CreateSelect(is_nan, nan_bits, builder_->CreateLShr(rounded, shift));
+  return builder_->CreateTrunc(result, i16_type);
+}
+
 absl::StatusOr<::llvm::Value*> CodeGen::CastTo(::llvm::Value* val, DType src_dtype, DType dst_dtype) {
+  if (src_dtype.IsHalfFloat() || dst_dtype.IsHalfFloat()) {
+    DType f32_dtype(DATA_F32);
+    if (src_dtype.IsHalfFloat()) {
+      val = ExtendHalfFloat(src_dtype, val);
+      src_dtype = f32_dtype;
+    }
+    if (!dst_dtype.IsHalfFloat()) {
+      return CastTo(val, src_dtype, dst_dtype);
+    }
+    if (src_dtype != f32_dtype) {
+      auto result = CastTo(val, src_dtype, f32_dtype);
+      if (!result.ok()) {
+        return result.status();
+      }
+      val = result.value();
+    }
+    return TruncToHalfFloat(dst_dtype, val);
+  }
+  if (src_dtype == dst_dtype) {
+    return val;
+  }
   ::llvm::Value* new_val = nullptr;
   ::llvm::Type* dst_type = get_type(builder_->getContext(), dst_dtype);
   if (val->getType()->isVectorTy()) {
@@ -46,7 +103,7 @@ absl::StatusOr<::llvm::Value*> CodeGen::CastTo(::llvm::Value* val, DType src_dty
         new_val = builder_->CreateUIToFP(val, dst_type);
       }
     } else {
-      if (src_dtype.Bits() > dst_dtype.Bits()) {
+      if (dst_dtype.Bits() > src_dtype.Bits()) {
         new_val = builder_->CreateFPExt(val, dst_type);
       } else {
         new_val = builder_->CreateFPTrunc(val, dst_type);
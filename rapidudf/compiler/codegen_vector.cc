@@ -95,6 +95,14 @@ absl::StatusOr<std::pair<::llvm::Value*, ::llvm::Value*>> CodeGen::LoadNVector(D
       fill_v = ::llvm::ConstantFP::get(builder_->getContext(), fv);
       break;
     }
+    case DATA_F16: {
+      fill_v = ::llvm::ConstantFP::get(builder_->getHalfTy(), 1.0);
+      break;
+    }
+    case DATA_BF16: {
+      fill_v = builder_->getInt16(0x3f80);
+      break;
+    }
     case DATA_I64:
     case DATA_U64: {
       fill_v = builder_->getInt64(1);
@@ -20,12 +20,34 @@
 #include "rapidudf/functions/functions.h"
 #include "rapidudf/functions/names.h"
 #include "rapidudf/log/log.h"
+#include "rapidudf/metrics/metrics.h"
 
 namespace rapidudf {
 namespace compiler {
+// `stat` is null if compile failed before all phases done.
+static void record_compile_metrics(const JitFunctionStat* stat, bool ok) {
+  auto* m = metrics::builtin_metrics();
+  if (nullptr == m) {
+    return;
+  }
+  m->compile_total->Add(1);
+  if (!ok) {
+    m->compile_failed->Add(1);
+  }
+  if (nullptr == stat) {
+    return;
+  }
+  m->compile_phase_us[metrics::kCompileParse]->Observe(stat->parse_cost.count());
+  m->compile_phase_us[metrics::kCompileParseValidate]->Observe(stat->parse_validate_cost.count());
+  m->compile_phase_us[metrics::kCompileIRBuild]->Observe(stat->ir_build_cost.count());
+  m->compile_phase_us[metrics::kCompileOptimize]->Observe(stat->optimize_cost.count());
+  m->compile_phase_us[metrics::kCompileCompile]->Observe(stat->compile_cost.count());
+}
+
 JitCompiler::JitCompiler(Options opts) : opts_(opts) {
   functions::init_builtin();
   ast::Symbols::Init();
+  jit_ = CodeGen::NewJit(opts_);
 }
 
 absl::StatusOr<std::vector<std::string>> JitCompiler::CompileSource(const std::string& source) {
@@ -33,6 +55,7 @@ absl::StatusOr<std::vector<std::string>> JitCompiler::CompileSource(const std::s
   NewCodegen();
   auto funcs = ast::parse_functions_ast(ast_ctx_, source);
   if (!funcs.ok()) {
+    record_compile_metrics(nullptr, false);
     RUDF_LOG_ERROR_STATUS(funcs.status());
   }
   stat_.parse_cost = ast_ctx_.GetParseCost();
@@ -52,17 +75,13 @@ absl::StatusOr<std::vector<std::string>> JitCompiler::CompileSource(const std::s
 absl::Status JitCompiler::CompileFunction(const std::string& source) {
   auto f = ast::parse_function_ast(ast_ctx_, source);
   if (!f.ok()) {
+    record_compile_metrics(nullptr, false);
     RUDF_LOG_ERROR_STATUS(f.status());
   }
 
   stat_.parse_cost = ast_ctx_.GetParseCost();
   stat_.parse_validate_cost = ast_ctx_.GetParseValidateCost();
-  auto start_time = std::chrono::high_resolution_clock::now();
-  auto status = CompileFunction(f.value());
-  auto compile_duration =
-      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start_time);
-  stat_.parse_cost = compile_duration;
-  return status;
+  return CompileFunction(f.value());
 }
 
 absl::Status JitCompiler::CompileFunctions(const std::vector<ast::Function>& functions) {
@@ -84,6 +103,7 @@ absl::Status JitCompiler::CompileFunctions(const std::vector<ast::Function>& fun
   }
   auto status = codegen_->DeclareExternFunctions(all_func_calls, all_member_func_calls);
   if (!status.ok()) {
+    record_compile_metrics(nullptr, false);
     return status;
   }
   //   auto throw_func = FunctionFactory::GetFunction(std::string(k_throw_size_exception_func));
@@ -91,22 +111,30 @@ absl::Status JitCompiler::CompileFunctions(const std::vector<ast::Function>& fun
   //     all_func_calls[std::string(k_throw_size_exception_func)] = throw_func;
   //   }
 
+  codegen_->SetSource(ast_ctx_.GetSource());
   for (auto& func : functions) {
     auto status = BuildIR(func);
-    RUDF_LOG_RETURN_ERROR_STATUS(status);
+    if (!status.ok()) {
+      record_compile_metrics(nullptr, false);
+      RUDF_LOG_ERROR_STATUS(status);
+    }
   }
+  stat_.optimize_cost = codegen_->GetOptimizeCost();
   stat_.ir_build_cost =
-      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start_time);
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start_time) -
+      stat_.optimize_cost;
   start_time = std::chrono::high_resolution_clock::now();
   status = Compile();
   stat_.compile_cost =
       std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start_time);
+  record_compile_metrics(&stat_, status.ok());
   return status;
 }
 
 absl::Status JitCompiler::CompileExpression(const std::string& expr, ast::Function& function) {
   auto f = ast::parse_expression_ast(ast_ctx_, expr, function.ToFuncDesc());
   if (!f.ok()) {
+    record_compile_metrics(nullptr, false);
     RUDF_LOG_ERROR_STATUS(f.status());
   }
   stat_.parse_cost = ast_ctx_.GetParseCost();
@@ -125,7 +153,14 @@ absl::Status JitCompiler::CompileFunction(const ast::Function& function) {
 
 void JitCompiler::NewCodegen() {
   ast_ctx_.Clear();
-  codegen_ = std::make_shared<CodeGen>(opts_);
+  codegen_ = std::make_shared<CodeGen>(opts_, jit_);
+  stat_.Clear();
+  parsed_ast_funcs_.clear();
+}
+void JitCompiler::Reset() {
+  std::lock_guard<std::mutex> guard(jit_mutex_);
+  ast_ctx_.Clear();
+  codegen_.reset();
   stat_.Clear();
   parsed_ast_funcs_.clear();
 }
@@ -135,7 +170,15 @@ absl::StatusOr<void*> JitCompiler::GetFunctionPtr(const std::string& name) {
   if (!codegen_) {
     return absl::InvalidArgumentError("null compiled session to get function ptr");
   }
-  return codegen_->GetFunctionPtr(name);
+  auto start_time = std::chrono::high_resolution_clock::now();
+  auto result = codegen_->GetFunctionPtr(name);
+  auto cost =
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start_time);
+  stat_.codegen_cost += cost;
+  if (auto* m = metrics::builtin_metrics()) {
+    m->compile_phase_us[metrics::kCompileCodegen]->Observe(cost.count());
+  }
+  return result;
 }
 
 absl::StatusOr<std::string> JitCompiler::VerifyFunctionSignature(const std::string& name, DType return_type,
@@ -177,6 +220,9 @@ absl::Status JitCompiler::BuildIR(const ast::Function& function) {
     }
   }
   FunctionDesc desc = function.ToFuncDesc();
+  if (opts_.jit_debug_info) {
+    codegen_->SetDebugLine(ast_ctx_.GetLineNo(function.position));
+  }
   auto status = codegen_->DefineFunction(desc, func_arg_names);
   if (!status.ok()) {
     return status;
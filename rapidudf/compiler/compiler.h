@@ -35,6 +35,12 @@
 #include "rapidudf/meta/optype.h"
 #include "rapidudf/types/dyn_object_schema.h"
 
+namespace llvm {
+namespace orc {
+class LLJIT;
+}  // namespace orc
+}  // namespace llvm
+
 namespace rapidudf {
 
 namespace compiler {
@@ -71,7 +77,7 @@ class JitCompiler {
       return func_ptr_result.status();
     }
     auto func_ptr = func_ptr_result.value();
-    return JitFunction<RET, Args...>(name, func_ptr, codegen_, stat_);
+    return JitFunction<RET, Args...>(name, func_ptr, codegen_, stat_, false, opts_.no_throw);
   }
 
   template <typename RET, typename... Args>
@@ -98,7 +104,7 @@ class JitCompiler {
     }
     auto func_ptr = func_ptr_result.value();
 
-    return JitFunction<RET, Args...>(fname, func_ptr, codegen_, stat_);
+    return JitFunction<RET, Args...>(fname, func_ptr, codegen_, stat_, false, opts_.no_throw);
   }
 
   template <typename RET, typename... Args>
@@ -152,7 +158,7 @@ class JitCompiler {
     }
     auto func_ptr = func_ptr_result.value();
 
-    return JitFunction<RET, Args...>(gen_func_ast.name, func_ptr, codegen_, stat_);
+    return JitFunction<RET, Args...>(gen_func_ast.name, func_ptr, codegen_, stat_, false, opts_.no_throw);
   }
   template <typename RET, typename... Args>
   absl::StatusOr<JitFunction<RET, Args...>> CompileExpression(const std::string& source,
@@ -168,6 +174,10 @@ class JitCompiler {
   std::shared_ptr<CodeGen> GetCodeGen() { return codegen_; }
   const JitFunctionStat& GetStat() const { return stat_; }
   const std::vector<ast::Function>& GetParsedAST() const { return parsed_ast_funcs_; }
+  /**
+  ** Drop the last compiled session, functions loaded from it are still valid, the jit is kept for later compiles.
+  */
+  void Reset();
 
  private:
   struct RPNEvalNode {
@@ -232,6 +242,8 @@ class JitCompiler {
   std::vector<ast::Function> parsed_ast_funcs_;
 
   std::shared_ptr<CodeGen> codegen_;
+  // target machine & linking layer kept warm across compiles & `Reset`, used by one compile at a time
+  std::shared_ptr<::llvm::orc::LLJIT> jit_;
   std::mutex jit_mutex_;
   JitFunctionStat stat_;
 };
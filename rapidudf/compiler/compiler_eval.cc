@@ -218,6 +218,9 @@ absl::Status JitCompiler::BuildVectorEvalIR(DType dtype, std::vector<RPNEvalNode
       }
       std::reverse(arg_vals.begin(), arg_vals.end());
       arg_vals.emplace_back(node.op_temp_val);
+      if (node.func_invocation.func->has_lanes_arg) {
+        arg_vals.emplace_back(remaining ? remaining->LoadValue() : codegen_->NewU32(kVectorUnitSize)->LoadValue());
+      }
       std::vector<ValuePtr> args;
       for (size_t i = 0; i < arg_vals.size(); i++) {
         args.emplace_back(codegen_->NewValue(node.func_invocation.func->arg_types[i], arg_vals[i]));
@@ -226,9 +229,9 @@ absl::Status JitCompiler::BuildVectorEvalIR(DType dtype, std::vector<RPNEvalNode
       if (!result.ok()) {
         return result.status();
       }
-      auto* vtype = get_vector_type(codegen_->GetContext(), node.func_invocation.func->LastArg().PtrTo());
+      auto* vtype = get_vector_type(codegen_->GetContext(), node.func_invocation.func->VectorOutputArg().PtrTo());
       if (vtype == nullptr) {
-        RUDF_LOG_RETURN_FMT_ERROR("Get NULL vector type for {}", node.func_invocation.func->LastArg());
+        RUDF_LOG_RETURN_FMT_ERROR("Get NULL vector type for {}", node.func_invocation.func->VectorOutputArg());
       }
       auto* tmp_val = codegen_->Load(vtype, node.op_temp_val);
       operands.emplace_back(std::make_pair(node.op_temp_val, tmp_val));
@@ -250,6 +253,12 @@ absl::Status JitCompiler::BuildVectorEvalIR(DType dtype, std::vector<RPNEvalNode
         }
         load_value_ptr = load_result.value().first;
         load_value = load_result.value().second;
+        DType ele_dtype = value->GetDType().Elem();
+        if (ele_dtype.IsHalfFloat()) {
+          load_value = codegen_->ExtendHalfFloat(ele_dtype, load_value);
+          codegen_->Store(load_value, node.op_temp_val);
+          load_value_ptr = node.op_temp_val;
+        }
       } else {
         load_value_ptr = node.constant_vector_val_ptr;
         load_value = node.constant_vector_val;
@@ -258,6 +267,12 @@ absl::Status JitCompiler::BuildVectorEvalIR(DType dtype, std::vector<RPNEvalNode
     }
   }
   ::llvm::Value* eval_result = operands[0].second;
+  if (dtype.Elem().IsHalfFloat()) {
+    if (eval_result->getType()->isPointerTy()) {
+      eval_result = codegen_->Load(get_vector_type(codegen_->GetContext(), DType(DATA_F32)), eval_result);
+    }
+    eval_result = codegen_->TruncToHalfFloat(dtype.Elem(), eval_result);
+  }
 
   if (remaining) {
     return codegen_->StoreNVector(dtype.Elem(), eval_result, output, cursor->LoadValue(), remaining->LoadValue());
@@ -331,6 +346,10 @@ absl::StatusOr<ValuePtr> JitCompiler::BuildVectorIR(DType result_dtype, std::vec
       if (compute_dtype.IsInvalid()) {
         compute_dtype = operands[operands.size() - count].first;
       }
+      // f16/bf16 are storage only types, widened to f32 to compute
+      if (compute_dtype.Elem().IsHalfFloat()) {
+        compute_dtype = DType(DATA_F32);
+      }
 
       for (int i = 0; i < count; i++) {
         auto [dtype, prev_idxs] = operands[operands.size() - count + i];
@@ -341,7 +360,10 @@ absl::StatusOr<ValuePtr> JitCompiler::BuildVectorIR(DType result_dtype, std::vec
         }
         for (auto idx : prev_idxs) {
           auto val = nodes[idx].val;
-
+          if (val->GetDType().IsSimdVector() && val->GetDType().Elem().IsHalfFloat() && compute_dtype.IsF32()) {
+            // widened while loading
+            continue;
+          }
           auto result = codegen_->CastTo(val, compute_dtype);
           if (!result.ok()) {
             return result.status();
@@ -383,13 +405,16 @@ absl::StatusOr<ValuePtr> JitCompiler::BuildVectorIR(DType result_dtype, std::vec
           node.op_temp_val = codegen_->NewVectorVar(dtype);
         }
       } else if (node.func_invocation.Valid()) {
-        DType result_dtype = node.func_invocation.func->LastArg().PtrTo();
+        DType result_dtype = node.func_invocation.func->VectorOutputArg().PtrTo();
         node.op_temp_val = codegen_->NewVectorVar(result_dtype);
         std::vector<size_t> idxs;
         operands.emplace_back(std::make_pair(result_dtype, idxs));
       } else {
         auto value = node.val;
         operands.emplace_back(std::make_pair(value->GetDType(), std::vector<size_t>{i}));
+        if (value->GetDType().IsSimdVector() && value->GetDType().Elem().IsHalfFloat()) {
+          node.op_temp_val = codegen_->NewVectorVar(DType(DATA_F32));
+        }
         if (value->GetDType().IsSimdVector()) {
           auto result = value->GetVectorSizeValue();
           if (!result.ok()) {
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "rapidudf/compiler/compiler_pool.h"
+#include <algorithm>
+#include <thread>
+
+namespace rapidudf {
+namespace compiler {
+JitCompilerPool::JitCompilerPool(Options opts, size_t warmup, size_t max_idle) : opts_(opts), max_idle_(max_idle) {
+  if (0 == max_idle_) {
+    max_idle_ = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  for (size_t i = 0; i < warmup && i < max_idle_; i++) {
+    idle_.emplace_back(std::make_unique<JitCompiler>(opts_));
+  }
+}
+
+JitCompilerPool::CompilerPtr JitCompilerPool::Acquire() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (!idle_.empty()) {
+      JitCompiler* compiler = idle_.back().release();
+      idle_.pop_back();
+      return CompilerPtr(compiler, Releaser{this});
+    }
+  }
+  return CompilerPtr(new JitCompiler(opts_), Releaser{this});
+}
+
+void JitCompilerPool::Release(JitCompiler* compiler) {
+  std::unique_ptr<JitCompiler> owned(compiler);
+  // do not hold the jit code of last compile in the pool, the jit itself is kept
+  owned->Reset();
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (idle_.size() < max_idle_) {
+    idle_.emplace_back(std::move(owned));
+  }
+}
+
+size_t JitCompilerPool::IdleSize() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return idle_.size();
+}
+
+JitCompilerPool& get_global_compiler_pool() {
+  // never freed, compilers may still be acquired by static destructors
+  static auto* pool = new JitCompilerPool(Options{}, 1);
+  return *pool;
+}
+}  // namespace compiler
+}  // namespace rapidudf
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "absl/status/statusor.h"
+
+#include "rapidudf/compiler/compiler.h"
+#include "rapidudf/compiler/function.h"
+#include "rapidudf/compiler/options.h"
+
+namespace rapidudf {
+namespace compiler {
+
+/**
+** Pool of reusable compilers with same options, every compile takes an idle compiler exclusively, so concurrent
+** compiles of different sources run in parallel instead of serializing on one compiler.
+** Idle compilers keep their LLJIT & target machine, so a pooled compile skips creating them.
+** The pool must outlive all acquired compilers.
+*/
+class JitCompilerPool {
+ public:
+  struct Releaser {
+    JitCompilerPool* pool = nullptr;
+    void operator()(JitCompiler* compiler) const { pool->Release(compiler); }
+  };
+  using CompilerPtr = std::unique_ptr<JitCompiler, Releaser>;
+
+  /**
+  ** `warmup` compilers are created at once, at most `max_idle` idle compilers are kept, 0 means the number of cores.
+  */
+  explicit JitCompilerPool(Options opts = Options{}, size_t warmup = 0, size_t max_idle = 0);
+
+  CompilerPtr Acquire();
+  size_t IdleSize() const;
+  const Options& GetOptions() const { return opts_; }
+
+  template <typename RET, typename... Args>
+  absl::StatusOr<JitFunction<RET, Args...>> CompileFunction(const std::string& source) {
+    auto compiler = Acquire();
+    return compiler->CompileFunction<RET, Args...>(source);
+  }
+  template <typename RET, typename... Args>
+  absl::StatusOr<JitFunction<RET, Args...>> CompileDynObjExpression(const std::string& source,
+                                                                    const std::vector<JitCompiler::Arg>& args) {
+    auto compiler = Acquire();
+    return compiler->CompileDynObjExpression<RET, Args...>(source, args);
+  }
+  template <typename RET, typename... Args>
+  absl::StatusOr<JitFunction<RET, Args...>> CompileExpression(const std::string& source,
+                                                              const std::vector<std::string>& arg_names) {
+    auto compiler = Acquire();
+    return compiler->CompileExpression<RET, Args...>(source, arg_names);
+  }
+
+ private:
+  void Release(JitCompiler* compiler);
+
+  Options opts_;
+  size_t max_idle_ = 0;
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<JitCompiler>> idle_;
+};
+
+/**
+** Process wide pool with default options, builtin functions & symbols are initialized once at the first call.
+*/
+JitCompilerPool& get_global_compiler_pool();
+
+}  // namespace compiler
+}  // namespace rapidudf
@@ -14,14 +14,43 @@
  * limitations under the License.
  */
 
+#include <type_traits>
+#include <variant>
+
 #include "rapidudf/compiler/codegen.h"
 #include "rapidudf/compiler/compiler.h"
 #include "rapidudf/log/log.h"
 
 namespace rapidudf {
 namespace compiler {
+// offset of the statement in source, 0 if unknown
+static uint32_t get_statement_position(const ast::Statement& statement) {
+  return std::visit(
+      [](auto&& arg) -> uint32_t {
+        using T = std::decay_t<decltype(arg)>;
+        if constexpr (std::is_same_v<T, ast::ReturnStatement>) {
+          return arg.expr.has_value() && *arg.expr ? (*arg.expr)->position : 0;
+        } else if constexpr (std::is_same_v<T, ast::ExpressionStatement>) {
+          return arg.expr ? arg.expr->position : 0;
+        } else if constexpr (std::is_same_v<T, ast::IfElseStatement>) {
+          return arg.if_statement.expr ? arg.if_statement.expr->position : 0;
+        } else if constexpr (std::is_same_v<T, ast::WhileStatement>) {
+          return arg.body.expr ? arg.body.expr->position : 0;
+        } else {
+          return arg.position;
+        }
+      },
+      statement);
+}
+
 absl::Status JitCompiler::BuildIR(const std::vector<ast::Statement>& statements) {
   for (auto& statement : statements) {
+    if (opts_.jit_debug_info) {
+      uint32_t position = get_statement_position(statement);
+      if (position > 0) {
+        codegen_->SetDebugLine(ast_ctx_.GetLineNo(position));
+      }
+    }
     auto rc = std::visit([&](auto&& arg) { return BuildIR(arg); }, statement);
     if (!rc.ok()) {
       return rc;
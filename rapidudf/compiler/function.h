@@ -16,32 +16,44 @@
 
 #pragma once
 #include <chrono>
+#include <exception>
 #include <memory>
 #include <string>
+#include <type_traits>
+
+#include "absl/status/statusor.h"
+#include "rapidudf/meta/exception.h"
 
 namespace rapidudf {
 namespace compiler {
 struct JitFunctionStat {
   std::chrono::microseconds parse_cost;
   std::chrono::microseconds parse_validate_cost;
+  // ir build cost excludes the optimize passes
   std::chrono::microseconds ir_build_cost;
+  std::chrono::microseconds optimize_cost;
   std::chrono::microseconds compile_cost;
+  // machine code is emitted lazily at the first function lookup
+  std::chrono::microseconds codegen_cost;
   void Clear() {
     parse_cost = std::chrono::microseconds::zero();
     parse_validate_cost = std::chrono::microseconds::zero();
     ir_build_cost = std::chrono::microseconds::zero();
+    optimize_cost = std::chrono::microseconds::zero();
     compile_cost = std::chrono::microseconds::zero();
+    codegen_cost = std::chrono::microseconds::zero();
   }
 };
 
 template <typename RET, typename... Args>
 class JitFunction {
  public:
+  using StatusOrResult = std::conditional_t<std::is_void_v<RET>, absl::Status, absl::StatusOr<RET>>;
   JitFunction() = default;
   template <typename T>
   explicit JitFunction(const std::string& name, const void* f, std::shared_ptr<T> resource, const JitFunctionStat& stat,
-                       bool from_cache = false)
-      : name_(name), resource_(resource), stat_(stat), is_from_cache_(from_cache) {
+                       bool from_cache = false, bool no_throw = false)
+      : name_(name), resource_(resource), stat_(stat), is_from_cache_(from_cache), no_throw_(no_throw) {
     f_ = reinterpret_cast<RET (*)(Args...)>(const_cast<void*>(f));
   }
   JitFunction(JitFunction&& other) { MoveFrom(std::move(other)); }
@@ -65,18 +77,59 @@ class JitFunction {
     }
   }
 
+  /**
+  ** Call and return errors as absl::Status instead of exceptions.
+  ** Functions compiled with `Options::no_throw` run in no-throw mode, builtins report errors by the thread's error
+  ** slot and the jit code returns at the first error. Other functions keep throwing, since their jit code does not
+  ** check the error slot, the exception is caught and converted. Exceptions of user functions are converted too.
+  */
+  StatusOrResult Call(Args... args) {
+    if (!no_throw_) {
+      try {
+        if constexpr (std::is_same_v<void, RET>) {
+          f_(args...);
+          return absl::OkStatus();
+        } else {
+          return f_(args...);
+        }
+      } catch (const std::exception& ex) {
+        return ExceptionToStatus(ex);
+      }
+    }
+    NoThrowScope scope;
+    auto& slot = GetErrorSlot();
+    try {
+      if constexpr (std::is_same_v<void, RET>) {
+        f_(args...);
+        return slot.TakeStatus();
+      } else {
+        RET r = f_(args...);
+        if (slot.code != 0) {
+          return slot.TakeStatus();
+        }
+        return r;
+      }
+    } catch (const std::exception& ex) {
+      slot.Clear();
+      return ExceptionToStatus(ex);
+    }
+  }
+
  private:
   std::string name_;
   std::shared_ptr<void> resource_;
   RET (*f_)(Args...) = nullptr;
   JitFunctionStat stat_;
-  bool is_from_cache_;
+  bool is_from_cache_ = false;
+  bool no_throw_ = false;
 
   void MoveFrom(JitFunction&& other) {
     name_ = std::move(other.name_);
     resource_ = std::move(other.resource_);
     f_ = other.f_;
     stat_ = other.stat_;
+    is_from_cache_ = other.is_from_cache_;
+    no_throw_ = other.no_throw_;
   }
 };
 }  // namespace compiler
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "rapidudf/compiler/jit_listener.h"
+#include <unistd.h>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+#include "llvm/ExecutionEngine/JITEventListener.h"
+#include "llvm/Object/SymbolSize.h"
+
+#include "rapidudf/log/log.h"
+
+namespace rapidudf {
+namespace compiler {
+namespace {
+// writes `<start addr> <size> <name>` of every jit function, the format perf reads for jit code.
+class PerfMapListener : public ::llvm::JITEventListener {
+ public:
+  PerfMapListener() {
+    std::string path = fmt::format("/tmp/perf-{}.map", getpid());
+    file_ = fopen(path.c_str(), "a");
+    if (nullptr == file_) {
+      RUDF_ERROR("Failed to open perf map file:{}", path);
+    }
+  }
+  void notifyObjectLoaded(ObjectKey key, const ::llvm::object::ObjectFile& obj,
+                          const ::llvm::RuntimeDyld::LoadedObjectInfo& info) override {
+    if (nullptr == file_) {
+      return;
+    }
+    // symbol addresses of the debug object are relocated to the loaded addresses
+    ::llvm::object::OwningBinary<::llvm::object::ObjectFile> debug_obj_owner = info.getObjectForDebug(obj);
+    const ::llvm::object::ObjectFile* debug_obj = debug_obj_owner.getBinary();
+    if (nullptr == debug_obj) {
+      return;
+    }
+    std::lock_guard<std::mutex> guard(mutex_);
+    for (const auto& [sym, size] : ::llvm::object::computeSymbolSizes(*debug_obj)) {
+      auto type = sym.getType();
+      if (!type) {
+        ::llvm::consumeError(type.takeError());
+        continue;
+      }
+      if (*type != ::llvm::object::SymbolRef::ST_Function) {
+        continue;
+      }
+      auto name = sym.getName();
+      if (!name) {
+        ::llvm::consumeError(name.takeError());
+        continue;
+      }
+      auto addr = sym.getAddress();
+      if (!addr) {
+        ::llvm::consumeError(addr.takeError());
+        continue;
+      }
+      fprintf(file_, "%llx %llx %.*s\n", static_cast<unsigned long long>(*addr), static_cast<unsigned long long>(size),
+              static_cast<int>(name->size()), name->data());
+    }
+    fflush(file_);
+  }
+
+ private:
+  FILE* file_ = nullptr;
+  std::mutex mutex_;
+};
+}  // namespace
+
+void register_profiling_listeners(::llvm::orc::RTDyldObjectLinkingLayer& layer) {
+  // listeners are process wide singletons, never freed since jit sessions may outlive static destructors
+  static auto* perf_map_listener = new PerfMapListener;
+  layer.registerJITEventListener(*::llvm::JITEventListener::createGDBRegistrationListener());
+  if (auto* perf_listener = ::llvm::JITEventListener::createPerfJITEventListener()) {
+    layer.registerJITEventListener(*perf_listener);
+  }
+  if (auto* vtune_listener = ::llvm::JITEventListener::createIntelJITEventListener()) {
+    layer.registerJITEventListener(*vtune_listener);
+  }
+  layer.registerJITEventListener(*perf_map_listener);
+}
+}  // namespace compiler
+}  // namespace rapidudf
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h"
+
+namespace rapidudf {
+namespace compiler {
+/**
+** Register gdb jit interface, perf jitdump & vtune(if llvm built with their support) and perf map listeners,
+** `/tmp/perf-<pid>.map` is shared by all jit sessions of the process.
+*/
+void register_profiling_listeners(::llvm::orc::RTDyldObjectLinkingLayer& layer);
+}  // namespace compiler
+}  // namespace rapidudf
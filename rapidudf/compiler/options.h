@@ -22,6 +22,18 @@ struct Options {
   uint8_t optimize_level = 2;
   bool fast_math = false;
   bool print_asm = false;
+  // jit code checks the thread's error slot after every call and returns early on error,
+  // use with `JitFunction::Call` which reports errors as absl::Status instead of exceptions.
+  bool no_throw = false;
+  // register jit code to profilers & debuggers: `/tmp/perf-<pid>.map`, jitdump(written into `$JITDUMPDIR` or
+  // `~/.debug/jit`) & vtune if llvm built with their support, and the gdb jit interface, udf symbols are named
+  // `<udf name>.<source hash>`.
+  bool jit_profiling = false;
+  // emit dwarf line tables mapping jit code back to udf source lines, only works with `jit_profiling`.
+  bool jit_debug_info = false;
+  // bind jit calls of simd kernels to the implementation of the best highway target resolved at compile time,
+  // instead of dispatching through highway's target table for every vector block.
+  bool direct_simd_dispatch = true;
 };
 }  // namespace compiler
 }  // namespace rapidudf
\ No newline at end of file
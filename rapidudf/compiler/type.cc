@@ -85,6 +85,10 @@ void init_buitin_types(::llvm::LLVMContext& ctx) {
     case DATA_F16: {
       return ::llvm::Type::getHalfTy(ctx);
     }
+    case DATA_BF16: {
+      // bf16 is storage only, kept as raw bits and widened to f32 by bit ops
+      return ::llvm::Type::getInt16Ty(ctx);
+    }
     case DATA_F32: {
       return ::llvm::Type::getFloatTy(ctx);
     }
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "rapidudf/compiler/udf_library.h"
+#include <set>
+
+#include "rapidudf/ast/context.h"
+#include "rapidudf/ast/grammar.h"
+#include "rapidudf/ast/symbols.h"
+#include "rapidudf/log/log.h"
+
+namespace rapidudf {
+namespace compiler {
+UdfLibrary::UdfLibrary(Options opts) : pool_(opts, 1), state_(std::make_shared<LibraryState>()) {}
+
+absl::StatusOr<std::vector<std::string>> UdfLibrary::Load(const std::string& source) {
+  std::lock_guard<std::mutex> reload_guard(reload_mutex_);
+  // pick up dtypes & schemas registered after the library created
+  ast::Symbols::Init();
+  ast::ParseContext ctx;
+  auto funcs_result = ast::parse_functions_ast(ctx, source);
+  if (!funcs_result.ok()) {
+    return funcs_result.status();
+  }
+  auto& funcs = funcs_result.value();
+
+  // udfs could only call udfs defined before, so dependents always come after their deps.
+  std::vector<Entry> new_entries(funcs.size());
+  std::unordered_map<std::string, size_t> func_idxs;
+  std::vector<bool> dirty(funcs.size(), false);
+  for (size_t i = 0; i < funcs.size(); i++) {
+    auto& entry = new_entries[i];
+    size_t end = i + 1 < funcs.size() ? funcs[i + 1].position : source.size();
+    entry.source = source.substr(funcs[i].position, end - funcs[i].position);
+    entry.desc = funcs[i].ToFuncDesc();
+    const auto& local_calls = ctx.GetAllLocalFuncCalls(i);
+    entry.deps.assign(local_calls.begin(), local_calls.end());
+    func_idxs[funcs[i].name] = i;
+
+    auto found = entries_.find(funcs[i].name);
+    dirty[i] = found == entries_.end() || found->second.source != entry.source;
+    for (const auto& dep : entry.deps) {
+      if (dirty[func_idxs[dep]]) {
+        dirty[i] = true;
+      }
+    }
+  }
+
+  std::vector<std::shared_ptr<LibraryUnit>> units(funcs.size());
+  std::vector<std::string> recompiled;
+  for (size_t i = 0; i < funcs.size(); i++) {
+    if (!dirty[i]) {
+      continue;
+    }
+    // the function and all udfs it calls directly or indirectly, in source order
+    std::set<size_t> closure;
+    std::vector<size_t> pending{i};
+    while (!pending.empty()) {
+      size_t idx = pending.back();
+      pending.pop_back();
+      if (closure.insert(idx).second) {
+        for (const auto& dep : new_entries[idx].deps) {
+          pending.emplace_back(func_idxs[dep]);
+        }
+      }
+    }
+    std::string unit_source;
+    for (size_t idx : closure) {
+      unit_source.append(new_entries[idx].source);
+    }
+
+    auto compiler = pool_.Acquire();
+    auto compile_result = compiler->CompileSource(unit_source);
+    if (!compile_result.ok()) {
+      return compile_result.status();
+    }
+    auto func_ptr = compiler->GetFunctionPtr(funcs[i].name);
+    if (!func_ptr.ok()) {
+      return func_ptr.status();
+    }
+    auto unit = std::make_shared<LibraryUnit>();
+    unit->desc = new_entries[i].desc;
+    unit->func = func_ptr.value();
+    unit->codegen = compiler->GetCodeGen();
+    unit->stat = compiler->GetStat();
+    unit->no_throw = pool_.GetOptions().no_throw;
+    units[i] = unit;
+    recompiled.emplace_back(funcs[i].name);
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto prev_snapshot = state_->GetSnapshot();
+  auto snapshot = std::make_shared<LibrarySnapshot>();
+  if (prev_snapshot) {
+    snapshot->units = prev_snapshot->units;
+  }
+  std::unordered_map<std::string, Entry> entries;
+  std::vector<std::string> names;
+  for (size_t i = 0; i < funcs.size(); i++) {
+    auto& entry = new_entries[i];
+    auto found = entries_.find(funcs[i].name);
+    if (found != entries_.end() && found->second.desc.CompareSignature(entry.desc.return_type, entry.desc.arg_types)) {
+      entry.slot = found->second.slot;
+      entries_.erase(found);
+    } else {
+      entry.slot = std::make_shared<LibraryFunctionSlot>();
+      entry.slot->name = funcs[i].name;
+      entry.slot->idx = slot_count_++;
+      entry.slot->state = state_;
+      snapshot->units.resize(slot_count_);
+    }
+    if (units[i]) {
+      snapshot->units[entry.slot->idx] = units[i];
+    }
+    names.emplace_back(funcs[i].name);
+    entries.emplace(funcs[i].name, std::move(entry));
+  }
+  // removed functions & old slots of changed signatures
+  for (auto& [name, entry] : entries_) {
+    snapshot->units[entry.slot->idx].reset();
+  }
+  entries_ = std::move(entries);
+  names_ = std::move(names);
+  uint64_t version = snapshot->version = state_->version.load() + 1;
+  std::atomic_store(&state_->snapshot, std::shared_ptr<const LibrarySnapshot>(std::move(snapshot)));
+  state_->version.store(version, std::memory_order_release);
+  RUDF_DEBUG("Library version:{} loaded with {} functions, {} recompiled", version, names_.size(), recompiled.size());
+  return recompiled;
+}
+
+absl::StatusOr<std::shared_ptr<LibraryFunctionSlot>> UdfLibrary::GetSlot(const std::string& name, DType return_type,
+                                                                         const std::vector<DType>& arg_types) const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto found = entries_.find(name);
+  if (found == entries_.end()) {
+    return absl::NotFoundError(fmt::format("No function:{} found in library.", name));
+  }
+  if (!found->second.desc.CompareSignature(return_type, arg_types)) {
+    return absl::InvalidArgumentError(fmt::format("Function:{} signature mismatch", name));
+  }
+  return found->second.slot;
+}
+
+std::vector<std::string> UdfLibrary::ListFunctions() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return names_;
+}
+
+uint64_t UdfLibrary::GetVersion() const { return state_->version.load(std::memory_order_acquire); }
+}  // namespace compiler
+}  // namespace rapidudf
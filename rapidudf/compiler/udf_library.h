@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "fmt/format.h"
+
+#include "rapidudf/compiler/compiler_pool.h"
+#include "rapidudf/compiler/function.h"
+#include "rapidudf/compiler/options.h"
+#include "rapidudf/meta/dtype.h"
+#include "rapidudf/meta/exception.h"
+#include "rapidudf/meta/function.h"
+
+namespace rapidudf {
+namespace compiler {
+
+class CodeGen;
+
+/**
+** Compiled code of one library function, freed once no slot, `LibraryFunction` call or `JitFunction` holds it.
+*/
+struct LibraryUnit {
+  FunctionDesc desc;
+  void* func = nullptr;
+  std::shared_ptr<CodeGen> codegen;
+  JitFunctionStat stat;
+  bool no_throw = false;
+};
+
+/**
+** Units of all library functions published by one `Load`, every function switches to a new load at once.
+*/
+struct LibrarySnapshot {
+  uint64_t version = 0;
+  // indexed by `LibraryFunctionSlot::idx`, empty if the function was removed or its signature changed
+  std::vector<std::shared_ptr<LibraryUnit>> units;
+};
+
+struct LibraryState {
+  // bumped after `snapshot` is swapped by `std::atomic_store`, checked by every call to skip the shared_ptr load
+  std::atomic<uint64_t> version{0};
+  std::shared_ptr<const LibrarySnapshot> snapshot;
+
+  std::shared_ptr<const LibrarySnapshot> GetSnapshot() const { return std::atomic_load(&snapshot); }
+};
+
+/**
+** Unit index of a function name, a new slot is created if the function signature changed.
+*/
+struct LibraryFunctionSlot {
+  std::string name;
+  size_t idx = 0;
+  std::shared_ptr<LibraryState> state;
+
+  std::shared_ptr<LibraryUnit> GetUnit(const LibrarySnapshot& snapshot) const {
+    return idx < snapshot.units.size() ? snapshot.units[idx] : nullptr;
+  }
+};
+
+/**
+** Hot reloadable function of `UdfLibrary`, every call runs the latest loaded code.
+** The current unit is cached and only reloaded once the library version changed, so calls of one instance must not
+** run concurrently, copy it for every thread instead.
+** Throws `std::logic_error` if the function was removed or its signature changed by a later reload.
+*/
+template <typename RET, typename... Args>
+class LibraryFunction {
+ public:
+  LibraryFunction() = default;
+  explicit LibraryFunction(std::shared_ptr<LibraryFunctionSlot> slot) : slot_(std::move(slot)) {}
+
+  RET operator()(Args... args) {
+    if (slot_->state->version.load(std::memory_order_acquire) != version_) {
+      auto snapshot = slot_->state->GetSnapshot();
+      // the cached unit keeps the code alive even if it's swapped out by a concurrent reload
+      unit_ = slot_->GetUnit(*snapshot);
+      version_ = snapshot->version;
+    }
+    if (!unit_) {
+      THROW_LOGIC_ERR("udf:{} removed or signature changed by library reload", slot_->name);
+    }
+    auto f = reinterpret_cast<RET (*)(Args...)>(unit_->func);
+    return f(args...);
+  }
+  /**
+  ** Function of the current code, not affected by later reloads.
+  */
+  absl::StatusOr<JitFunction<RET, Args...>> Snapshot() const {
+    auto unit = slot_->GetUnit(*slot_->state->GetSnapshot());
+    if (!unit) {
+      return absl::NotFoundError(fmt::format("udf:{} removed or signature changed by library reload", slot_->name));
+    }
+    return JitFunction<RET, Args...>(slot_->name, unit->func, unit, unit->stat, false, unit->no_throw);
+  }
+  const std::string& GetName() const { return slot_->name; }
+
+ private:
+  std::shared_ptr<LibraryFunctionSlot> slot_;
+  uint64_t version_ = 0;
+  std::shared_ptr<LibraryUnit> unit_;
+};
+
+/**
+** Library of udfs keyed by function name.
+** `Load` compiles every function with the udfs it calls into a separate unit, a reload only recompiles functions
+** whose source changed and their dependents, then publishes all functions in one new `LibrarySnapshot`.
+*/
+class UdfLibrary {
+ public:
+  explicit UdfLibrary(Options opts = Options{});
+
+  /**
+  ** Load or reload the whole library source, returns names of recompiled functions.
+  ** Functions not in the source any more are removed, nothing changes if any function fails to compile.
+  */
+  absl::StatusOr<std::vector<std::string>> Load(const std::string& source);
+
+  template <typename RET, typename... Args>
+  absl::StatusOr<LibraryFunction<RET, Args...>> GetFunction(const std::string& name) const {
+    auto return_type = get_dtype<RET>();
+    std::vector<DType> arg_types;
+    (arg_types.emplace_back(get_dtype<Args>()), ...);
+    auto slot = GetSlot(name, return_type, arg_types);
+    if (!slot.ok()) {
+      return slot.status();
+    }
+    return LibraryFunction<RET, Args...>(std::move(slot.value()));
+  }
+
+  std::vector<std::string> ListFunctions() const;
+  // increased by every successful `Load`
+  uint64_t GetVersion() const;
+
+ private:
+  struct Entry {
+    std::string source;
+    FunctionDesc desc;
+    std::vector<std::string> deps;
+    std::shared_ptr<LibraryFunctionSlot> slot;
+  };
+  absl::StatusOr<std::shared_ptr<LibraryFunctionSlot>> GetSlot(const std::string& name, DType return_type,
+                                                               const std::vector<DType>& arg_types) const;
+
+  JitCompilerPool pool_;
+  // serializes reloads, `entries_` is only modified by `Load`
+  std::mutex reload_mutex_;
+  mutable std::mutex mutex_;
+  std::vector<std::string> names_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::shared_ptr<LibraryState> state_;
+  size_t slot_count_ = 0;
+};
+
+}  // namespace compiler
+}  // namespace rapidudf
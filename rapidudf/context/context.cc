@@ -14,8 +14,11 @@
  * limitations under the License.
  */
 #include "rapidudf/context/context.h"
+#include <chrono>
 #include <memory>
 
+#include "rapidudf/metrics/metrics.h"
+
 namespace rapidudf {
 Context::Context(ThreadCachedArena* arena) : arena_(arena) {
   if (nullptr == arena_) {
@@ -33,11 +36,30 @@ Context::~Context() { Reset(); }
 ThreadCachedArena& Context::GetArena() { return *arena_; }
 uint8_t* Context::ArenaAllocate(size_t n) {
   uint8_t* p = GetArena().Allocate(n);
+  arena_allocated_bytes_ += n;
   // allocated_arena_ptrs_.insert(p);
   return p;
 }
 
+int64_t Context::NowUs() {
+  if (!has_now_) {
+    now_us_ = std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::system_clock::now().time_since_epoch())
+                  .count();
+    has_now_ = true;
+  }
+  return now_us_;
+}
+
 void Context::Reset() {
+  if (auto* m = metrics::builtin_metrics()) {
+    m->context_resets->Add(1);
+    m->arena_allocated_bytes->Add(static_cast<int64_t>(arena_allocated_bytes_));
+    m->arena_bytes_per_reset->Observe(static_cast<int64_t>(arena_allocated_bytes_));
+  }
+  arena_allocated_bytes_ = 0;
+  has_now_ = false;
+  request_id_ = 0;
   GetArena().Reset();
   // allocated_arena_ptrs_.clear();
   // for (auto clean : cleanups_) {
@@ -137,6 +137,25 @@ class Context {
   void SetHasNan(bool v = true) { has_nan_ = v; }
   bool HasNan() const { return has_nan_; }
 
+  /**
+  ** Wall clock time in microseconds captured at the first call since last `Reset`,
+  ** all time builtins of one request read the same `now`.
+  */
+  int64_t NowUs();
+  /**
+  ** Override `now` of current request, used to replay or test time dependent rules, cleared by `Reset`.
+  */
+  void SetNow(int64_t us) {
+    now_us_ = us;
+    has_now_ = true;
+  }
+  /**
+  ** Request id keys the streams of random builtins, results are reproducible for same (seed, request id, row),
+  ** cleared by `Reset`.
+  */
+  void SetRequestId(uint64_t id) { request_id_ = id; }
+  uint64_t GetRequestId() const { return request_id_; }
+
   void Reset();
 
   ~Context();
@@ -218,6 +237,11 @@ class Context {
   PtrMap ptrs_;
 
   CleanupFuncWrapper::List cleanups_;
+  // bytes allocated by `ArenaAllocate` since last reset, flushed into metrics on reset
+  size_t arena_allocated_bytes_ = 0;
+  int64_t now_us_ = 0;
+  uint64_t request_id_ = 0;
+  bool has_now_ = false;
   bool has_nan_ = false;
 };
 }  // namespace rapidudf
\ No newline at end of file
@@ -21,8 +21,10 @@
 
 #include "rapidudf/common/lru_cache.h"
 #include "rapidudf/compiler/compiler.h"
+#include "rapidudf/compiler/compiler_pool.h"
 #include "rapidudf/compiler/function.h"
 #include "rapidudf/log/log.h"
+#include "rapidudf/metrics/metrics.h"
 
 namespace rapidudf {
 namespace exec {
@@ -48,7 +50,22 @@ struct EvalCacheValue {
 struct EvalCache : lru_cache<std::string, EvalCacheValue> {
   std::mutex mutex;
   explicit EvalCache(size_t n) : lru_cache<std::string, EvalCacheValue>(n) {}
+  // must be called with mutex held
+  void Insert(const std::string& source, const EvalCacheValue& value) {
+    bool evicted = insert(source, value);
+    if (auto* m = metrics::builtin_metrics()) {
+      if (evicted) {
+        m->eval_cache_evictions->Add(1);
+      }
+      m->eval_cache_size->Set(static_cast<int64_t>(size()));
+    }
+  }
 };
+inline void count_eval_cache_lookup(bool hit) {
+  if (auto* m = metrics::builtin_metrics()) {
+    (hit ? m->eval_cache_hits : m->eval_cache_misses)->Add(1);
+  }
+}
 
 EvalCache& get_eval_cache();
 template <class R, class... Args>
@@ -69,6 +86,7 @@ absl::StatusOr<R> eval_function(const std::string& source, Args... args) {
       for (auto& cache_func : cache_item.funcs) {
         if (cache_func.desc.CompareSignature(return_type, arg_types)) {
           RUDF_DEBUG("Cache hit for key:{}", source);
+          count_eval_cache_lookup(true);
           found_func = cache_func.GetFunc<FUNC>();
           return (*found_func)(args...);
         }
@@ -76,16 +94,17 @@ absl::StatusOr<R> eval_function(const std::string& source, Args... args) {
       return absl::NotFoundError("No func found in cache.");
     }
   }
-  compiler::JitCompiler compiler;
-  auto result = compiler.CompileSource(source);
+  count_eval_cache_lookup(false);
+  auto compiler = compiler::get_global_compiler_pool().Acquire();
+  auto result = compiler->CompileSource(source);
   if (!result.ok()) {
     return result.status();
   }
   EvalCacheValue cache_item;
   cache_item.latest_visit_time = std::chrono::high_resolution_clock::now();
-  auto all_funcs = compiler.GetParsedAST();
+  auto all_funcs = compiler->GetParsedAST();
   for (auto& func : all_funcs) {
-    auto func_ptr_result = compiler.GetFunctionPtr(func.name);
+    auto func_ptr_result = compiler->GetFunctionPtr(func.name);
     if (!func_ptr_result.ok()) {
       return func_ptr_result.status();
     }
@@ -93,8 +112,8 @@ absl::StatusOr<R> eval_function(const std::string& source, Args... args) {
     EvalFunction cache_func;
     cache_func.desc = func.ToFuncDesc();
     cache_func.func_ptr = func_ptr;
-    cache_func.codegen = compiler.GetCodeGen();
-    cache_func.stat = compiler.GetStat();
+    cache_func.codegen = compiler->GetCodeGen();
+    cache_func.stat = compiler->GetStat();
     cache_item.funcs.emplace_back(cache_func);
     if (cache_func.desc.CompareSignature(return_type, arg_types)) {
       found_func = cache_func.GetFunc<FUNC>();
@@ -102,7 +121,7 @@ absl::StatusOr<R> eval_function(const std::string& source, Args... args) {
   }
   {
     std::lock_guard<std::mutex> guard(cache_map.mutex);
-    cache_map.insert(source, cache_item);
+    cache_map.Insert(source, cache_item);
   }
   if (found_func) {
     return (*found_func)(args...);
@@ -116,9 +135,16 @@ absl::StatusOr<R> eval_expression(const std::string& source, const std::vector<c
   using FUNC = compiler::JitFunction<R, Args...>;
   FUNC* found_func = nullptr;
   auto& cache_map = get_eval_cache();
+  // same expression over different dynobj/table schemas compiles to different code
+  std::string cache_key = source;
+  for (auto& arg : arg_descs) {
+    if (!arg.schema.empty()) {
+      cache_key.append("\n#").append(arg.name).append(":").append(arg.schema);
+    }
+  }
   {
     std::lock_guard<std::mutex> guard(cache_map.mutex);
-    auto found = cache_map.get(source);
+    auto found = cache_map.get(cache_key);
     if (found) {
       auto return_type = get_dtype<R>();
       std::vector<DType> arg_types;
@@ -128,21 +154,23 @@ absl::StatusOr<R> eval_expression(const std::string& source, const std::vector<c
       for (auto& cache_func : cache_item.funcs) {
         if (cache_func.desc.CompareSignature(return_type, arg_types)) {
           RUDF_DEBUG("Cache hit for key:{}", source);
+          count_eval_cache_lookup(true);
           found_func = cache_func.GetFunc<FUNC>();
           return (*found_func)(args...);
         }
       }
     }
   }
-  compiler::JitCompiler compiler;
-  auto result = compiler.CompileDynObjExpression<R, Args...>(source, arg_descs);
+  count_eval_cache_lookup(false);
+  auto compiler = compiler::get_global_compiler_pool().Acquire();
+  auto result = compiler->CompileDynObjExpression<R, Args...>(source, arg_descs);
   if (!result.ok()) {
     return result.status();
   }
   auto ret_func = std::move(result.value());
   EvalFunction cache_func;
-  cache_func.codegen = compiler.GetCodeGen();
-  auto func_ptr_result = compiler.GetFunctionPtr(std::string(compiler::JitCompiler::kExpressionFuncName));
+  cache_func.codegen = compiler->GetCodeGen();
+  auto func_ptr_result = compiler->GetFunctionPtr(std::string(compiler::JitCompiler::kExpressionFuncName));
   if (!func_ptr_result.ok()) {
     return func_ptr_result.status();
   }
@@ -153,11 +181,11 @@ absl::StatusOr<R> eval_expression(const std::string& source, const std::vector<c
   cache_func.desc.name = std::string(compiler::JitCompiler::kExpressionFuncName);
   cache_func.desc.arg_types = arg_types;
   cache_func.desc.return_type = return_type;
-  cache_func.stat = compiler.GetStat();
+  cache_func.stat = compiler->GetStat();
   found_func = cache_func.GetFunc<FUNC>();
   {
     std::lock_guard<std::mutex> guard(cache_map.mutex);
-    auto found = cache_map.get(source);
+    auto found = cache_map.get(cache_key);
     if (found) {
       auto& cache_item = *found;
       cache_item.latest_visit_time = std::chrono::high_resolution_clock::now();
@@ -166,7 +194,7 @@ absl::StatusOr<R> eval_expression(const std::string& source, const std::vector<c
       EvalCacheValue cache_item;
       cache_item.latest_visit_time = std::chrono::high_resolution_clock::now();
       cache_item.funcs.emplace_back(cache_func);
-      cache_map.insert(source, cache_item);
+      cache_map.Insert(cache_key, cache_item);
     }
   }
   return (*found_func)(args...);
@@ -181,5 +209,14 @@ absl::StatusOr<R> eval_expression(const std::string& source, const std::vector<s
   return eval_expression<R, Args...>(source, arg_descs, args...);
 }
 
+/**
+** Expression over args `_`(Context) and `table` of table schema `schema`, compiled once per (schema, source).
+*/
+template <class R, class... Args>
+absl::StatusOr<R> eval_table_expression(const std::string& source, const std::string& schema, Args... args) {
+  std::vector<compiler::JitCompiler::Arg> arg_descs{{"_"}, {"table", schema}};
+  return eval_expression<R, Args...>(source, arg_descs, args...);
+}
+
 }  // namespace exec
 }  // namespace rapidudf
\ No newline at end of file
@@ -29,6 +29,7 @@ static constexpr std::string_view kBuiltinJsonExtract = "rapidudf_json_extract";
 
 static constexpr std::string_view kBuiltinNewSimdVector = "rapidudf_new_simd_vector";
 static constexpr std::string_view kBuiltinThrowVectorExprEx = "rapidudf_throw_vector_expr_error";
+static constexpr std::string_view kBuiltinErrorCode = "rapidudf_error_code";
 
 static constexpr std::string_view kTableGetColumnFunc = "get_column";
 
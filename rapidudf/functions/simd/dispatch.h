@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "hwy/targets.h"
+
+namespace rapidudf {
+namespace functions {
+/**
+** Choose the best supported highway target once, so that `HWY_DYNAMIC_POINTER` returns the target kernel instead
+** of the stub which chooses target at the first call.
+*/
+inline void choose_simd_target() {
+  static bool chosen = []() {
+    hwy::GetChosenTarget().Update(hwy::SupportedTargets());
+    return true;
+  }();
+  (void)chosen;
+}
+}  // namespace functions
+}  // namespace rapidudf
+
+/**
+** Kernel pointer of the chosen target in a `HWY_EXPORT_T` table, used to bind jit calls without dispatching
+** through the table for every vector block, must be used after `hwy/highway.h` included.
+*/
+#define RUDF_HWY_DYNAMIC_POINTER(TABLE) \
+  (::rapidudf::functions::choose_simd_target(), reinterpret_cast<void*>(HWY_DYNAMIC_POINTER(TABLE)))
@@ -18,7 +18,9 @@
 #include <string.h>
 #include <limits>
 #include <vector>
+#include "absl/strings/numbers.h"
 #include "rapidudf/log/log.h"
+#include "rapidudf/meta/dtype_enums.h"
 
 #undef HWY_TARGET_INCLUDE
 #define HWY_TARGET_INCLUDE "rapidudf/functions/simd/string.cc"  // this file
@@ -96,7 +98,7 @@ HWY_INLINE int simd_string_find_string_impl(const char* s, size_t len, const cha
         if (part_len == 2) {
           return found + idx;
         }
-        if (memcmp(input + idx + first_pos + 1, part + 1, part_len - 2) == 0) {
+        if (memcmp(input + idx + found + 1, part + 1, part_len - 2) == 0) {
           return found + idx;
         }
         auto tmp = hn::SetOnlyFirst(mask);
@@ -105,8 +107,8 @@ HWY_INLINE int simd_string_find_string_impl(const char* s, size_t len, const cha
       }
     }
   }
-  // `count` was a multiple of the vector length `N`: already done.
-  if (HWY_UNLIKELY(idx == (len - part_len))) {
+  // every candidate position was already checked.
+  if (HWY_UNLIKELY(idx > (len - part_len))) {
     return -1;
   }
   const size_t remaining = len - idx - part_len + 1;
@@ -156,9 +158,7 @@ struct ClearMaskHelper {
   }
 };
 
-HWY_INLINE std::vector<uint32_t> simd_string_split_by_char_impl(std::string_view s, char ch) {
-  std::vector<uint32_t> sep_positions;
-  sep_positions.reserve(16);
+HWY_INLINE void simd_string_split_by_char_impl(std::string_view s, char ch, std::vector<uint32_t>& sep_positions) {
   const uint8_t* input = reinterpret_cast<const uint8_t*>(s.data());
   using D = hn::ScalableTag<uint8_t>;
   constexpr D d;
@@ -182,7 +182,7 @@ HWY_INLINE std::vector<uint32_t> simd_string_split_by_char_impl(std::string_view
     }
   }
   // `count` was a multiple of the vector length `N`: already done.
-  if (HWY_UNLIKELY(idx == len)) return sep_positions;
+  if (HWY_UNLIKELY(idx == len)) return;
   const size_t remaining = len - idx;
   HWY_DASSERT(0 != remaining && remaining < N);
   const hn::Vec<D> v = hn::LoadN(d, input + idx, remaining);
@@ -198,15 +198,14 @@ HWY_INLINE std::vector<uint32_t> simd_string_split_by_char_impl(std::string_view
     mask = hn::AndNot(tmp, mask);
     found = hn::FindFirstTrue(d, mask);
   }
-  return sep_positions;
 }
 
-HWY_INLINE std::vector<uint32_t> simd_string_split_by_string_impl(std::string_view s, std::string_view sep) {
+HWY_INLINE void simd_string_split_by_string_impl(std::string_view s, std::string_view sep,
+                                                 std::vector<uint32_t>& sep_positions) {
   if (sep.size() == 1) {
-    return simd_string_split_by_char_impl(s, sep[0]);
+    simd_string_split_by_char_impl(s, sep[0], sep_positions);
+    return;
   }
-  std::vector<uint32_t> sep_positions;
-  sep_positions.reserve(16);
   const char* data = s.data();
   size_t len = s.length();
   int idx = simd_string_find_string_impl(data, len, sep.data(), sep.size());
@@ -218,7 +217,6 @@ HWY_INLINE std::vector<uint32_t> simd_string_split_by_string_impl(std::string_vi
     len -= (idx + sep.size());
     idx = simd_string_find_string_impl(data, len, sep.data(), sep.size());
   }
-  return sep_positions;
 }
 
 }  // namespace HWY_NAMESPACE
@@ -241,7 +239,9 @@ int simd_string_find_string(std::string_view s, std::string_view part) {
 
 std::vector<std::string_view> simd_string_split_by_char(std::string_view s, char ch) {
   HWY_EXPORT_T(Table, simd_string_split_by_char_impl);
-  std::vector<uint32_t> sep_positions = HWY_DYNAMIC_DISPATCH_T(Table)(s, ch);
+  std::vector<uint32_t> sep_positions;
+  sep_positions.reserve(16);
+  HWY_DYNAMIC_DISPATCH_T(Table)(s, ch, sep_positions);
   std::vector<std::string_view> ss;
   ss.reserve(sep_positions.size());
   size_t last_pos = 0;
@@ -259,7 +259,9 @@ std::vector<std::string_view> simd_string_split_by_char(std::string_view s, char
 
 std::vector<std::string_view> simd_string_split_by_string(std::string_view s, std::string_view sep) {
   HWY_EXPORT_T(Table, simd_string_split_by_string_impl);
-  std::vector<uint32_t> sep_positions = HWY_DYNAMIC_DISPATCH_T(Table)(s, sep);
+  std::vector<uint32_t> sep_positions;
+  sep_positions.reserve(16);
+  HWY_DYNAMIC_DISPATCH_T(Table)(s, sep, sep_positions);
 
   std::vector<std::string_view> ss;
   ss.reserve(sep_positions.size());
@@ -276,6 +278,263 @@ std::vector<std::string_view> simd_string_split_by_string(std::string_view s, st
   return ss;
 }
 
+// separator positions of one string, reused by calls of same thread to avoid heap allocation per call.
+static const std::vector<uint32_t>& split_positions(StringView s, StringView sep) {
+  thread_local std::vector<uint32_t> sep_positions;
+  sep_positions.clear();
+  if (!sep.empty()) {
+    HWY_EXPORT_T(Table, simd_string_split_by_string_impl);
+    HWY_DYNAMIC_DISPATCH_T(Table)(std::string_view(s), std::string_view(sep), sep_positions);
+  }
+  return sep_positions;
+}
+
+// visit parts in order until `f` returns false, empty parts are skipped if `skip_empty`, otherwise parts are indexed by
+// their field position.
+template <bool skip_empty, typename F>
+static void visit_split_parts(StringView s, StringView sep, const std::vector<uint32_t>& sep_positions, F&& f) {
+  size_t part_idx = 0;
+  size_t last_pos = 0;
+  for (size_t i = 0; i <= sep_positions.size(); i++) {
+    size_t pos = i < sep_positions.size() ? sep_positions[i] : s.size();
+    if (!skip_empty || pos > last_pos) {
+      if (!f(part_idx++, StringView(s.data() + last_pos, pos - last_pos))) {
+        return;
+      }
+    }
+    last_pos = pos + sep.size();
+  }
+}
+
+Vector<StringView> simd_string_split(Context& ctx, StringView s, StringView sep) {
+  const auto& sep_positions = split_positions(s, sep);
+  size_t capacity = sizeof(StringView) * (sep_positions.size() + 1);
+  StringView* parts = reinterpret_cast<StringView*>(ctx.ArenaAllocate(capacity));
+  size_t n = 0;
+  visit_split_parts<true>(s, sep, sep_positions, [&](size_t, StringView part) {
+    parts[n++] = part;
+    return true;
+  });
+  VectorBuf vdata(parts, n, capacity);
+  vdata.SetReadonly(false);
+  return Vector<StringView>(vdata);
+}
+
+Vector<StringView> simd_vector_split_part(Context& ctx, Vector<StringView> strs, StringView sep, uint32_t idx) {
+  VectorBuf vdata = ctx.NewVectorBuf<StringView>(strs.Size());
+  StringView* out = vdata.MutableData<StringView>();
+  for (size_t i = 0; i < strs.Size(); i++) {
+    out[i] = StringView();
+    visit_split_parts<true>(strs[i], sep, split_positions(strs[i], sep), [&](size_t part_idx, StringView part) {
+      if (part_idx == idx) {
+        out[i] = part;
+        return false;
+      }
+      return true;
+    });
+  }
+  return Vector<StringView>(vdata);
+}
+
+static inline bool is_eight_digits(uint64_t v) {
+  return (((v & 0xF0F0F0F0F0F0F0F0ULL) | (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+          0x3333333333333333ULL);
+}
+
+// SWAR conversion of 8 little endian ascii digits
+static inline uint32_t parse_eight_digits(uint64_t v) {
+  constexpr uint64_t mask = 0x000000FF000000FFULL;
+  constexpr uint64_t mul1 = 0x000F424000000064ULL;  // 100 + (1000000ULL << 32)
+  constexpr uint64_t mul2 = 0x0000271000000001ULL;  // 1 + (10000ULL << 32)
+  v -= 0x3030303030303030ULL;
+  v = (v * 10) + (v >> 8);
+  v = (((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32;
+  return static_cast<uint32_t>(v);
+}
+
+// accumulate leading digits into `v`, returns consumed digit count.
+static inline size_t parse_digits(const char* p, size_t len, uint64_t& v) {
+  size_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+    uint64_t chunk;
+    memcpy(&chunk, p + i, 8);
+    if (!is_eight_digits(chunk)) {
+      break;
+    }
+    v = v * 100000000 + parse_eight_digits(chunk);
+  }
+  for (; i < len && p[i] >= '0' && p[i] <= '9'; i++) {
+    v = v * 10 + (p[i] - '0');
+  }
+  return i;
+}
+
+static inline bool parse_sign(const char*& p, size_t& len) {
+  bool negative = false;
+  if (len > 0 && (p[0] == '-' || p[0] == '+')) {
+    negative = p[0] == '-';
+    p++;
+    len--;
+  }
+  return negative;
+}
+
+static inline bool parse_int64_fast(StringView s, int64_t& v) {
+  const char* p = s.data();
+  size_t len = s.size();
+  bool negative = parse_sign(p, len);
+  // at most 19 digits never overflow uint64
+  if (len == 0 || len > 19) {
+    return false;
+  }
+  uint64_t u = 0;
+  if (parse_digits(p, len, u) != len) {
+    return false;
+  }
+  if (u > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + (negative ? 1 : 0)) {
+    return false;
+  }
+  v = negative ? static_cast<int64_t>(~u + 1) : static_cast<int64_t>(u);
+  return true;
+}
+
+template <typename T>
+static T parse_integer(StringView s) {
+  int64_t v = 0;
+  if (parse_int64_fast(s, v) && v >= static_cast<int64_t>(std::numeric_limits<T>::min()) &&
+      (std::is_same_v<T, uint64_t> || v <= static_cast<int64_t>(std::numeric_limits<T>::max()))) {
+    return static_cast<T>(v);
+  }
+  T result = 0;
+  if (absl::SimpleAtoi(s.get_absl_string_view(), &result)) {
+    return result;
+  }
+  return 0;
+}
+
+static double parse_double(StringView s) {
+  static constexpr double kPow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  const char* p = s.data();
+  size_t len = s.size();
+  bool negative = parse_sign(p, len);
+  uint64_t mantissa = 0;
+  size_t int_digits = parse_digits(p, len, mantissa);
+  size_t frac_digits = 0;
+  size_t consumed = int_digits;
+  if (int_digits < len && p[int_digits] == '.') {
+    frac_digits = parse_digits(p + int_digits + 1, len - int_digits - 1, mantissa);
+    consumed += frac_digits + 1;
+  }
+  // exact when mantissa and 10^frac_digits are both exactly representable, otherwise use the slow path.
+  if (consumed == len && int_digits + frac_digits > 0 && int_digits + frac_digits <= 19 &&
+      mantissa <= (1ULL << 53)) {
+    double v = static_cast<double>(mantissa) / kPow10[frac_digits];
+    return negative ? -v : v;
+  }
+  double v = 0;
+  if (absl::SimpleAtod(s.get_absl_string_view(), &v)) {
+    return v;
+  }
+  return 0;
+}
+
+Vector<int64_t> simd_vector_to_int(Context& ctx, Vector<StringView> strs) {
+  VectorBuf vdata = ctx.NewVectorBuf<int64_t>(strs.Size());
+  int64_t* out = vdata.MutableData<int64_t>();
+  for (size_t i = 0; i < strs.Size(); i++) {
+    out[i] = parse_integer<int64_t>(strs[i]);
+  }
+  return Vector<int64_t>(vdata);
+}
+
+Vector<double> simd_vector_to_float(Context& ctx, Vector<StringView> strs) {
+  VectorBuf vdata = ctx.NewVectorBuf<double>(strs.Size());
+  double* out = vdata.MutableData<double>();
+  for (size_t i = 0; i < strs.Size(); i++) {
+    out[i] = parse_double(strs[i]);
+  }
+  return Vector<double>(vdata);
+}
+
+absl::Status simd_vector_split_to_columns(Context& ctx, Vector<StringView> strs, StringView sep,
+                                          absl::Span<const DType> dtypes, std::vector<VectorBuf>& columns) {
+  columns.clear();
+  for (auto& dtype : dtypes) {
+    VectorBuf column;
+    switch (dtype.GetFundamentalType()) {
+      case DATA_STRING_VIEW: {
+        column = ctx.NewVectorBuf<StringView>(strs.Size());
+        break;
+      }
+      case DATA_I32:
+      case DATA_U32:
+      case DATA_F32: {
+        column = ctx.NewVectorBuf<uint32_t>(strs.Size());
+        break;
+      }
+      case DATA_I64:
+      case DATA_U64:
+      case DATA_F64: {
+        column = ctx.NewVectorBuf<uint64_t>(strs.Size());
+        break;
+      }
+      default: {
+        RUDF_LOG_RETURN_FMT_ERROR("Unsupported split column dtype:{}", dtype);
+      }
+    }
+    memset(column.MutableData<uint8_t>(), 0, column.BytesCapacity());
+    columns.emplace_back(column);
+  }
+  for (size_t i = 0; i < strs.Size(); i++) {
+    // parts are assigned by field position, empty fields keep 0 or empty string
+    visit_split_parts<false>(strs[i], sep, split_positions(strs[i], sep), [&](size_t part_idx, StringView part) {
+      if (part_idx >= dtypes.size()) {
+        return false;
+      }
+      if (part.empty()) {
+        return true;
+      }
+      VectorBuf& column = columns[part_idx];
+      switch (dtypes[part_idx].GetFundamentalType()) {
+        case DATA_STRING_VIEW: {
+          column.MutableData<StringView>()[i] = part;
+          break;
+        }
+        case DATA_I32: {
+          column.MutableData<int32_t>()[i] = parse_integer<int32_t>(part);
+          break;
+        }
+        case DATA_U32: {
+          column.MutableData<uint32_t>()[i] = parse_integer<uint32_t>(part);
+          break;
+        }
+        case DATA_I64: {
+          column.MutableData<int64_t>()[i] = parse_integer<int64_t>(part);
+          break;
+        }
+        case DATA_U64: {
+          column.MutableData<uint64_t>()[i] = parse_integer<uint64_t>(part);
+          break;
+        }
+        case DATA_F32: {
+          column.MutableData<float>()[i] = static_cast<float>(parse_double(part));
+          break;
+        }
+        case DATA_F64: {
+          column.MutableData<double>()[i] = parse_double(part);
+          break;
+        }
+        default: {
+          break;
+        }
+      }
+      return true;
+    });
+  }
+  return absl::OkStatus();
+}
+
 }  // namespace functions
 }  // namespace rapidudf
 #endif  // HWY_ONCE
\ No newline at end of file
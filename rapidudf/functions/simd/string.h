@@ -18,6 +18,13 @@
 
 #include <string_view>
 #include <vector>
+
+#include "absl/status/status.h"
+#include "absl/types/span.h"
+#include "rapidudf/context/context.h"
+#include "rapidudf/meta/dtype.h"
+#include "rapidudf/types/string_view.h"
+#include "rapidudf/types/vector.h"
 namespace rapidudf {
 namespace functions {
 
@@ -27,5 +34,26 @@ int simd_string_find_string(std::string_view s, std::string_view part);
 std::vector<std::string_view> simd_string_split_by_char(std::string_view s, char ch);
 std::vector<std::string_view> simd_string_split_by_string(std::string_view s, std::string_view sep);
 
+/**
+** split into parts allocated in ctx arena, empty parts are skipped like `simd_string_split_by_char`.
+*/
+Vector<StringView> simd_string_split(Context& ctx, StringView s, StringView sep);
+/**
+** the `idx`th part(empty parts are skipped) of every string, empty string if there is no such part.
+*/
+Vector<StringView> simd_vector_split_part(Context& ctx, Vector<StringView> strs, StringView sep, uint32_t idx);
+/**
+** split every string once and parse the `i`th field(empty fields are kept) as `dtypes[i]` into `columns[i]`, supported
+** dtypes are string_view/i32/i64/u32/u64/f32/f64, missing, empty or invalid fields are 0 or empty string.
+*/
+absl::Status simd_vector_split_to_columns(Context& ctx, Vector<StringView> strs, StringView sep,
+                                          absl::Span<const DType> dtypes, std::vector<VectorBuf>& columns);
+
+/**
+** parse decimal strings, invalid strings are parsed as 0.
+*/
+Vector<int64_t> simd_vector_to_int(Context& ctx, Vector<StringView> strs);
+Vector<double> simd_vector_to_float(Context& ctx, Vector<StringView> strs);
+
 }  // namespace functions
 }  // namespace rapidudf
\ No newline at end of file
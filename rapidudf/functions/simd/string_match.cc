@@ -0,0 +1,812 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "rapidudf/functions/simd/string_match.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+#include <map>
+#include <utility>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "fmt/format.h"
+#include "rapidudf/functions/simd/string.h"
+#include "rapidudf/log/log.h"
+#include "rapidudf/meta/exception.h"
+
+namespace rapidudf {
+namespace functions {
+static constexpr size_t kMaxNfaNodes = 16 * 1024;
+static constexpr size_t kMaxDfaTransitions = 1024 * 1024;
+static constexpr size_t kMaxRepeatCount = 1000;
+static constexpr size_t kMaxCachedPatterns = 1024;
+
+using ByteSet = std::bitset<256>;
+
+struct RegexNode {
+  enum Kind { kBytes, kConcat, kAlt, kRepeat, kBegin, kEnd };
+  Kind kind = kConcat;
+  ByteSet bytes;
+  std::vector<RegexNode> children;
+  int min = 0;
+  int max = -1;  // -1 is unbounded
+
+  static RegexNode Bytes(ByteSet bytes) {
+    RegexNode node;
+    node.kind = kBytes;
+    node.bytes = bytes;
+    return node;
+  }
+  static RegexNode Byte(uint8_t c) {
+    ByteSet bytes;
+    bytes.set(c);
+    return Bytes(bytes);
+  }
+  static RegexNode Anchor(Kind kind) {
+    RegexNode node;
+    node.kind = kind;
+    return node;
+  }
+  static RegexNode Repeat(RegexNode child, int min, int max) {
+    RegexNode node;
+    node.kind = kRepeat;
+    node.min = min;
+    node.max = max;
+    node.children.emplace_back(std::move(child));
+    return node;
+  }
+};
+
+class RegexParser {
+ public:
+  explicit RegexParser(std::string_view pattern) : pattern_(pattern) {}
+
+  absl::StatusOr<RegexNode> Parse() {
+    auto result = ParseAlt();
+    if (result.ok() && !AtEnd()) {
+      return Error("unmatched ')'");
+    }
+    return result;
+  }
+
+ private:
+  absl::Status Error(std::string_view msg) const {
+    return absl::InvalidArgumentError(fmt::format("invalid regex:'{}' at {}, {}", pattern_, pos_, msg));
+  }
+  bool AtEnd() const { return pos_ >= pattern_.size(); }
+  char Peek() const { return pattern_[pos_]; }
+
+  absl::StatusOr<RegexNode> ParseAlt() {
+    RegexNode alt;
+    alt.kind = RegexNode::kAlt;
+    while (true) {
+      auto branch = ParseConcat();
+      if (!branch.ok()) {
+        return branch.status();
+      }
+      alt.children.emplace_back(std::move(branch.value()));
+      if (AtEnd() || Peek() != '|') {
+        break;
+      }
+      pos_++;
+    }
+    if (alt.children.size() == 1) {
+      return std::move(alt.children[0]);
+    }
+    return alt;
+  }
+
+  absl::StatusOr<RegexNode> ParseConcat() {
+    RegexNode concat;
+    concat.kind = RegexNode::kConcat;
+    while (!AtEnd() && Peek() != '|' && Peek() != ')') {
+      auto atom = ParseAtom();
+      if (!atom.ok()) {
+        return atom.status();
+      }
+      auto repeat = ParseRepeat(std::move(atom.value()));
+      if (!repeat.ok()) {
+        return repeat.status();
+      }
+      concat.children.emplace_back(std::move(repeat.value()));
+    }
+    return concat;
+  }
+
+  // parse `{m}`, `{m,}` or `{m,n}`, a `{` not followed by a valid count is a literal.
+  bool ParseCount(int& min, int& max) {
+    size_t pos = pos_ + 1;
+    auto parse_int = [&](int& v) {
+      size_t start = pos;
+      v = 0;
+      while (pos < pattern_.size() && pattern_[pos] >= '0' && pattern_[pos] <= '9' && pos - start < 6) {
+        v = v * 10 + (pattern_[pos++] - '0');
+      }
+      return pos > start;
+    };
+    if (!parse_int(min)) {
+      return false;
+    }
+    max = min;
+    if (pos < pattern_.size() && pattern_[pos] == ',') {
+      pos++;
+      if (!parse_int(max)) {
+        max = -1;
+      }
+    }
+    if (pos >= pattern_.size() || pattern_[pos] != '}') {
+      return false;
+    }
+    pos_ = pos + 1;
+    return true;
+  }
+
+  absl::StatusOr<RegexNode> ParseRepeat(RegexNode atom) {
+    while (!AtEnd()) {
+      int min = 0;
+      int max = -1;
+      char c = Peek();
+      if (c == '*') {
+        pos_++;
+      } else if (c == '+') {
+        min = 1;
+        pos_++;
+      } else if (c == '?') {
+        max = 1;
+        pos_++;
+      } else if (c != '{' || !ParseCount(min, max)) {
+        break;
+      }
+      if (atom.kind == RegexNode::kBegin || atom.kind == RegexNode::kEnd) {
+        return Error("nothing to repeat");
+      }
+      if (max > static_cast<int>(kMaxRepeatCount) || min > static_cast<int>(kMaxRepeatCount) ||
+          (max >= 0 && max < min)) {
+        return Error("bad repetition count");
+      }
+      // lazy or greedy makes no difference on whether there is a match
+      if (!AtEnd() && Peek() == '?') {
+        pos_++;
+      }
+      atom = RegexNode::Repeat(std::move(atom), min, max);
+    }
+    return atom;
+  }
+
+  absl::Status ParseEscape(ByteSet& bytes) {
+    if (AtEnd()) {
+      return Error("trailing '\\'");
+    }
+    char c = pattern_[pos_++];
+    ByteSet digits, words, spaces;
+    for (int i = '0'; i <= '9'; i++) {
+      digits.set(i);
+    }
+    words = digits;
+    for (int i = 'a'; i <= 'z'; i++) {
+      words.set(i);
+      words.set(i - 'a' + 'A');
+    }
+    words.set('_');
+    for (char space : std::string_view(" \t\n\r\f\v")) {
+      spaces.set(static_cast<uint8_t>(space));
+    }
+    switch (c) {
+      case 'd': {
+        bytes = digits;
+        break;
+      }
+      case 'D': {
+        bytes = ~digits;
+        break;
+      }
+      case 'w': {
+        bytes = words;
+        break;
+      }
+      case 'W': {
+        bytes = ~words;
+        break;
+      }
+      case 's': {
+        bytes = spaces;
+        break;
+      }
+      case 'S': {
+        bytes = ~spaces;
+        break;
+      }
+      case 'n': {
+        bytes.set('\n');
+        break;
+      }
+      case 'r': {
+        bytes.set('\r');
+        break;
+      }
+      case 't': {
+        bytes.set('\t');
+        break;
+      }
+      case 'f': {
+        bytes.set('\f');
+        break;
+      }
+      case 'v': {
+        bytes.set('\v');
+        break;
+      }
+      default: {
+        if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
+          pos_--;
+          return Error("unsupported escape");
+        }
+        bytes.set(static_cast<uint8_t>(c));
+        break;
+      }
+    }
+    return absl::OkStatus();
+  }
+
+  absl::StatusOr<RegexNode> ParseClass() {
+    ByteSet bytes;
+    bool negate = false;
+    if (!AtEnd() && Peek() == '^') {
+      negate = true;
+      pos_++;
+    }
+    bool first = true;
+    while (!AtEnd() && (Peek() != ']' || first)) {
+      first = false;
+      char c = pattern_[pos_++];
+      if (c == '\\') {
+        ByteSet escaped;
+        auto status = ParseEscape(escaped);
+        if (!status.ok()) {
+          return status;
+        }
+        bytes |= escaped;
+        continue;
+      }
+      uint8_t lo = static_cast<uint8_t>(c);
+      uint8_t hi = lo;
+      if (pos_ + 1 < pattern_.size() && Peek() == '-' && pattern_[pos_ + 1] != ']') {
+        hi = static_cast<uint8_t>(pattern_[pos_ + 1]);
+        if (hi == '\\' || hi < lo) {
+          return Error("bad character class range");
+        }
+        pos_ += 2;
+      }
+      for (uint32_t i = lo; i <= hi; i++) {
+        bytes.set(i);
+      }
+    }
+    if (AtEnd()) {
+      return Error("missing ']'");
+    }
+    pos_++;
+    return RegexNode::Bytes(negate ? ~bytes : bytes);
+  }
+
+  absl::StatusOr<RegexNode> ParseAtom() {
+    char c = pattern_[pos_++];
+    switch (c) {
+      case '(': {
+        if (!AtEnd() && Peek() == '?') {
+          if (pos_ + 1 < pattern_.size() && pattern_[pos_ + 1] == ':') {
+            pos_ += 2;
+          } else {
+            return Error("unsupported group flags");
+          }
+        }
+        auto inner = ParseAlt();
+        if (!inner.ok()) {
+          return inner;
+        }
+        if (AtEnd() || Peek() != ')') {
+          return Error("missing ')'");
+        }
+        pos_++;
+        return inner;
+      }
+      case '[': {
+        return ParseClass();
+      }
+      case '.': {
+        ByteSet bytes;
+        bytes.set();
+        bytes.reset('\n');
+        return RegexNode::Bytes(bytes);
+      }
+      case '^': {
+        return RegexNode::Anchor(RegexNode::kBegin);
+      }
+      case '$': {
+        return RegexNode::Anchor(RegexNode::kEnd);
+      }
+      case '\\': {
+        ByteSet bytes;
+        auto status = ParseEscape(bytes);
+        if (!status.ok()) {
+          return status;
+        }
+        return RegexNode::Bytes(bytes);
+      }
+      case '*':
+      case '+':
+      case '?': {
+        pos_--;
+        return Error("nothing to repeat");
+      }
+      default: {
+        return RegexNode::Byte(static_cast<uint8_t>(c));
+      }
+    }
+  }
+
+  std::string_view pattern_;
+  size_t pos_ = 0;
+};
+
+struct NfaNode {
+  enum Kind { kBytes, kSplit, kBegin, kEnd, kMatch };
+  Kind kind = kSplit;
+  ByteSet bytes;
+  std::vector<uint32_t> outs;
+};
+
+class NfaBuilder {
+ public:
+  absl::StatusOr<uint32_t> Build(const RegexNode& root) {
+    uint32_t match = Add(NfaNode::kMatch, {});
+    return Compile(root, match);
+  }
+  const std::vector<NfaNode>& Nodes() const { return nodes_; }
+
+ private:
+  uint32_t Add(NfaNode::Kind kind, std::vector<uint32_t> outs) {
+    NfaNode node;
+    node.kind = kind;
+    node.outs = std::move(outs);
+    nodes_.emplace_back(std::move(node));
+    return static_cast<uint32_t>(nodes_.size() - 1);
+  }
+
+  // compile `node` with continuation `next`, returns the entry node.
+  absl::StatusOr<uint32_t> Compile(const RegexNode& node, uint32_t next) {
+    if (nodes_.size() > kMaxNfaNodes) {
+      return absl::InvalidArgumentError("pattern is too large");
+    }
+    switch (node.kind) {
+      case RegexNode::kBytes: {
+        uint32_t id = Add(NfaNode::kBytes, {next});
+        nodes_[id].bytes = node.bytes;
+        return id;
+      }
+      case RegexNode::kBegin: {
+        return Add(NfaNode::kBegin, {next});
+      }
+      case RegexNode::kEnd: {
+        return Add(NfaNode::kEnd, {next});
+      }
+      case RegexNode::kConcat: {
+        for (auto it = node.children.rbegin(); it != node.children.rend(); it++) {
+          auto result = Compile(*it, next);
+          if (!result.ok()) {
+            return result;
+          }
+          next = result.value();
+        }
+        return next;
+      }
+      case RegexNode::kAlt: {
+        std::vector<uint32_t> outs;
+        for (const auto& child : node.children) {
+          auto result = Compile(child, next);
+          if (!result.ok()) {
+            return result;
+          }
+          outs.emplace_back(result.value());
+        }
+        return Add(NfaNode::kSplit, std::move(outs));
+      }
+      case RegexNode::kRepeat: {
+        const RegexNode& child = node.children[0];
+        uint32_t exit = next;
+        if (node.max < 0) {
+          uint32_t loop = Add(NfaNode::kSplit, {});
+          auto body = Compile(child, loop);
+          if (!body.ok()) {
+            return body;
+          }
+          nodes_[loop].outs = {body.value(), exit};
+          next = loop;
+        } else {
+          for (int i = node.min; i < node.max; i++) {
+            auto body = Compile(child, next);
+            if (!body.ok()) {
+              return body;
+            }
+            next = Add(NfaNode::kSplit, {body.value(), exit});
+          }
+        }
+        for (int i = 0; i < node.min; i++) {
+          auto body = Compile(child, next);
+          if (!body.ok()) {
+            return body;
+          }
+          next = body.value();
+        }
+        return next;
+      }
+      default: {
+        return absl::InvalidArgumentError("unknown regex node");
+      }
+    }
+  }
+
+  std::vector<NfaNode> nodes_;
+};
+
+/**
+** subset construction over byte equivalence classes, a dfa state is the sorted set of byte/end/match nfa nodes.
+*/
+struct DfaBuilder {
+  DfaBuilder(const std::vector<NfaNode>& nfa, uint32_t entry, bool search)
+      : nodes(nfa), start(entry), unanchored(search), marks(nfa.size(), 0) {}
+
+  // epsilon closure of `stack` into `out`, `^` is passable only at begin, `$` only at end.
+  void Closure(std::vector<uint32_t>& stack, bool at_begin, bool at_end, std::vector<uint32_t>& out) {
+    generation++;
+    while (!stack.empty()) {
+      uint32_t id = stack.back();
+      stack.pop_back();
+      if (marks[id] == generation) {
+        continue;
+      }
+      marks[id] = generation;
+      const NfaNode& node = nodes[id];
+      switch (node.kind) {
+        case NfaNode::kBytes:
+        case NfaNode::kMatch: {
+          out.emplace_back(id);
+          break;
+        }
+        case NfaNode::kEnd: {
+          out.emplace_back(id);
+          if (at_end) {
+            stack.emplace_back(node.outs[0]);
+          }
+          break;
+        }
+        case NfaNode::kBegin: {
+          if (at_begin) {
+            stack.emplace_back(node.outs[0]);
+          }
+          break;
+        }
+        case NfaNode::kSplit: {
+          stack.insert(stack.end(), node.outs.rbegin(), node.outs.rend());
+          break;
+        }
+      }
+    }
+    std::sort(out.begin(), out.end());
+  }
+
+  bool HasMatch(const std::vector<uint32_t>& set) const {
+    return std::any_of(set.begin(), set.end(), [&](uint32_t id) { return nodes[id].kind == NfaNode::kMatch; });
+  }
+
+  absl::StatusOr<uint32_t> Intern(std::vector<uint32_t>&& set) {
+    if (set.empty()) {
+      return 0;
+    }
+    auto found = state_ids.find(set);
+    if (found != state_ids.end()) {
+      return found->second;
+    }
+    if ((states.size() + 1) * num_classes > kMaxDfaTransitions) {
+      return absl::InvalidArgumentError("pattern is too complex, too many dfa states");
+    }
+    uint32_t id = static_cast<uint32_t>(states.size());
+    state_ids.emplace(set, id);
+    states.emplace_back(std::move(set));
+    return id;
+  }
+
+  absl::Status Build(StringMatcher& matcher) {
+    // bytes are in the same class if every byte set of nfa contains both or neither of them
+    std::map<std::string, uint8_t> signatures;
+    std::vector<uint8_t> class_bytes;
+    for (uint32_t c = 0; c < 256; c++) {
+      std::string signature;
+      for (const auto& node : nodes) {
+        if (node.kind == NfaNode::kBytes) {
+          signature.push_back(node.bytes.test(c) ? '1' : '0');
+        }
+      }
+      auto [it, inserted] = signatures.emplace(signature, static_cast<uint8_t>(class_bytes.size()));
+      if (inserted) {
+        class_bytes.emplace_back(static_cast<uint8_t>(c));
+      }
+      matcher.byte_classes_[c] = it->second;
+    }
+    num_classes = static_cast<uint32_t>(class_bytes.size());
+
+    states.emplace_back();  // dead state
+    std::vector<uint32_t> stack{start};
+    std::vector<uint32_t> start_set;
+    Closure(stack, true, false, start_set);
+    auto start_id = Intern(std::move(start_set));
+    if (!start_id.ok()) {
+      return start_id.status();
+    }
+
+    std::vector<uint32_t> transitions(num_classes, 0);
+    std::vector<uint8_t> accept_now{0};
+    std::vector<uint8_t> accept_end{0};
+    for (size_t i = 1; i < states.size(); i++) {
+      bool match_now = HasMatch(states[i]);
+      std::vector<uint32_t> end_set;
+      stack = states[i];
+      Closure(stack, false, true, end_set);
+      accept_now.emplace_back(match_now ? 1 : 0);
+      accept_end.emplace_back(HasMatch(end_set) ? 1 : 0);
+      transitions.resize((i + 1) * num_classes, 0);
+      if (match_now) {
+        // matching stops at an accepting state, no transition needed.
+        continue;
+      }
+      for (uint32_t cls = 0; cls < num_classes; cls++) {
+        stack.clear();
+        if (unanchored) {
+          stack.emplace_back(start);
+        }
+        for (uint32_t id : states[i]) {
+          if (nodes[id].kind == NfaNode::kBytes && nodes[id].bytes.test(class_bytes[cls])) {
+            stack.emplace_back(nodes[id].outs[0]);
+          }
+        }
+        std::vector<uint32_t> next_set;
+        Closure(stack, false, false, next_set);
+        auto next_id = Intern(std::move(next_set));
+        if (!next_id.ok()) {
+          return next_id.status();
+        }
+        transitions[i * num_classes + cls] = next_id.value();
+      }
+    }
+    matcher.use_dfa_ = true;
+    matcher.num_classes_ = num_classes;
+    matcher.start_ = start_id.value();
+    matcher.transitions_ = std::move(transitions);
+    matcher.accept_now_ = std::move(accept_now);
+    matcher.accept_end_ = std::move(accept_end);
+    return absl::OkStatus();
+  }
+
+  const std::vector<NfaNode>& nodes;
+  uint32_t start;
+  bool unanchored;
+  std::vector<uint32_t> marks;
+  uint32_t generation = 0;
+  uint32_t num_classes = 0;
+  std::vector<std::vector<uint32_t>> states;
+  std::map<std::vector<uint32_t>, uint32_t> state_ids;
+};
+
+static absl::StatusOr<std::unique_ptr<StringMatcher>> build_dfa_matcher(const RegexNode& root, bool search,
+                                                                       std::unique_ptr<StringMatcher> matcher) {
+  NfaBuilder nfa;
+  auto entry = nfa.Build(root);
+  if (!entry.ok()) {
+    return entry.status();
+  }
+  DfaBuilder dfa(nfa.Nodes(), entry.value(), search);
+  auto status = dfa.Build(*matcher);
+  if (!status.ok()) {
+    return status;
+  }
+  return matcher;
+}
+
+absl::StatusOr<std::unique_ptr<StringMatcher>> StringMatcher::CompileLike(std::string_view pattern) {
+  std::unique_ptr<StringMatcher> matcher(new StringMatcher);
+  if (pattern.find_first_of("_\\") == std::string_view::npos) {
+    matcher->anchor_begin_ = pattern.empty() || pattern.front() != '%';
+    matcher->anchor_end_ = pattern.empty() || pattern.back() != '%';
+    size_t begin = 0;
+    while (begin <= pattern.size()) {
+      size_t end = std::min(pattern.find('%', begin), pattern.size());
+      if (end > begin) {
+        matcher->segments_.emplace_back(pattern.substr(begin, end - begin));
+      }
+      begin = end + 1;
+    }
+    return matcher;
+  }
+  RegexNode root;
+  root.kind = RegexNode::kConcat;
+  root.children.emplace_back(RegexNode::Anchor(RegexNode::kBegin));
+  ByteSet any;
+  any.set();
+  for (size_t i = 0; i < pattern.size(); i++) {
+    char c = pattern[i];
+    if (c == '%') {
+      root.children.emplace_back(RegexNode::Repeat(RegexNode::Bytes(any), 0, -1));
+    } else if (c == '_') {
+      root.children.emplace_back(RegexNode::Bytes(any));
+    } else {
+      if (c == '\\' && i + 1 < pattern.size()) {
+        c = pattern[++i];
+      }
+      root.children.emplace_back(RegexNode::Byte(static_cast<uint8_t>(c)));
+    }
+  }
+  root.children.emplace_back(RegexNode::Anchor(RegexNode::kEnd));
+  return build_dfa_matcher(root, false, std::move(matcher));
+}
+
+absl::StatusOr<std::unique_ptr<StringMatcher>> StringMatcher::CompileRegex(std::string_view pattern) {
+  std::unique_ptr<StringMatcher> matcher(new StringMatcher);
+  std::string_view literal = pattern;
+  bool anchor_begin = false;
+  bool anchor_end = false;
+  if (!literal.empty() && literal.front() == '^') {
+    anchor_begin = true;
+    literal.remove_prefix(1);
+  }
+  if (!literal.empty() && literal.back() == '$') {
+    anchor_end = true;
+    literal.remove_suffix(1);
+  }
+  if (literal.find_first_of("\\^$.|?*+()[]{}") == std::string_view::npos) {
+    matcher->anchor_begin_ = anchor_begin;
+    matcher->anchor_end_ = anchor_end;
+    if (!literal.empty()) {
+      matcher->segments_.emplace_back(literal);
+    }
+    return matcher;
+  }
+  RegexParser parser(pattern);
+  auto root = parser.Parse();
+  if (!root.ok()) {
+    return root.status();
+  }
+  return build_dfa_matcher(root.value(), true, std::move(matcher));
+}
+
+bool StringMatcher::MatchSegments(std::string_view s) const {
+  if (segments_.empty()) {
+    return !(anchor_begin_ && anchor_end_) || s.empty();
+  }
+  if (anchor_begin_ && anchor_end_ && segments_.size() == 1) {
+    return s == segments_[0];
+  }
+  size_t first = 0;
+  size_t last = segments_.size();
+  size_t begin = 0;
+  size_t end = s.size();
+  if (anchor_begin_) {
+    const std::string& prefix = segments_.front();
+    if (s.size() < prefix.size() || memcmp(s.data(), prefix.data(), prefix.size()) != 0) {
+      return false;
+    }
+    begin = prefix.size();
+    first++;
+  }
+  if (anchor_end_) {
+    const std::string& suffix = segments_.back();
+    if (s.size() - begin < suffix.size() ||
+        memcmp(s.data() + s.size() - suffix.size(), suffix.data(), suffix.size()) != 0) {
+      return false;
+    }
+    end = s.size() - suffix.size();
+    last--;
+  }
+  // greedy leftmost search is enough for segments only separated by `%`
+  for (size_t i = first; i < last; i++) {
+    int pos = simd_string_find_string(s.substr(begin, end - begin), segments_[i]);
+    if (pos < 0) {
+      return false;
+    }
+    begin += pos + segments_[i].size();
+  }
+  return true;
+}
+
+bool StringMatcher::MatchDfa(std::string_view s) const {
+  const uint32_t* transitions = transitions_.data();
+  const uint8_t* accept_now = accept_now_.data();
+  uint32_t state = start_;
+  for (size_t i = 0; i < s.size(); i++) {
+    if (accept_now[state]) {
+      return true;
+    }
+    state = transitions[state * num_classes_ + byte_classes_[static_cast<uint8_t>(s[i])]];
+    if (state == 0) {
+      return false;
+    }
+  }
+  return accept_end_[state];
+}
+
+bool StringMatcher::Match(std::string_view s) const { return use_dfa_ ? MatchDfa(s) : MatchSegments(s); }
+
+static const StringMatcher* get_string_matcher(StringView pattern, bool like) {
+  thread_local absl::flat_hash_map<std::string, std::unique_ptr<StringMatcher>> like_matchers;
+  thread_local absl::flat_hash_map<std::string, std::unique_ptr<StringMatcher>> regex_matchers;
+  auto& matchers = like ? like_matchers : regex_matchers;
+  std::string_view key(pattern);
+  auto found = matchers.find(pattern.get_absl_string_view());
+  if (found != matchers.end()) {
+    return found->second.get();
+  }
+  auto result = like ? StringMatcher::CompileLike(key) : StringMatcher::CompileRegex(key);
+  if (!result.ok()) {
+    RAISE_LOGIC_ERR(nullptr, "{}", result.status().ToString());
+  }
+  if (matchers.size() >= kMaxCachedPatterns) {
+    matchers.clear();
+  }
+  auto [it, _] = matchers.emplace(std::string(key), std::move(result.value()));
+  return it->second.get();
+}
+
+static Vector<Bit> match_strings(Context& ctx, Vector<StringView> strs, const StringMatcher& matcher) {
+  VectorBuf vdata = ctx.NewVectorBuf<Bit>(strs.Size());
+  uint8_t* bits = vdata.MutableData<uint8_t>();
+  // arena bits buffer is 8 bytes aligned, fill 64 results per store.
+  for (size_t i = 0; i < strs.Size(); i += 64) {
+    size_t n = std::min<size_t>(64, strs.Size() - i);
+    uint64_t word = 0;
+    for (size_t j = 0; j < n; j++) {
+      StringView str = strs[i + j];
+      word |= static_cast<uint64_t>(matcher.Match(std::string_view(str))) << j;
+    }
+    memcpy(bits + i / 8, &word, sizeof(word));
+  }
+  return Vector<Bit>(vdata);
+}
+
+bool string_like(StringView s, StringView pattern) {
+  auto* matcher = get_string_matcher(pattern, true);
+  return matcher != nullptr && matcher->Match(std::string_view(s));
+}
+bool string_regex_match(StringView s, StringView pattern) {
+  auto* matcher = get_string_matcher(pattern, false);
+  return matcher != nullptr && matcher->Match(std::string_view(s));
+}
+
+Vector<Bit> simd_vector_like(Context& ctx, Vector<StringView> strs, StringView pattern) {
+  auto* matcher = get_string_matcher(pattern, true);
+  if (matcher == nullptr) {
+    return {};
+  }
+  return match_strings(ctx, strs, *matcher);
+}
+Vector<Bit> simd_vector_regex_match(Context& ctx, Vector<StringView> strs, StringView pattern) {
+  auto* matcher = get_string_matcher(pattern, false);
+  if (matcher == nullptr) {
+    return {};
+  }
+  return match_strings(ctx, strs, *matcher);
+}
+
+}  // namespace functions
+}  // namespace rapidudf
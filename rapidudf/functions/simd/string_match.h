@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "rapidudf/context/context.h"
+#include "rapidudf/types/bit.h"
+#include "rapidudf/types/string_view.h"
+#include "rapidudf/types/vector.h"
+namespace rapidudf {
+namespace functions {
+
+/**
+** A compiled LIKE/regex pattern.
+** Patterns only made of literals and `%` are matched by (simd) substring search, others are compiled into a byte
+** oriented DFA, so `_`/`.` match a single byte.
+*/
+class StringMatcher {
+ public:
+  /**
+  ** SQL LIKE, `%` matches any sequence, `_` matches any byte, `\` escapes the next char, the whole string must match.
+  */
+  static absl::StatusOr<std::unique_ptr<StringMatcher>> CompileLike(std::string_view pattern);
+  /**
+  ** RE2 like syntax subset: literals, `.`, `[]` classes, `\d\w\s`, groups, `|`, `*+?{m,n}`, `^$` anchors.
+  ** Matches if any substring matches the pattern, like `RE2::PartialMatch`.
+  */
+  static absl::StatusOr<std::unique_ptr<StringMatcher>> CompileRegex(std::string_view pattern);
+
+  bool Match(std::string_view s) const;
+
+  size_t DfaStateCount() const { return accept_now_.size(); }
+
+ private:
+  friend struct DfaBuilder;
+  StringMatcher() = default;
+
+  bool MatchSegments(std::string_view s) const;
+  bool MatchDfa(std::string_view s) const;
+
+  bool use_dfa_ = false;
+
+  // literal segments separated by `%`, anchored at begin/end if the pattern not starts/ends with `%`
+  std::vector<std::string> segments_;
+  bool anchor_begin_ = false;
+  bool anchor_end_ = false;
+
+  // dfa state `s` is at transitions_[s * num_classes_], transitions store the next state row offset, state 0 is dead.
+  std::array<uint8_t, 256> byte_classes_;
+  uint32_t num_classes_ = 0;
+  uint32_t start_ = 0;
+  std::vector<uint32_t> transitions_;
+  std::vector<uint8_t> accept_now_;
+  std::vector<uint8_t> accept_end_;
+};
+
+bool string_like(StringView s, StringView pattern);
+bool string_regex_match(StringView s, StringView pattern);
+
+/**
+** patterns are compiled once and cached per thread, invalid patterns throw std::logic_error.
+*/
+Vector<Bit> simd_vector_like(Context& ctx, Vector<StringView> strs, StringView pattern);
+Vector<Bit> simd_vector_regex_match(Context& ctx, Vector<StringView> strs, StringView pattern);
+
+}  // namespace functions
+}  // namespace rapidudf
@@ -16,9 +16,14 @@
 
 #pragma once
 #include "rapidudf/context/context.h"
+#include "rapidudf/functions/simd/vector_convert.h"
+#include "rapidudf/functions/simd/vector_hash.h"
 #include "rapidudf/functions/simd/vector_misc.h"
 #include "rapidudf/functions/simd/vector_op.h"
+#include "rapidudf/functions/simd/vector_random.h"
 #include "rapidudf/functions/simd/vector_sort.h"
+#include "rapidudf/functions/simd/vector_time.h"
+#include "rapidudf/functions/simd/vector_window.h"
 #include "rapidudf/meta/optype.h"
 #include "rapidudf/types/vector.h"
 namespace rapidudf {
@@ -31,5 +36,15 @@ void simd_vector_binary_op(const T* left, const T* right, T* output);
 template <typename T, OpToken op>
 void simd_vector_ternary_op(const T* a, const T* b, const T* c, T* output);
 
+/**
+** Kernels of the chosen simd target with same signatures as above, jit code calls them directly per vector block.
+*/
+template <typename T, OpToken op>
+void* resolve_simd_vector_unary_op();
+template <typename T, OpToken op>
+void* resolve_simd_vector_binary_op();
+template <typename T, OpToken op>
+void* resolve_simd_vector_ternary_op();
+
 }  // namespace functions
 }  // namespace rapidudf
\ No newline at end of file
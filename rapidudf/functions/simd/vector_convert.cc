@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <boost/preprocessor/library.hpp>
+#include <boost/preprocessor/seq/for_each.hpp>
+#include <boost/preprocessor/stringize.hpp>
+#include <boost/preprocessor/variadic/to_seq.hpp>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#include "rapidudf/context/context.h"
+#include "rapidudf/functions/simd/vector_convert.h"
+#include "rapidudf/log/log.h"
+#include "rapidudf/meta/exception.h"
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "rapidudf/functions/simd/vector_convert.cc"  // this file
+
+#include "hwy/foreach_target.h"  // must come before highway.h
+
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace rapidudf {
+namespace functions {
+
+namespace HWY_NAMESPACE {
+namespace hn = hwy::HWY_NAMESPACE;
+
+template <typename T>
+HWY_INLINE void simd_vector_to_f32_impl(const T* in, float* out, size_t n) {
+  const hn::ScalableTag<float> d;
+  const size_t N = hn::Lanes(d);
+  size_t i = 0;
+  if constexpr (std::is_same_v<T, Float16>) {
+    const hn::Rebind<hwy::float16_t, decltype(d)> dh;
+    const hwy::float16_t* src = reinterpret_cast<const hwy::float16_t*>(in);
+    for (; i + N <= n; i += N) {
+      hn::StoreU(hn::PromoteTo(d, hn::LoadU(dh, src + i)), d, out + i);
+    }
+  } else {
+    // bf16 is the upper half of f32
+    const hn::RebindToUnsigned<decltype(d)> du;
+    const hn::Rebind<uint16_t, decltype(d)> du16;
+    const uint16_t* src = reinterpret_cast<const uint16_t*>(in);
+    for (; i + N <= n; i += N) {
+      auto bits = hn::ShiftLeft<16>(hn::PromoteTo(du, hn::LoadU(du16, src + i)));
+      hn::StoreU(hn::BitCast(d, bits), d, out + i);
+    }
+  }
+  for (; i < n; i++) {
+    out[i] = static_cast<float>(in[i]);
+  }
+}
+
+HWY_INLINE void simd_vector_to_f16_impl(const float* in, Float16* out, size_t n) {
+  const hn::ScalableTag<float> d;
+  const hn::Rebind<hwy::float16_t, decltype(d)> dh;
+  hwy::float16_t* dst = reinterpret_cast<hwy::float16_t*>(out);
+  const size_t N = hn::Lanes(d);
+  size_t i = 0;
+  for (; i + N <= n; i += N) {
+    hn::StoreU(hn::DemoteTo(dh, hn::LoadU(d, in + i)), dh, dst + i);
+  }
+  for (; i < n; i++) {
+    out[i] = Float16(in[i]);
+  }
+}
+
+// same rounding as `BFloat16::FromFloat`, not all targets' native demotion round to nearest even.
+HWY_INLINE void simd_vector_to_bf16_impl(const float* in, BFloat16* out, size_t n) {
+  const hn::ScalableTag<float> d;
+  const hn::RebindToUnsigned<decltype(d)> du;
+  const hn::Rebind<uint16_t, decltype(d)> du16;
+  uint16_t* dst = reinterpret_cast<uint16_t*>(out);
+  const size_t N = hn::Lanes(d);
+  const auto one = hn::Set(du, 1);
+  const auto bias = hn::Set(du, 0x7fff);
+  const auto quiet = hn::Set(du, 0x40);
+  size_t i = 0;
+  for (; i + N <= n; i += N) {
+    auto v = hn::LoadU(d, in + i);
+    auto bits = hn::BitCast(du, v);
+    auto rounded = hn::ShiftRight<16>(hn::Add(hn::Add(bits, bias), hn::And(hn::ShiftRight<16>(bits), one)));
+    auto nan = hn::Or(hn::ShiftRight<16>(bits), quiet);
+    auto result = hn::IfThenElse(hn::RebindMask(du, hn::IsNaN(v)), nan, rounded);
+    hn::StoreU(hn::DemoteTo(du16, result), du16, dst + i);
+  }
+  for (; i < n; i++) {
+    out[i] = BFloat16(in[i]);
+  }
+}
+
+HWY_INLINE void simd_vector_quantize_impl(const float* in, float scale, int8_t* out, size_t n) {
+  const hn::ScalableTag<float> d;
+  const hn::Rebind<int8_t, decltype(d)> di8;
+  const size_t N = hn::Lanes(d);
+  const float inv_scale = 1.0f / scale;
+  const auto inv = hn::Set(d, inv_scale);
+  const auto lo = hn::Set(d, -128.0f);
+  const auto hi = hn::Set(d, 127.0f);
+  size_t i = 0;
+  for (; i + N <= n; i += N) {
+    auto v = hn::Mul(hn::LoadU(d, in + i), inv);
+    v = hn::IfThenZeroElse(hn::IsNaN(v), v);
+    v = hn::Min(hn::Max(v, lo), hi);
+    hn::StoreU(hn::DemoteTo(di8, hn::NearestInt(v)), di8, out + i);
+  }
+  for (; i < n; i++) {
+    float v = in[i] * inv_scale;
+    v = std::isnan(v) ? 0.0f : std::min(std::max(v, -128.0f), 127.0f);
+    out[i] = static_cast<int8_t>(std::nearbyint(v));
+  }
+}
+
+HWY_INLINE void simd_vector_dequantize_impl(const int8_t* in, float scale, float* out, size_t n) {
+  const hn::ScalableTag<float> d;
+  const hn::RebindToSigned<decltype(d)> di;
+  const hn::Rebind<int8_t, decltype(d)> di8;
+  const size_t N = hn::Lanes(d);
+  const auto s = hn::Set(d, scale);
+  size_t i = 0;
+  for (; i + N <= n; i += N) {
+    auto v = hn::ConvertTo(d, hn::PromoteTo(di, hn::LoadU(di8, in + i)));
+    hn::StoreU(hn::Mul(v, s), d, out + i);
+  }
+  for (; i < n; i++) {
+    out[i] = static_cast<float>(in[i]) * scale;
+  }
+}
+
+}  // namespace HWY_NAMESPACE
+}  // namespace functions
+}  // namespace rapidudf
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace rapidudf {
+namespace functions {
+template <typename T>
+static Vector<T> new_convert_output(Context& ctx, size_t n, T*& out) {
+  VectorBuf vdata = ctx.NewVectorBuf<T>(n);
+  out = vdata.MutableData<T>();
+  return Vector<T>(vdata);
+}
+
+template <typename T>
+Vector<float> simd_vector_to_f32(Context& ctx, Vector<T> data) {
+  float* out = nullptr;
+  auto result = new_convert_output<float>(ctx, data.Size(), out);
+  HWY_EXPORT_T(Table, simd_vector_to_f32_impl<T>);
+  HWY_DYNAMIC_DISPATCH_T(Table)(data.Data(), out, data.Size());
+  return result;
+}
+
+Vector<Float16> simd_vector_to_f16(Context& ctx, Vector<float> data) {
+  Float16* out = nullptr;
+  auto result = new_convert_output<Float16>(ctx, data.Size(), out);
+  HWY_EXPORT_T(Table, simd_vector_to_f16_impl);
+  HWY_DYNAMIC_DISPATCH_T(Table)(data.Data(), out, data.Size());
+  return result;
+}
+
+Vector<BFloat16> simd_vector_to_bf16(Context& ctx, Vector<float> data) {
+  BFloat16* out = nullptr;
+  auto result = new_convert_output<BFloat16>(ctx, data.Size(), out);
+  HWY_EXPORT_T(Table, simd_vector_to_bf16_impl);
+  HWY_DYNAMIC_DISPATCH_T(Table)(data.Data(), out, data.Size());
+  return result;
+}
+
+Vector<int8_t> simd_vector_quantize(Context& ctx, Vector<float> data, float scale) {
+  if (!(scale > 0)) {
+    RAISE_LOGIC_ERR({}, "quantize scale must be greater than 0");
+  }
+  int8_t* out = nullptr;
+  auto result = new_convert_output<int8_t>(ctx, data.Size(), out);
+  HWY_EXPORT_T(Table, simd_vector_quantize_impl);
+  HWY_DYNAMIC_DISPATCH_T(Table)(data.Data(), scale, out, data.Size());
+  return result;
+}
+
+Vector<float> simd_vector_dequantize(Context& ctx, Vector<int8_t> data, float scale) {
+  float* out = nullptr;
+  auto result = new_convert_output<float>(ctx, data.Size(), out);
+  HWY_EXPORT_T(Table, simd_vector_dequantize_impl);
+  HWY_DYNAMIC_DISPATCH_T(Table)(data.Data(), scale, out, data.Size());
+  return result;
+}
+
+#define DEFINE_SIMD_TO_F32_OP_TEMPLATE(r, op, ii, TYPE) \
+  template Vector<float> simd_vector_to_f32(Context&, Vector<TYPE>);
+#define DEFINE_SIMD_TO_F32_OP(...) \
+  BOOST_PP_SEQ_FOR_EACH_I(DEFINE_SIMD_TO_F32_OP_TEMPLATE, op, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
+DEFINE_SIMD_TO_F32_OP(Float16, BFloat16);
+
+}  // namespace functions
+}  // namespace rapidudf
+#endif  // HWY_ONCE
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "rapidudf/context/context.h"
+#include "rapidudf/types/float16.h"
+#include "rapidudf/types/vector.h"
+namespace rapidudf {
+namespace functions {
+/**
+** widen f16/bf16 storage vector to f32.
+*/
+template <typename T>
+Vector<float> simd_vector_to_f32(Context& ctx, Vector<T> data);
+/**
+** narrow f32 vector to f16/bf16 storage vector, round to nearest even.
+*/
+Vector<Float16> simd_vector_to_f16(Context& ctx, Vector<float> data);
+Vector<BFloat16> simd_vector_to_bf16(Context& ctx, Vector<float> data);
+
+/**
+** symmetric int8 quantization: `clamp(round(v / scale), -128, 127)`, `scale` must be greater than 0.
+*/
+Vector<int8_t> simd_vector_quantize(Context& ctx, Vector<float> data, float scale);
+/**
+** `q * scale` of every int8 value.
+*/
+Vector<float> simd_vector_dequantize(Context& ctx, Vector<int8_t> data, float scale);
+}  // namespace functions
+}  // namespace rapidudf
@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <boost/preprocessor/library.hpp>
+#include <boost/preprocessor/seq/for_each.hpp>
+#include <boost/preprocessor/stringize.hpp>
+#include <boost/preprocessor/variadic/to_seq.hpp>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#include "rapidudf/context/context.h"
+#include "rapidudf/functions/simd/vector_hash.h"
+#include "rapidudf/log/log.h"
+#include "rapidudf/meta/exception.h"
+#include "rapidudf/types/string_view.h"
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "rapidudf/functions/simd/vector_hash.cc"  // this file
+
+#include "hwy/foreach_target.h"  // must come before highway.h
+
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace rapidudf {
+namespace functions {
+
+namespace HWY_NAMESPACE {
+namespace hn = hwy::HWY_NAMESPACE;
+
+static constexpr uint64_t kFmixMul1 = 0xff51afd7ed558ccdULL;
+static constexpr uint64_t kFmixMul2 = 0xc4ceb9fe1a85ec53ULL;
+static constexpr uint64_t kCombineMul = 0x9e3779b97f4a7c15ULL;
+
+HWY_INLINE uint64_t fmix64(uint64_t h) {
+  h ^= h >> 33;
+  h *= kFmixMul1;
+  h ^= h >> 33;
+  h *= kFmixMul2;
+  h ^= h >> 33;
+  return h;
+}
+
+template <class D, class V>
+HWY_INLINE V fmix64(D d, V h) {
+  h = hn::Xor(h, hn::ShiftRight<33>(h));
+  h = hn::Mul(h, hn::Set(d, kFmixMul1));
+  h = hn::Xor(h, hn::ShiftRight<33>(h));
+  h = hn::Mul(h, hn::Set(d, kFmixMul2));
+  return hn::Xor(h, hn::ShiftRight<33>(h));
+}
+
+template <typename T>
+using hash_widen_t = std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>;
+
+// load lanes of `T` sign/zero extended to u64 lanes.
+template <typename T, class D>
+HWY_INLINE hn::Vec<D> load_as_u64(D d, const T* p) {
+  if constexpr (sizeof(T) == sizeof(uint64_t)) {
+    return hn::BitCast(d, hn::LoadU(hn::Rebind<T, D>(), p));
+  } else {
+    return hn::BitCast(d, hn::PromoteTo(hn::Rebind<hash_widen_t<T>, D>(), hn::LoadU(hn::Rebind<T, D>(), p)));
+  }
+}
+
+template <typename T>
+HWY_INLINE void simd_vector_hash_impl(const T* in, uint64_t* out, size_t n) {
+  const hn::ScalableTag<uint64_t> d;
+  const size_t N = hn::Lanes(d);
+  size_t i = 0;
+  for (; i + N <= n; i += N) {
+    hn::StoreU(fmix64(d, load_as_u64(d, in + i)), d, out + i);
+  }
+  for (; i < n; i++) {
+    out[i] = fmix64(static_cast<uint64_t>(static_cast<hash_widen_t<T>>(in[i])));
+  }
+}
+
+HWY_INLINE void simd_vector_hash_combine_impl(const uint64_t* a, const uint64_t* b, uint64_t* out, size_t n) {
+  const hn::ScalableTag<uint64_t> d;
+  const size_t N = hn::Lanes(d);
+  const auto mul = hn::Set(d, kCombineMul);
+  size_t i = 0;
+  for (; i + N <= n; i += N) {
+    auto h = hn::Add(hn::Mul(hn::LoadU(d, a + i), mul), hn::LoadU(d, b + i));
+    hn::StoreU(fmix64(d, h), d, out + i);
+  }
+  for (; i < n; i++) {
+    out[i] = fmix64(a[i] * kCombineMul + b[i]);
+  }
+}
+
+/**
+** branchless upper bound, the probe sequence only depends on `m`, so all lanes walk the same steps with gathers.
+*/
+template <typename T>
+HWY_INLINE void simd_vector_bucketize_impl(const T* in, const T* bounds, size_t m, uint32_t* out, size_t n) {
+  if (m == 0) {
+    std::fill(out, out + n, 0);
+    return;
+  }
+  const hn::ScalableTag<T> d;
+  const hn::RebindToSigned<decltype(d)> di;
+  using TI = hn::TFromD<decltype(di)>;
+  const size_t N = hn::Lanes(d);
+  size_t i = 0;
+  for (; i + N <= n; i += N) {
+    const auto x = hn::LoadU(d, in + i);
+    auto idx = hn::Zero(di);
+    for (size_t len = m; len > 1;) {
+      size_t half = len / 2;
+      auto probe = hn::GatherIndex(d, bounds, hn::Add(idx, hn::Set(di, static_cast<TI>(half - 1))));
+      idx = hn::Add(idx, hn::IfThenElseZero(hn::RebindMask(di, hn::Le(probe, x)), hn::Set(di, static_cast<TI>(half))));
+      len -= half;
+    }
+    // mask lanes are all ones(-1) when true
+    auto last = hn::GatherIndex(d, bounds, idx);
+    idx = hn::Sub(idx, hn::VecFromMask(di, hn::RebindMask(di, hn::Le(last, x))));
+    if constexpr (sizeof(T) == sizeof(uint32_t)) {
+      hn::StoreU(hn::BitCast(hn::RebindToUnsigned<decltype(di)>(), idx), hn::RebindToUnsigned<decltype(di)>(),
+                 out + i);
+    } else {
+      const hn::Rebind<int32_t, decltype(di)> d32;
+      hn::StoreU(hn::DemoteTo(d32, idx), d32, reinterpret_cast<int32_t*>(out + i));
+    }
+  }
+  for (; i < n; i++) {
+    size_t idx = 0;
+    for (size_t len = m; len > 1;) {
+      size_t half = len / 2;
+      idx += bounds[idx + half - 1] <= in[i] ? half : 0;
+      len -= half;
+    }
+    out[i] = static_cast<uint32_t>(idx + (bounds[idx] <= in[i] ? 1 : 0));
+  }
+}
+
+}  // namespace HWY_NAMESPACE
+}  // namespace functions
+}  // namespace rapidudf
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace rapidudf {
+namespace functions {
+static constexpr uint64_t kXXPrime1 = 0x9E3779B185EBCA87ULL;
+static constexpr uint64_t kXXPrime2 = 0xC2B2AE3D27D4EB4FULL;
+static constexpr uint64_t kXXPrime3 = 0x165667B19E3779F9ULL;
+static constexpr uint64_t kXXPrime4 = 0x85EBCA77C2B2AE63ULL;
+static constexpr uint64_t kXXPrime5 = 0x27D4EB2F165667C5ULL;
+
+static inline uint64_t rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+static inline uint64_t read64(const uint8_t* p) {
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+static inline uint32_t read32(const uint8_t* p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+static inline uint64_t xxh64_round(uint64_t acc, uint64_t input) {
+  acc += input * kXXPrime2;
+  acc = rotl64(acc, 31);
+  return acc * kXXPrime1;
+}
+static inline uint64_t xxh64_merge_round(uint64_t acc, uint64_t val) {
+  acc ^= xxh64_round(0, val);
+  return acc * kXXPrime1 + kXXPrime4;
+}
+
+uint64_t xxhash64(const void* data, size_t len, uint64_t seed) {
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+  const uint8_t* end = p + len;
+  uint64_t h = 0;
+  if (len >= 32) {
+    uint64_t v1 = seed + kXXPrime1 + kXXPrime2;
+    uint64_t v2 = seed + kXXPrime2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - kXXPrime1;
+    const uint8_t* limit = end - 32;
+    do {
+      v1 = xxh64_round(v1, read64(p));
+      v2 = xxh64_round(v2, read64(p + 8));
+      v3 = xxh64_round(v3, read64(p + 16));
+      v4 = xxh64_round(v4, read64(p + 24));
+      p += 32;
+    } while (p <= limit);
+    h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+    h = xxh64_merge_round(h, v1);
+    h = xxh64_merge_round(h, v2);
+    h = xxh64_merge_round(h, v3);
+    h = xxh64_merge_round(h, v4);
+  } else {
+    h = seed + kXXPrime5;
+  }
+  h += static_cast<uint64_t>(len);
+  for (; p + 8 <= end; p += 8) {
+    h ^= xxh64_round(0, read64(p));
+    h = rotl64(h, 27) * kXXPrime1 + kXXPrime4;
+  }
+  if (p + 4 <= end) {
+    h ^= static_cast<uint64_t>(read32(p)) * kXXPrime1;
+    h = rotl64(h, 23) * kXXPrime2 + kXXPrime3;
+    p += 4;
+  }
+  for (; p < end; p++) {
+    h ^= (*p) * kXXPrime5;
+    h = rotl64(h, 11) * kXXPrime1;
+  }
+  h ^= h >> 33;
+  h *= kXXPrime2;
+  h ^= h >> 29;
+  h *= kXXPrime3;
+  h ^= h >> 32;
+  return h;
+}
+
+template <typename T>
+static Vector<T> new_hash_output(Context& ctx, size_t n, T*& out) {
+  VectorBuf vdata = ctx.NewVectorBuf<T>(n);
+  out = vdata.MutableData<T>();
+  return Vector<T>(vdata);
+}
+
+template <typename T>
+Vector<uint64_t> simd_vector_hash(Context& ctx, Vector<T> data) {
+  uint64_t* out = nullptr;
+  auto result = new_hash_output<uint64_t>(ctx, data.Size(), out);
+  if constexpr (std::is_same_v<T, StringView>) {
+    for (size_t i = 0; i < data.Size(); i++) {
+      StringView s = data[i];
+      out[i] = xxhash64(s.data(), s.size());
+    }
+  } else {
+    HWY_EXPORT_T(Table, simd_vector_hash_impl<T>);
+    HWY_DYNAMIC_DISPATCH_T(Table)(data.Data(), out, data.Size());
+  }
+  return result;
+}
+
+Vector<uint64_t> simd_vector_hash_combine(Context& ctx, Vector<uint64_t> a, Vector<uint64_t> b) {
+  if (a.Size() != b.Size()) {
+    RAISE_SIZE_MISMATCH_ERR({}, b.Size(), a.Size());
+  }
+  uint64_t* out = nullptr;
+  auto result = new_hash_output<uint64_t>(ctx, a.Size(), out);
+  HWY_EXPORT_T(Table, simd_vector_hash_combine_impl);
+  HWY_DYNAMIC_DISPATCH_T(Table)(a.Data(), b.Data(), out, a.Size());
+  return result;
+}
+
+template <typename T>
+Vector<uint32_t> simd_vector_bucketize(Context& ctx, Vector<T> data, Vector<T> boundaries) {
+  if (!std::is_sorted(boundaries.Data(), boundaries.Data() + boundaries.Size())) {
+    RAISE_LOGIC_ERR({}, "bucketize boundaries must be sorted ascending");
+  }
+  uint32_t* out = nullptr;
+  auto result = new_hash_output<uint32_t>(ctx, data.Size(), out);
+  HWY_EXPORT_T(Table, simd_vector_bucketize_impl<T>);
+  HWY_DYNAMIC_DISPATCH_T(Table)(data.Data(), boundaries.Data(), boundaries.Size(), out, data.Size());
+  return result;
+}
+
+// remainder by direct computation(Lemire et al.), exact for 64bit numerators and 32bit divisors.
+static inline uint32_t fastmod_u64(uint64_t a, __uint128_t m, uint32_t d) {
+  __uint128_t lowbits = m * a;
+  __uint128_t bottom = ((lowbits & UINT64_MAX) * d) >> 64;
+  __uint128_t top = (lowbits >> 64) * d;
+  return static_cast<uint32_t>((bottom + top) >> 64);
+}
+
+Vector<uint32_t> simd_vector_mod_bucket(Context& ctx, Vector<uint64_t> hashes, uint32_t buckets) {
+  if (buckets == 0) {
+    RAISE_LOGIC_ERR({}, "mod_bucket buckets must be greater than 0");
+  }
+  uint32_t* out = nullptr;
+  auto result = new_hash_output<uint32_t>(ctx, hashes.Size(), out);
+  const uint64_t* in = hashes.Data();
+  if ((buckets & (buckets - 1)) == 0) {
+    uint64_t mask = buckets - 1;
+    for (size_t i = 0; i < hashes.Size(); i++) {
+      out[i] = static_cast<uint32_t>(in[i] & mask);
+    }
+  } else {
+    __uint128_t m = ~static_cast<__uint128_t>(0) / buckets + 1;
+    for (size_t i = 0; i < hashes.Size(); i++) {
+      out[i] = fastmod_u64(in[i], m, buckets);
+    }
+  }
+  return result;
+}
+
+#define DEFINE_SIMD_HASH_OP_TEMPLATE(r, op, ii, TYPE) \
+  template Vector<uint64_t> simd_vector_hash(Context&, Vector<TYPE>);
+#define DEFINE_SIMD_HASH_OP(...) \
+  BOOST_PP_SEQ_FOR_EACH_I(DEFINE_SIMD_HASH_OP_TEMPLATE, op, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
+DEFINE_SIMD_HASH_OP(uint64_t, int64_t, uint32_t, int32_t, StringView);
+
+#define DEFINE_SIMD_BUCKETIZE_OP_TEMPLATE(r, op, ii, TYPE) \
+  template Vector<uint32_t> simd_vector_bucketize(Context&, Vector<TYPE>, Vector<TYPE>);
+#define DEFINE_SIMD_BUCKETIZE_OP(...) \
+  BOOST_PP_SEQ_FOR_EACH_I(DEFINE_SIMD_BUCKETIZE_OP_TEMPLATE, op, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
+DEFINE_SIMD_BUCKETIZE_OP(float, double, uint64_t, int64_t, uint32_t, int32_t);
+
+}  // namespace functions
+}  // namespace rapidudf
+#endif  // HWY_ONCE
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "rapidudf/context/context.h"
+#include "rapidudf/types/string_view.h"
+#include "rapidudf/types/vector.h"
+namespace rapidudf {
+namespace functions {
+/**
+** xxhash64 of `len` bytes.
+*/
+uint64_t xxhash64(const void* data, size_t len, uint64_t seed = 0);
+
+/**
+** hash values are stable across processes: integers are sign extended to 64bit and mixed by murmur3 fmix64,
+** strings are hashed by xxhash64.
+*/
+template <typename T>
+Vector<uint64_t> simd_vector_hash(Context& ctx, Vector<T> data);
+/**
+** hash of every (a, b) pair, used to cross two hashed feature columns.
+*/
+Vector<uint64_t> simd_vector_hash_combine(Context& ctx, Vector<uint64_t> a, Vector<uint64_t> b);
+
+/**
+** bucket index of every value, which is the count of `boundaries` not greater than the value,
+** `boundaries` must be sorted ascending.
+*/
+template <typename T>
+Vector<uint32_t> simd_vector_bucketize(Context& ctx, Vector<T> data, Vector<T> boundaries);
+/**
+** `hash % buckets` of every value.
+*/
+Vector<uint32_t> simd_vector_mod_bucket(Context& ctx, Vector<uint64_t> hashes, uint32_t buckets);
+}  // namespace functions
+}  // namespace rapidudf
@@ -49,7 +49,7 @@ namespace hn = hwy::HWY_NAMESPACE;
 template <typename T>
 HWY_INLINE T simd_vector_dot_impl(Vector<T> left, Vector<T> right) {
   if (left.Size() != right.Size()) {
-    THROW_LOGIC_ERR(fmt::format("vector dot size mismatch {}:{}", left.Size(), right.Size()));
+    RAISE_LOGIC_ERR(T{}, "vector dot size mismatch {}:{}", left.Size(), right.Size());
   }
   using D = hn::ScalableTag<T>;
   constexpr D d;
@@ -68,7 +68,7 @@ HWY_INLINE T simd_vector_dot_impl(Vector<T> left, Vector<T> right) {
 template <typename T>
 HWY_INLINE T simd_vector_cos_distance_impl(Vector<T> left, Vector<T> right) {
   if (left.Size() != right.Size()) {
-    THROW_LOGIC_ERR(fmt::format("vector dot size mismatch {}:{}", left.Size(), right.Size()));
+    RAISE_LOGIC_ERR(T{}, "vector dot size mismatch {}:{}", left.Size(), right.Size());
   }
   using D = hn::ScalableTag<T>;
   constexpr D d;
@@ -107,7 +107,7 @@ HWY_INLINE T simd_vector_cos_distance_impl(Vector<T> left, Vector<T> right) {
 template <typename T>
 HWY_INLINE T simd_vector_l2_distance_impl(Vector<T> left, Vector<T> right) {
   if (left.Size() != right.Size()) {
-    THROW_LOGIC_ERR(fmt::format("vector dot size mismatch {}:{}", left.Size(), right.Size()));
+    RAISE_LOGIC_ERR(T{}, "vector dot size mismatch {}:{}", left.Size(), right.Size());
   }
   using D = hn::ScalableTag<T>;
   constexpr D d;
@@ -361,6 +361,36 @@ HWY_INLINE size_t simd_vector_filter_impl(const T* in, const uint8_t* bits, T* o
   }
 }
 
+template <typename T>
+HWY_INLINE size_t simd_vector_histogram_impl(Vector<T> ids, uint32_t buckets, uint32_t* counts) {
+  // lane compares against every bucket only pay off for a few buckets
+  constexpr uint32_t kMaxCompareBuckets = 8;
+  memset(counts, 0, sizeof(uint32_t) * buckets);
+  const T* in = ids.Data();
+  size_t n = ids.Size();
+  size_t i = 0;
+  if (buckets <= kMaxCompareBuckets) {
+    const hn::ScalableTag<T> d;
+    const size_t lanes = hn::Lanes(d);
+    for (; i + lanes <= n; i += lanes) {
+      auto v = hn::LoadU(d, in + i);
+      for (uint32_t b = 0; b < buckets; b++) {
+        counts[b] += static_cast<uint32_t>(hn::CountTrue(d, hn::Eq(v, hn::Set(d, static_cast<T>(b)))));
+      }
+    }
+  }
+  for (; i < n; i++) {
+    if (in[i] < buckets) {
+      counts[in[i]]++;
+    }
+  }
+  size_t total = 0;
+  for (uint32_t b = 0; b < buckets; b++) {
+    total += counts[b];
+  }
+  return n - total;
+}
+
 }  // namespace HWY_NAMESPACE
 }  // namespace functions
 }  // namespace rapidudf
@@ -399,6 +429,12 @@ T simd_vector_l2_distance(Vector<T> left, Vector<T> right) {
   return HWY_DYNAMIC_DISPATCH_T(Table)(left, right);
 }
 
+template <typename T>
+size_t simd_vector_histogram(Vector<T> ids, uint32_t buckets, uint32_t* counts) {
+  HWY_EXPORT_T(Table, simd_vector_histogram_impl<T>);
+  return HWY_DYNAMIC_DISPATCH_T(Table)(ids, buckets, counts);
+}
+
 template <typename T>
 T simd_vector_avg(Vector<T> left) {
   T sum = simd_vector_sum(left);
@@ -612,6 +648,8 @@ DEFINE_SIMD_RANDOM_OP(uint64_t, double);
   BOOST_PP_SEQ_FOR_EACH_I(DEFINE_RANDOM_OP_TEMPLATE, op, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
 DEFINE_RANDOM_OP(uint64_t, double);
 
+template size_t simd_vector_histogram(Vector<uint32_t> ids, uint32_t buckets, uint32_t* counts);
+
 }  // namespace functions
 }  // namespace rapidudf
 #endif  // HWY_ONCE
\ No newline at end of file
@@ -48,6 +48,12 @@ Vector<T> simd_vector_filter(Context& ctx, Vector<T> data, Vector<Bit> bits);
 template <typename T, OpToken op = OP_EQUAL>
 int simd_vector_find(Vector<T> data, T v);
 
+/**
+** Count every id in [0, buckets) into `counts[id]`, returns the number of ids out of range.
+*/
+template <typename T>
+size_t simd_vector_histogram(Vector<T> ids, uint32_t buckets, uint32_t* counts);
+
 template <typename T>
 void simd_vector_random(Context& ctx, uint64_t seed, T* output);
 
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+#include "rapidudf/context/context.h"
+#include "rapidudf/functions/simd/vector_random.h"
+#include "rapidudf/types/vector.h"
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "rapidudf/functions/simd/vector_random.cc"  // this file
+
+#include "hwy/foreach_target.h"  // must come before highway.h
+
+#include "hwy/contrib/math/math-inl.h"
+#include "hwy/highway.h"
+
+// shared by all targets & the dispatch code, defined once since this file is included once per target.
+#ifndef RAPIDUDF_FUNCTIONS_SIMD_VECTOR_RANDOM_ONCE
+#define RAPIDUDF_FUNCTIONS_SIMD_VECTOR_RANDOM_ONCE
+namespace rapidudf {
+namespace functions {
+enum RandomDist {
+  kRandomU64 = 0,
+  kRandomUniform,
+  kRandomNormal,
+};
+template <RandomDist dist>
+using random_out_t = std::conditional_t<dist == kRandomU64, uint64_t, double>;
+}  // namespace functions
+}  // namespace rapidudf
+#endif  // RAPIDUDF_FUNCTIONS_SIMD_VECTOR_RANDOM_ONCE
+
+HWY_BEFORE_NAMESPACE();
+namespace rapidudf {
+namespace functions {
+namespace HWY_NAMESPACE {
+namespace hn = hwy::HWY_NAMESPACE;
+
+static constexpr uint64_t kPhiloxM0 = 0xD2511F53;
+static constexpr uint64_t kPhiloxM1 = 0xCD9E8D57;
+static constexpr uint32_t kPhiloxW0 = 0x9E3779B9;
+static constexpr uint32_t kPhiloxW1 = 0xBB67AE85;
+static constexpr int kPhiloxRounds = 10;
+static constexpr double kTwoPi = 6.283185307179586;
+
+/**
+** every u64 lane holds one 32bit word, so the 32x32->64 products of a round are plain 64bit multiplies.
+*/
+template <class D>
+HWY_INLINE void philox4x32(D d, hn::Vec<D>& c0, hn::Vec<D>& c1, hn::Vec<D>& c2, hn::Vec<D>& c3, uint64_t seed) {
+  const auto lo_mask = hn::Set(d, 0xFFFFFFFFULL);
+  const auto m0 = hn::Set(d, kPhiloxM0);
+  const auto m1 = hn::Set(d, kPhiloxM1);
+  uint32_t k0 = static_cast<uint32_t>(seed);
+  uint32_t k1 = static_cast<uint32_t>(seed >> 32);
+  for (int round = 0; round < kPhiloxRounds; round++) {
+    auto p0 = hn::Mul(c0, m0);
+    auto p1 = hn::Mul(c2, m1);
+    c0 = hn::Xor(hn::Xor(hn::ShiftRight<32>(p1), c1), hn::Set(d, k0));
+    c2 = hn::Xor(hn::Xor(hn::ShiftRight<32>(p0), c3), hn::Set(d, k1));
+    c1 = hn::And(p1, lo_mask);
+    c3 = hn::And(p0, lo_mask);
+    k0 += kPhiloxW0;
+    k1 += kPhiloxW1;
+  }
+}
+
+// 53 random bits of (hi, lo) words scaled into [0, 1)
+template <class D, class DF>
+HWY_INLINE hn::Vec<DF> to_unit_double(D d, DF df, hn::Vec<D> hi, hn::Vec<D> lo) {
+  const hn::RebindToSigned<D> di;
+  auto bits = hn::ShiftRight<11>(hn::Or(hn::ShiftLeft<32>(hi), lo));
+  return hn::Mul(hn::ConvertTo(df, hn::BitCast(di, bits)), hn::Set(df, 1.0 / 9007199254740992.0));
+}
+
+template <RandomDist dist, class D, class DF>
+HWY_INLINE auto philox_dist(D d, DF df, hn::Vec<D> rows, uint64_t seed, uint64_t stream) {
+  const auto lo_mask = hn::Set(d, 0xFFFFFFFFULL);
+  auto c0 = hn::And(rows, lo_mask);
+  auto c1 = hn::ShiftRight<32>(rows);
+  auto c2 = hn::Set(d, stream & 0xFFFFFFFFULL);
+  auto c3 = hn::Set(d, stream >> 32);
+  philox4x32(d, c0, c1, c2, c3, seed);
+  if constexpr (dist == kRandomU64) {
+    return hn::Or(hn::ShiftLeft<32>(c1), c0);
+  } else if constexpr (dist == kRandomUniform) {
+    return to_unit_double(d, df, c1, c0);
+  } else {
+    // 1 - u keeps the log argument in (0, 1]
+    auto u1 = hn::Sub(hn::Set(df, 1.0), to_unit_double(d, df, c1, c0));
+    auto u2 = to_unit_double(d, df, c3, c2);
+    auto radius = hn::Sqrt(hn::Mul(hn::Set(df, -2.0), hn::Log(df, u1)));
+    return hn::Mul(radius, hn::Cos(df, hn::Mul(u2, hn::Set(df, kTwoPi))));
+  }
+}
+
+template <RandomDist dist>
+HWY_INLINE void philox_random_impl(uint64_t seed, uint64_t stream, const uint64_t* rows, random_out_t<dist>* out,
+                                   size_t n) {
+  const hn::ScalableTag<uint64_t> d;
+  const hn::Rebind<double, decltype(d)> df;
+  const hn::Rebind<random_out_t<dist>, decltype(d)> dout;
+  const size_t N = hn::Lanes(d);
+  size_t i = 0;
+  for (; i + N <= n; i += N) {
+    hn::StoreU(philox_dist<dist>(d, df, hn::LoadU(d, rows + i), seed, stream), dout, out + i);
+  }
+  if (i < n) {
+    hn::StoreN(philox_dist<dist>(d, df, hn::LoadN(d, rows + i, n - i), seed, stream), dout, out + i, n - i);
+  }
+}
+
+}  // namespace HWY_NAMESPACE
+}  // namespace functions
+}  // namespace rapidudf
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace rapidudf {
+namespace functions {
+
+void philox_random(uint64_t seed, uint64_t stream, const uint64_t* rows, uint64_t* out, size_t n) {
+  HWY_EXPORT_T(Table, philox_random_impl<kRandomU64>);
+  HWY_DYNAMIC_DISPATCH_T(Table)(seed, stream, rows, out, n);
+}
+
+uint64_t philox_random(uint64_t seed, uint64_t stream, uint64_t row) {
+  uint64_t out = 0;
+  philox_random(seed, stream, &row, &out, 1);
+  return out;
+}
+
+Vector<double> simd_vector_rand_uniform(Context& ctx, Vector<uint64_t> rows, uint64_t seed) {
+  VectorBuf vdata = ctx.NewVectorBuf<double>(rows.Size());
+  HWY_EXPORT_T(Table, philox_random_impl<kRandomUniform>);
+  HWY_DYNAMIC_DISPATCH_T(Table)(seed, ctx.GetRequestId(), rows.Data(), vdata.MutableData<double>(), rows.Size());
+  return Vector<double>(vdata);
+}
+
+Vector<double> simd_vector_rand_normal(Context& ctx, Vector<uint64_t> rows, uint64_t seed) {
+  VectorBuf vdata = ctx.NewVectorBuf<double>(rows.Size());
+  HWY_EXPORT_T(Table, philox_random_impl<kRandomNormal>);
+  HWY_DYNAMIC_DISPATCH_T(Table)(seed, ctx.GetRequestId(), rows.Data(), vdata.MutableData<double>(), rows.Size());
+  return Vector<double>(vdata);
+}
+
+Vector<Bit> simd_vector_rand_bernoulli(Context& ctx, Vector<uint64_t> rows, uint64_t seed, double p) {
+  VectorBuf vdata = ctx.NewVectorBuf<Bit>(rows.Size());
+  uint8_t* bits = vdata.MutableData<uint8_t>();
+  // compare 64 random bits with p * 2^64, p >= 1 would overflow the threshold
+  bool always = p >= 1.0;
+  uint64_t threshold = p > 0 && !always ? static_cast<uint64_t>(std::ldexp(p, 64)) : 0;
+  uint64_t randoms[64];
+  // arena bits buffer is 8 bytes aligned, fill 64 results per store.
+  for (size_t i = 0; i < rows.Size(); i += 64) {
+    size_t n = std::min<size_t>(64, rows.Size() - i);
+    uint64_t word = 0;
+    if (always) {
+      word = n == 64 ? ~0ULL : ((1ULL << n) - 1);
+    } else {
+      philox_random(seed, ctx.GetRequestId(), rows.Data() + i, randoms, n);
+      for (size_t j = 0; j < n; j++) {
+        word |= static_cast<uint64_t>(randoms[j] < threshold) << j;
+      }
+    }
+    memcpy(bits + i / 8, &word, sizeof(word));
+  }
+  return Vector<Bit>(vdata);
+}
+
+}  // namespace functions
+}  // namespace rapidudf
+#endif  // HWY_ONCE
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "rapidudf/context/context.h"
+#include "rapidudf/types/vector.h"
+namespace rapidudf {
+namespace functions {
+/**
+** Philox4x32-10 counter based random, keyed by `seed` with counter (`row`, `stream`), every row gets the same
+** random value no matter how rows are batched, different streams(request ids) are independent.
+*/
+void philox_random(uint64_t seed, uint64_t stream, const uint64_t* rows, uint64_t* out, size_t n);
+uint64_t philox_random(uint64_t seed, uint64_t stream, uint64_t row);
+
+/**
+** uniform in [0, 1) of every row, stream is `ctx.GetRequestId()`.
+*/
+Vector<double> simd_vector_rand_uniform(Context& ctx, Vector<uint64_t> rows, uint64_t seed);
+/**
+** standard normal of every row by box-muller, stream is `ctx.GetRequestId()`.
+*/
+Vector<double> simd_vector_rand_normal(Context& ctx, Vector<uint64_t> rows, uint64_t seed);
+/**
+** true with probability `p` of every row, stream is `ctx.GetRequestId()`.
+*/
+Vector<Bit> simd_vector_rand_bernoulli(Context& ctx, Vector<uint64_t> rows, uint64_t seed, double p);
+}  // namespace functions
+}  // namespace rapidudf
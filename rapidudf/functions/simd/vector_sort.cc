@@ -18,6 +18,11 @@
 #include <boost/preprocessor/seq/for_each_product.hpp>
 #include <boost/preprocessor/stringize.hpp>
 #include <boost/preprocessor/variadic/to_seq.hpp>
+#include <array>
+#include <cstring>
+#include <numeric>
+#include <type_traits>
+
 #include "rapidudf/log/log.h"
 #include "rapidudf/meta/exception.h"
 #include "rapidudf/meta/function.h"
@@ -26,29 +31,175 @@
 
 namespace rapidudf {
 namespace functions {
+/**
+** x86-simd-sort is faster on short inputs, LSD radix sort wins once the data is far larger than the caches.
+** 8bit keys are not supported by x86-simd-sort and always use radix sort.
+** Floats with NaNs are left to x86-simd-sort, radix sort would order NaNs by their bit patterns.
+*/
+static constexpr size_t kRadixSort16MinSize = 2048;
+static constexpr size_t kRadixSortMinSize = 64 * 1024;
+
+template <typename T>
+static inline bool use_radix_sort(Context& ctx, size_t n) {
+  if constexpr (sizeof(T) == 1) {
+    return true;
+  } else if constexpr (std::is_floating_point_v<T>) {
+    return !ctx.HasNan() && n >= kRadixSortMinSize;
+  } else if constexpr (sizeof(T) == 2) {
+    return n >= kRadixSort16MinSize;
+  } else {
+    return n >= kRadixSortMinSize;
+  }
+}
+
+// map key to unsigned integer with the same order
+template <typename T>
+static inline auto radix_key(T v) {
+  if constexpr (std::is_floating_point_v<T>) {
+    using U = std::conditional_t<sizeof(T) == 8, uint64_t, uint32_t>;
+    constexpr U kSignBit = U(1) << (sizeof(T) * 8 - 1);
+    U bits;
+    memcpy(&bits, &v, sizeof(T));
+    return (bits & kSignBit) ? static_cast<U>(~bits) : static_cast<U>(bits | kSignBit);
+  } else if constexpr (std::is_signed_v<T>) {
+    using U = std::make_unsigned_t<T>;
+    constexpr U kSignBit = U(1) << (sizeof(T) * 8 - 1);
+    return static_cast<U>(static_cast<U>(v) ^ kSignBit);
+  } else {
+    return v;
+  }
+}
+
+/**
+** Stable LSD radix sort with 8bit digits, values are moved with keys if `values` is not null.
+** Histograms of all passes are built in one read, passes with only one digit value are skipped.
+*/
+template <typename K, typename V>
+static void radix_sort(K* keys, K* keys_buf, V* values, V* values_buf, size_t n, bool descending) {
+  using U = decltype(radix_key(K{}));
+  constexpr size_t kPasses = sizeof(K);
+  const U flip = descending ? static_cast<U>(~U(0)) : U(0);
+  auto digit = [flip](K v, size_t pass) -> uint32_t {
+    return static_cast<uint32_t>((static_cast<U>(radix_key(v) ^ flip) >> (pass * 8)) & 0xff);
+  };
+  std::array<std::array<uint32_t, 256>, kPasses> counts{};
+  for (size_t i = 0; i < n; i++) {
+    for (size_t pass = 0; pass < kPasses; pass++) {
+      counts[pass][digit(keys[i], pass)]++;
+    }
+  }
+  K* src = keys;
+  K* dst = keys_buf;
+  V* values_src = values;
+  V* values_dst = values_buf;
+  for (size_t pass = 0; pass < kPasses; pass++) {
+    auto& offsets = counts[pass];
+    if (offsets[digit(src[0], pass)] == n) {
+      continue;
+    }
+    uint32_t sum = 0;
+    for (auto& offset : offsets) {
+      uint32_t count = offset;
+      offset = sum;
+      sum += count;
+    }
+    for (size_t i = 0; i < n; i++) {
+      uint32_t pos = offsets[digit(src[i], pass)]++;
+      dst[pos] = src[i];
+      if (values != nullptr) {
+        values_dst[pos] = values_src[i];
+      }
+    }
+    std::swap(src, dst);
+    std::swap(values_src, values_dst);
+  }
+  if (src != keys) {
+    memcpy(keys, src, sizeof(K) * n);
+    if (values != nullptr) {
+      memcpy(values, values_src, sizeof(V) * n);
+    }
+  }
+}
+
+template <typename T>
+static T* arena_new_array(Context& ctx, size_t n) {
+  return reinterpret_cast<T*>(ctx.ArenaAllocate(sizeof(T) * n));
+}
+
+template <typename T>
+static uint32_t* radix_argsort(Context& ctx, const T* data, size_t n, bool descending) {
+  T* keys = arena_new_array<T>(ctx, n);
+  T* keys_buf = arena_new_array<T>(ctx, n);
+  uint32_t* indices = arena_new_array<uint32_t>(ctx, n);
+  uint32_t* indices_buf = arena_new_array<uint32_t>(ctx, n);
+  memcpy(keys, data, sizeof(T) * n);
+  std::iota(indices, indices + n, 0);
+  radix_sort(keys, keys_buf, indices, indices_buf, n, descending);
+  return indices;
+}
+
 template <typename T>
 void simd_vector_sort(Context& ctx, Vector<T> data, bool descending) {
   if (data.IsReadonly()) {
-    THROW_READONLY_ERR("can NOT sort on readonly vector");
+    RAISE_READONLY_ERR(, "can NOT sort on readonly vector");
+  }
+  if (data.Size() == 0) {
+    return;
+  }
+  if (use_radix_sort<T>(ctx, data.Size())) {
+    T* keys_buf = arena_new_array<T>(ctx, data.Size());
+    radix_sort<T, uint8_t>(const_cast<T*>(data.Data()), keys_buf, nullptr, nullptr, data.Size(), descending);
+    return;
+  }
+  if constexpr (sizeof(T) > 1) {
+    x86simdsort::qsort(const_cast<T*>(data.Data()), data.Size(), ctx.HasNan(), descending);
   }
-  x86simdsort::qsort(const_cast<T*>(data.Data()), data.Size(), ctx.HasNan(), descending);
 }
 template <typename T>
 void simd_vector_select(Context& ctx, Vector<T> data, size_t k, bool descending) {
   if (data.IsReadonly()) {
-    THROW_READONLY_ERR("can NOT select on readonly vector");
+    RAISE_READONLY_ERR(, "can NOT select on readonly vector");
   }
   x86simdsort::qselect(const_cast<T*>(data.Data()), k, data.Size(), ctx.HasNan(), descending);
 }
 template <typename T>
 void simd_vector_topk(Context& ctx, Vector<T> data, size_t k, bool descending) {
   if (data.IsReadonly()) {
-    THROW_READONLY_ERR("can NOT topk on readonly vector");
+    RAISE_READONLY_ERR(, "can NOT topk on readonly vector");
   }
   x86simdsort::partial_qsort(const_cast<T*>(data.Data()), k, data.Size(), ctx.HasNan(), descending);
 }
+template <typename T>
+Vector<uint32_t> simd_vector_argsort_u32(Context& ctx, Vector<T> data, bool descending) {
+  size_t n = data.Size();
+  if (n == 0) {
+    return {};
+  }
+  uint32_t* indices = nullptr;
+  if constexpr (sizeof(T) <= 2) {
+    // x86-simd-sort has no key-value sort of 8/16bit keys
+    indices = radix_argsort(ctx, data.Data(), n, descending);
+  } else if (use_radix_sort<T>(ctx, n)) {
+    indices = radix_argsort(ctx, data.Data(), n, descending);
+  } else {
+    T* keys = arena_new_array<T>(ctx, n);
+    indices = arena_new_array<uint32_t>(ctx, n);
+    memcpy(keys, data.Data(), sizeof(T) * n);
+    std::iota(indices, indices + n, 0);
+    x86simdsort::keyvalue_qsort(keys, indices, n, ctx.HasNan(), descending);
+  }
+  return Vector<uint32_t>(indices, n);
+}
+
 template <typename T>
 Vector<size_t> simd_vector_argsort(Context& ctx, Vector<T> data, bool descending) {
+  if (use_radix_sort<T>(ctx, data.Size())) {
+    size_t n = data.Size();
+    uint32_t* indices = radix_argsort(ctx, data.Data(), n, descending);
+    size_t* result = arena_new_array<size_t>(ctx, n);
+    std::copy(indices, indices + n, result);
+    return Vector<size_t>(result, n);
+  }
   std::vector<size_t> idxs = x86simdsort::argsort(const_cast<T*>(data.Data()), data.Size(), ctx.HasNan(), descending);
   auto p = std::make_unique<std::vector<size_t>>(std::move(idxs));
   Vector<size_t> ret(*p);
@@ -71,18 +222,24 @@ Vector<size_t> simd_vector_argselect(Context& ctx, Vector<T> data, size_t k, boo
 template <typename K, typename V>
 void simd_vector_sort_key_value(Context& ctx, Vector<K> key, Vector<V> value, bool descending) {
   if (key.IsReadonly() || value.IsReadonly()) {
-    THROW_READONLY_ERR(
-        fmt::format("can NOT sort_key_value on readonly vector, key vector readobt:{}, value vector readonly:{}",
-                    key.IsReadonly(), value.IsReadonly()));
+    RAISE_READONLY_ERR(
+        , fmt::format("can NOT sort_key_value on readonly vector, key vector readobt:{}, value vector readonly:{}",
+                      key.IsReadonly(), value.IsReadonly()));
   }
 
+  if (key.Size() > 0 && use_radix_sort<K>(ctx, key.Size())) {
+    K* keys_buf = arena_new_array<K>(ctx, key.Size());
+    V* values_buf = arena_new_array<V>(ctx, key.Size());
+    radix_sort(const_cast<K*>(key.Data()), keys_buf, const_cast<V*>(value.Data()), values_buf, key.Size(), descending);
+    return;
+  }
   x86simdsort::keyvalue_qsort(const_cast<K*>(key.Data()), const_cast<V*>(value.Data()), key.Size(), ctx.HasNan(),
                               descending);
 }
 template <typename K, typename V>
 void simd_vector_topk_key_value(Context& ctx, Vector<K> key, Vector<V> value, size_t k, bool descending) {
   if (key.IsReadonly() || value.IsReadonly()) {
-    THROW_READONLY_ERR("can NOT topk_key_value on readonly vector");
+    RAISE_READONLY_ERR(, "can NOT topk_key_value on readonly vector");
   }
   x86simdsort::keyvalue_partial_sort(const_cast<K*>(key.Data()), const_cast<V*>(value.Data()), k, key.Size(),
                                      ctx.HasNan(), descending);
@@ -90,7 +247,7 @@ void simd_vector_topk_key_value(Context& ctx, Vector<K> key, Vector<V> value, si
 template <typename K, typename V>
 void simd_vector_select_key_value(Context& ctx, Vector<K> key, Vector<V> value, size_t k, bool descending) {
   if (key.IsReadonly() || value.IsReadonly()) {
-    THROW_READONLY_ERR("can NOT select_key_value on readonly vector");
+    RAISE_READONLY_ERR(, "can NOT select_key_value on readonly vector");
   }
   x86simdsort::keyvalue_select(const_cast<K*>(key.Data()), const_cast<V*>(value.Data()), k, key.Size(), ctx.HasNan(),
                                descending);
@@ -100,7 +257,8 @@ void simd_vector_select_key_value(Context& ctx, Vector<K> key, Vector<V> value,
   template void func<TYPE>(Context & ctx, Vector<TYPE> data, bool descending);
 #define DEFINE_SORT_OP(func, ...) \
   BOOST_PP_SEQ_FOR_EACH_I(DEFINE_SORT_OP_TEMPLATE, func, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
-DEFINE_SORT_OP(simd_vector_sort, float, double, uint64_t, int64_t, uint32_t, int32_t, uint16_t, int16_t)
+DEFINE_SORT_OP(simd_vector_sort, float, double, uint64_t, int64_t, uint32_t, int32_t, uint16_t, int16_t, uint8_t,
+               int8_t)
 
 #define DEFINE_SELECT_OP_TEMPLATE(r, func, ii, TYPE) \
   template void func<TYPE>(Context & ctx, Vector<TYPE> data, size_t k, bool descending);
@@ -115,6 +273,13 @@ DEFINE_SELECT_OP(simd_vector_topk, float, double, uint64_t, int64_t, uint32_t, i
   BOOST_PP_SEQ_FOR_EACH_I(DEFINE_ARGSORT_OP_TEMPLATE, func, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
 DEFINE_ARGSORT_OP(simd_vector_argsort, float, double, uint64_t, int64_t, uint32_t, int32_t, uint16_t, int16_t)
 
+#define DEFINE_ARGSORT_U32_OP_TEMPLATE(r, func, ii, TYPE) \
+  template Vector<uint32_t> func<TYPE>(Context & ctx, Vector<TYPE> data, bool descending);
+#define DEFINE_ARGSORT_U32_OP(func, ...) \
+  BOOST_PP_SEQ_FOR_EACH_I(DEFINE_ARGSORT_U32_OP_TEMPLATE, func, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
+DEFINE_ARGSORT_U32_OP(simd_vector_argsort_u32, float, double, uint64_t, int64_t, uint32_t, int32_t, uint16_t, int16_t,
+                      uint8_t, int8_t)
+
 #define DEFINE_ARGSELECT_OP_TEMPLATE(r, func, ii, TYPE) \
   template Vector<size_t> func<TYPE>(Context & ctx, Vector<TYPE> data, size_t, bool descending);
 #define DEFINE_ARGSELECT_OP(func, ...) \
@@ -29,6 +29,11 @@ template <typename T>
 void simd_vector_topk(Context& ctx, Vector<T> data, size_t k, bool descending);
 template <typename T>
 Vector<size_t> simd_vector_argsort(Context& ctx, Vector<T> data, bool descending);
+/**
+** argsort with u32 indices allocated in ctx arena.
+*/
+template <typename T>
+Vector<uint32_t> simd_vector_argsort_u32(Context& ctx, Vector<T> data, bool descending);
 template <typename T>
 Vector<size_t> simd_vector_argselect(Context& ctx, Vector<T> data, size_t k, bool descending);
 
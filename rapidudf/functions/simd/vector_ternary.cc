@@ -18,6 +18,7 @@
 #include <boost/preprocessor/stringize.hpp>
 #include <boost/preprocessor/variadic/to_seq.hpp>
 
+#include "rapidudf/functions/simd/dispatch.h"
 #include "rapidudf/functions/simd/vector.h"
 #include "rapidudf/meta/optype.h"
 #include "rapidudf/types/vector.h"
@@ -93,8 +94,16 @@ void simd_vector_ternary_op(const T* a, const T* b, const T* c, T* output) {
   return HWY_DYNAMIC_DISPATCH_T(Table)(a, b, c, output);
 }
 
-#define DEFINE_SIMD_TERNARY_OP_TEMPLATE(r, op, ii, TYPE) \
-  template void simd_vector_ternary_op<TYPE, op>(const TYPE*, const TYPE*, const TYPE*, TYPE* output);
+template <typename T, OpToken op>
+void* resolve_simd_vector_ternary_op() {
+  using OPT = OperandType<T, op>;
+  HWY_EXPORT_T(Table, simd_vector_ternary_op_impl<OPT>);
+  return RUDF_HWY_DYNAMIC_POINTER(Table);
+}
+
+#define DEFINE_SIMD_TERNARY_OP_TEMPLATE(r, op, ii, TYPE)                                               \
+  template void simd_vector_ternary_op<TYPE, op>(const TYPE*, const TYPE*, const TYPE*, TYPE* output); \
+  template void* resolve_simd_vector_ternary_op<TYPE, op>();
 #define DEFINE_SIMD_TERNARY_OP(op, ...) \
   BOOST_PP_SEQ_FOR_EACH_I(DEFINE_SIMD_TERNARY_OP_TEMPLATE, op, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
 // DEFINE_SIMD_UNARY_OP(OP_NOT, Bit);
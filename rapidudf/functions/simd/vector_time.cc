@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <time.h>
+#include <cstdint>
+
+#include "rapidudf/context/context.h"
+#include "rapidudf/functions/simd/vector_time.h"
+#include "rapidudf/log/log.h"
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "rapidudf/functions/simd/vector_time.cc"  // this file
+
+#include "hwy/foreach_target.h"  // must come before highway.h
+
+#include "hwy/highway.h"
+
+// shared by all targets & the dispatch code, defined once since this file is included once per target.
+#ifndef RAPIDUDF_FUNCTIONS_SIMD_VECTOR_TIME_ONCE
+#define RAPIDUDF_FUNCTIONS_SIMD_VECTOR_TIME_ONCE
+namespace rapidudf {
+namespace functions {
+static constexpr int64_t kSecondsPerDay = 86400;
+static constexpr int64_t kSecondsPerHour = 3600;
+// 1970-01-01 is thursday
+static constexpr int64_t kEpochDayOfWeek = 4;
+
+enum TimeField {
+  kHourOfDay = 0,
+  kDayOfWeek,
+  kDaysSince,
+};
+
+static inline int64_t floor_div(int64_t x, int64_t divisor, int64_t& rem) {
+  int64_t q = x / divisor;
+  rem = x % divisor;
+  if (rem < 0) {
+    q--;
+    rem += divisor;
+  }
+  return q;
+}
+}  // namespace functions
+}  // namespace rapidudf
+#endif  // RAPIDUDF_FUNCTIONS_SIMD_VECTOR_TIME_ONCE
+
+HWY_BEFORE_NAMESPACE();
+namespace rapidudf {
+namespace functions {
+namespace HWY_NAMESPACE {
+namespace hn = hwy::HWY_NAMESPACE;
+using functions::floor_div;
+
+/**
+** there is no 64bit integer division in simd, the quotient is computed by multiplying the f64 reciprocal,
+** then corrected by the sign/range of the remainder.
+*/
+template <class D>
+HWY_INLINE hn::Vec<D> floor_div(D d, hn::Vec<D> x, int64_t divisor, hn::Vec<D>& rem) {
+  const hn::RebindToFloat<D> df;
+  const auto vdivisor = hn::Set(d, divisor);
+  const auto one = hn::Set(d, 1);
+  auto q = hn::ConvertTo(d, hn::Floor(hn::Mul(hn::ConvertTo(df, x), hn::Set(df, 1.0 / divisor))));
+  auto r = hn::Sub(x, hn::Mul(q, vdivisor));
+  auto under = hn::Lt(r, hn::Zero(d));
+  q = hn::Sub(q, hn::IfThenElseZero(under, one));
+  r = hn::Add(r, hn::IfThenElseZero(under, vdivisor));
+  auto over = hn::Le(vdivisor, r);
+  q = hn::Add(q, hn::IfThenElseZero(over, one));
+  rem = hn::Sub(r, hn::IfThenElseZero(over, vdivisor));
+  return q;
+}
+
+template <TimeField field>
+HWY_INLINE int32_t time_field(int64_t ts, int64_t offset) {
+  int64_t rem = 0;
+  if constexpr (field == kHourOfDay) {
+    floor_div(ts + offset, kSecondsPerDay, rem);
+    return static_cast<int32_t>(rem / kSecondsPerHour);
+  } else if constexpr (field == kDayOfWeek) {
+    int64_t days = floor_div(ts + offset, kSecondsPerDay, rem);
+    floor_div(days + kEpochDayOfWeek, 7, rem);
+    return static_cast<int32_t>(rem);
+  } else {
+    return static_cast<int32_t>(floor_div(offset - ts, kSecondsPerDay, rem));
+  }
+}
+
+template <TimeField field, class D>
+HWY_INLINE hn::Vec<D> time_field(D d, hn::Vec<D> ts, int64_t offset) {
+  hn::Vec<D> rem;
+  if constexpr (field == kHourOfDay) {
+    floor_div(d, hn::Add(ts, hn::Set(d, offset)), kSecondsPerDay, rem);
+    return floor_div(d, rem, kSecondsPerHour, rem);
+  } else if constexpr (field == kDayOfWeek) {
+    auto days = floor_div(d, hn::Add(ts, hn::Set(d, offset)), kSecondsPerDay, rem);
+    floor_div(d, hn::Add(days, hn::Set(d, kEpochDayOfWeek)), 7, rem);
+    return rem;
+  } else {
+    return floor_div(d, hn::Sub(hn::Set(d, offset), ts), kSecondsPerDay, rem);
+  }
+}
+
+template <TimeField field>
+HWY_INLINE void simd_vector_time_field_impl(const int64_t* in, int64_t offset, int32_t* out, size_t n) {
+  const hn::ScalableTag<int64_t> d;
+  const hn::Rebind<int32_t, decltype(d)> d32;
+  const size_t N = hn::Lanes(d);
+  size_t i = 0;
+  for (; i + N <= n; i += N) {
+    hn::StoreU(hn::DemoteTo(d32, time_field<field>(d, hn::LoadU(d, in + i), offset)), d32, out + i);
+  }
+  for (; i < n; i++) {
+    out[i] = time_field<field>(in[i], offset);
+  }
+}
+
+}  // namespace HWY_NAMESPACE
+}  // namespace functions
+}  // namespace rapidudf
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace rapidudf {
+namespace functions {
+
+static Vector<int32_t> new_time_output(Context& ctx, size_t n, int32_t*& out) {
+  VectorBuf vdata = ctx.NewVectorBuf<int32_t>(n);
+  out = vdata.MutableData<int32_t>();
+  return Vector<int32_t>(vdata);
+}
+
+Vector<int32_t> simd_vector_hour_of_day(Context& ctx, Vector<int64_t> ts, int32_t tz_offset) {
+  int32_t* out = nullptr;
+  auto result = new_time_output(ctx, ts.Size(), out);
+  HWY_EXPORT_T(Table, simd_vector_time_field_impl<kHourOfDay>);
+  HWY_DYNAMIC_DISPATCH_T(Table)(ts.Data(), tz_offset, out, ts.Size());
+  return result;
+}
+
+Vector<int32_t> simd_vector_day_of_week(Context& ctx, Vector<int64_t> ts, int32_t tz_offset) {
+  int32_t* out = nullptr;
+  auto result = new_time_output(ctx, ts.Size(), out);
+  HWY_EXPORT_T(Table, simd_vector_time_field_impl<kDayOfWeek>);
+  HWY_DYNAMIC_DISPATCH_T(Table)(ts.Data(), tz_offset, out, ts.Size());
+  return result;
+}
+
+Vector<int32_t> simd_vector_days_since(Context& ctx, Vector<int64_t> ts) {
+  int32_t* out = nullptr;
+  auto result = new_time_output(ctx, ts.Size(), out);
+  HWY_EXPORT_T(Table, simd_vector_time_field_impl<kDaysSince>);
+  HWY_DYNAMIC_DISPATCH_T(Table)(ts.Data(), ctx.NowUs() / 1000000, out, ts.Size());
+  return result;
+}
+
+Vector<int32_t> simd_vector_tz_offset(Context& ctx, Vector<int64_t> ts) {
+  // offsets only change at quarter hour boundaries, timestamps of one column are usually close to each other
+  static constexpr int64_t kOffsetGranularity = 900;
+  int32_t* out = nullptr;
+  auto result = new_time_output(ctx, ts.Size(), out);
+  int64_t last_slot = INT64_MIN;
+  int32_t last_offset = 0;
+  for (size_t i = 0; i < ts.Size(); i++) {
+    // floor, so pre-epoch timestamps on both sides of a boundary never share a slot
+    int64_t rem = 0;
+    int64_t slot = floor_div(ts[i], kOffsetGranularity, rem);
+    if (slot != last_slot) {
+      time_t t = static_cast<time_t>(ts[i]);
+      struct tm local;
+      if (nullptr == localtime_r(&t, &local)) {
+        RUDF_ERROR("localtime_r failed for timestamp:{}", ts[i]);
+        local.tm_gmtoff = 0;
+      }
+      last_slot = slot;
+      last_offset = static_cast<int32_t>(local.tm_gmtoff);
+    }
+    out[i] = last_offset;
+  }
+  return result;
+}
+
+}  // namespace functions
+}  // namespace rapidudf
+#endif  // HWY_ONCE
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "rapidudf/context/context.h"
+#include "rapidudf/types/vector.h"
+namespace rapidudf {
+namespace functions {
+/**
+** timestamps are unix seconds, `tz_offset` is the utc offset in seconds added before extracting fields.
+*/
+Vector<int32_t> simd_vector_hour_of_day(Context& ctx, Vector<int64_t> ts, int32_t tz_offset);
+/**
+** 0 is sunday.
+*/
+Vector<int32_t> simd_vector_day_of_week(Context& ctx, Vector<int64_t> ts, int32_t tz_offset);
+/**
+** whole days elapsed from every timestamp to `ctx.NowUs()`, negative for future timestamps.
+*/
+Vector<int32_t> simd_vector_days_since(Context& ctx, Vector<int64_t> ts);
+/**
+** utc offset in seconds of the local timezone at every timestamp, dst aware.
+*/
+Vector<int32_t> simd_vector_tz_offset(Context& ctx, Vector<int64_t> ts);
+}  // namespace functions
+}  // namespace rapidudf
@@ -19,6 +19,7 @@
 #include <boost/preprocessor/stringize.hpp>
 #include <boost/preprocessor/variadic/to_seq.hpp>
 
+#include "rapidudf/functions/simd/dispatch.h"
 #include "rapidudf/functions/simd/vector.h"
 #include "rapidudf/meta/optype.h"
 #include "rapidudf/types/vector.h"
@@ -346,8 +347,16 @@ void simd_vector_unary_op(const T* input, T* output) {
   return HWY_DYNAMIC_DISPATCH_T(Table)(input, output);
 }
 
-#define DEFINE_SIMD_UNARY_OP_TEMPLATE(r, op, ii, TYPE) \
-  template void simd_vector_unary_op<TYPE, op>(const TYPE* input, TYPE* output);
+template <typename T, OpToken op>
+void* resolve_simd_vector_unary_op() {
+  using OPT = OperandType<T, op>;
+  HWY_EXPORT_T(Table, simd_vector_unary_op_impl<OPT>);
+  return RUDF_HWY_DYNAMIC_POINTER(Table);
+}
+
+#define DEFINE_SIMD_UNARY_OP_TEMPLATE(r, op, ii, TYPE)                           \
+  template void simd_vector_unary_op<TYPE, op>(const TYPE* input, TYPE* output); \
+  template void* resolve_simd_vector_unary_op<TYPE, op>();
 #define DEFINE_SIMD_UNARY_OP(op, ...) \
   BOOST_PP_SEQ_FOR_EACH_I(DEFINE_SIMD_UNARY_OP_TEMPLATE, op, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
 // DEFINE_SIMD_UNARY_OP(OP_NOT, Bit);
@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <boost/preprocessor/library.hpp>
+#include <boost/preprocessor/seq/for_each.hpp>
+#include <boost/preprocessor/stringize.hpp>
+#include <boost/preprocessor/variadic/to_seq.hpp>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "rapidudf/context/context.h"
+#include "rapidudf/functions/simd/vector_misc.h"
+#include "rapidudf/functions/simd/vector_op.h"
+#include "rapidudf/functions/simd/vector_window.h"
+#include "rapidudf/log/log.h"
+#include "rapidudf/meta/exception.h"
+#include "rapidudf/meta/optype.h"
+#include "rapidudf/types/string_view.h"
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "rapidudf/functions/simd/vector_window.cc"  // this file
+
+#include "hwy/foreach_target.h"  // must come before highway.h
+
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace rapidudf {
+namespace functions {
+
+namespace HWY_NAMESPACE {
+namespace hn = hwy::HWY_NAMESPACE;
+
+// windows not larger than this are summed directly for floating point, which avoids the cancellation error of
+// `cumsum[i] - cumsum[i - window]` on long inputs.
+static constexpr size_t kDirectRollingWindow = 16;
+
+template <typename T, OpToken op>
+HWY_INLINE T scan_identity() {
+  if constexpr (op == OP_MAX) {
+    return std::numeric_limits<T>::lowest();
+  } else if constexpr (op == OP_MIN) {
+    return std::numeric_limits<T>::max();
+  } else {
+    return T{};
+  }
+}
+
+template <OpToken op, class V>
+HWY_INLINE V scan_combine(V a, V b) {
+  if constexpr (op == OP_MAX) {
+    return hn::Max(a, b);
+  } else if constexpr (op == OP_MIN) {
+    return hn::Min(a, b);
+  } else {
+    return hn::Add(a, b);
+  }
+}
+
+template <OpToken op, typename T>
+HWY_INLINE T scan_combine_scalar(T a, T b) {
+  if constexpr (op == OP_MAX) {
+    return a > b ? a : b;
+  } else if constexpr (op == OP_MIN) {
+    return a < b ? a : b;
+  } else {
+    return static_cast<T>(a + b);
+  }
+}
+
+/**
+** inclusive prefix scan, in register with log2(lanes) slide steps, then carried across vectors.
+** `in` and `out` may alias.
+*/
+template <typename OPT>
+HWY_INLINE void simd_vector_scan_impl(const typename OPT::operand_t* in, typename OPT::operand_t* out, size_t n) {
+  using T = typename OPT::operand_t;
+  constexpr OpToken op = OPT::op;
+  const hn::ScalableTag<T> d;
+  const size_t N = hn::Lanes(d);
+  const T identity = scan_identity<T, op>();
+  const auto identity_v = hn::Set(d, identity);
+  T carry = identity;
+  size_t i = 0;
+  for (; i + N <= n; i += N) {
+    auto v = hn::LoadU(d, in + i);
+    for (size_t shift = 1; shift < N; shift <<= 1) {
+      v = scan_combine<op>(v, hn::IfThenElse(hn::FirstN(d, shift), identity_v, hn::SlideUpLanes(d, v, shift)));
+    }
+    v = scan_combine<op>(v, hn::Set(d, carry));
+    hn::StoreU(v, d, out + i);
+    carry = hn::ExtractLane(v, N - 1);
+  }
+  for (; i < n; i++) {
+    carry = scan_combine_scalar<op>(carry, in[i]);
+    out[i] = carry;
+  }
+}
+
+template <typename T>
+HWY_INLINE void simd_vector_rolling_sum_impl(const T* in, T* out, size_t n, size_t window) {
+  const hn::ScalableTag<T> d;
+  const size_t N = hn::Lanes(d);
+  if constexpr (std::is_floating_point_v<T>) {
+    if (window <= kDirectRollingWindow) {
+      size_t head = std::min(n, window - 1);
+      T sum = 0;
+      size_t i = 0;
+      for (; i < head; i++) {
+        sum += in[i];
+        out[i] = sum;
+      }
+      for (; i + N <= n; i += N) {
+        auto acc = hn::LoadU(d, in + i);
+        for (size_t k = 1; k < window; k++) {
+          acc = hn::Add(acc, hn::LoadU(d, in + i - k));
+        }
+        hn::StoreU(acc, d, out + i);
+      }
+      for (; i < n; i++) {
+        T acc = in[i];
+        for (size_t k = 1; k < window; k++) {
+          acc += in[i - k];
+        }
+        out[i] = acc;
+      }
+      return;
+    }
+  }
+  simd_vector_scan_impl<OperandType<T, OP_PLUS>>(in, out, n);
+  // walk backward so that out[i - window] still holds the prefix sum when out[i] is rewritten.
+  size_t i = n;
+  while (i >= window + N) {
+    i -= N;
+    hn::StoreU(hn::Sub(hn::LoadU(d, out + i), hn::LoadU(d, out + i - window)), d, out + i);
+  }
+  while (i > window) {
+    i--;
+    out[i] -= out[i - window];
+  }
+}
+
+template <typename T>
+HWY_INLINE void simd_vector_rolling_avg_impl(const T* in, T* out, size_t n, size_t window) {
+  simd_vector_rolling_sum_impl<T>(in, out, n, window);
+  const hn::ScalableTag<T> d;
+  const size_t N = hn::Lanes(d);
+  size_t head = std::min(n, window);
+  size_t i = 0;
+  for (; i < head; i++) {
+    out[i] /= static_cast<T>(i + 1);
+  }
+  const auto window_v = hn::Set(d, static_cast<T>(window));
+  for (; i + N <= n; i += N) {
+    hn::StoreU(hn::Div(hn::LoadU(d, out + i), window_v), d, out + i);
+  }
+  for (; i < n; i++) {
+    out[i] /= static_cast<T>(window);
+  }
+}
+
+}  // namespace HWY_NAMESPACE
+}  // namespace functions
+}  // namespace rapidudf
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace rapidudf {
+namespace functions {
+
+template <typename T>
+static Vector<T> new_window_output(Context& ctx, size_t n, T*& out) {
+  VectorBuf vdata = ctx.NewVectorBuf<T>(n);
+  out = vdata.MutableData<T>();
+  return Vector<T>(vdata);
+}
+
+template <typename T, OpToken op>
+static Vector<T> simd_vector_scan(Context& ctx, Vector<T> data) {
+  T* out = nullptr;
+  auto result = new_window_output<T>(ctx, data.Size(), out);
+  using OPT = OperandType<T, op>;
+  HWY_EXPORT_T(Table, simd_vector_scan_impl<OPT>);
+  HWY_DYNAMIC_DISPATCH_T(Table)(data.Data(), out, data.Size());
+  return result;
+}
+
+template <typename T>
+Vector<T> simd_vector_cumsum(Context& ctx, Vector<T> data) {
+  return simd_vector_scan<T, OP_PLUS>(ctx, data);
+}
+template <typename T>
+Vector<T> simd_vector_cummax(Context& ctx, Vector<T> data) {
+  return simd_vector_scan<T, OP_MAX>(ctx, data);
+}
+template <typename T>
+Vector<T> simd_vector_cummin(Context& ctx, Vector<T> data) {
+  return simd_vector_scan<T, OP_MIN>(ctx, data);
+}
+
+template <typename T>
+Vector<T> simd_vector_lag(Context& ctx, Vector<T> data, uint32_t n) {
+  T* out = nullptr;
+  auto result = new_window_output<T>(ctx, data.Size(), out);
+  size_t shift = std::min<size_t>(n, data.Size());
+  std::fill(out, out + shift, T{});
+  memcpy(out + shift, data.Data(), (data.Size() - shift) * sizeof(T));
+  return result;
+}
+template <typename T>
+Vector<T> simd_vector_lead(Context& ctx, Vector<T> data, uint32_t n) {
+  T* out = nullptr;
+  auto result = new_window_output<T>(ctx, data.Size(), out);
+  size_t shift = std::min<size_t>(n, data.Size());
+  memcpy(out, data.Data() + shift, (data.Size() - shift) * sizeof(T));
+  std::fill(out + data.Size() - shift, out + data.Size(), T{});
+  return result;
+}
+
+template <typename T>
+Vector<T> simd_vector_rolling_sum(Context& ctx, Vector<T> data, uint32_t window) {
+  if (window == 0) {
+    RAISE_LOGIC_ERR({}, "rolling window size must be greater than 0");
+  }
+  T* out = nullptr;
+  auto result = new_window_output<T>(ctx, data.Size(), out);
+  HWY_EXPORT_T(Table, simd_vector_rolling_sum_impl<T>);
+  HWY_DYNAMIC_DISPATCH_T(Table)(data.Data(), out, data.Size(), window);
+  return result;
+}
+template <typename T>
+Vector<T> simd_vector_rolling_avg(Context& ctx, Vector<T> data, uint32_t window) {
+  if (window == 0) {
+    RAISE_LOGIC_ERR({}, "rolling window size must be greater than 0");
+  }
+  T* out = nullptr;
+  auto result = new_window_output<T>(ctx, data.Size(), out);
+  HWY_EXPORT_T(Table, simd_vector_rolling_avg_impl<T>);
+  HWY_DYNAMIC_DISPATCH_T(Table)(data.Data(), out, data.Size(), window);
+  return result;
+}
+
+template <typename T>
+static Vector<uint32_t> simd_vector_rank_impl(Context& ctx, Vector<T> data, bool dense) {
+  uint32_t* out = nullptr;
+  auto result = new_window_output<uint32_t>(ctx, data.Size(), out);
+  // mark the start of each run of equal values, then rank is a running max of the run start position and
+  // dense_rank a running count of runs.
+  for (size_t i = 0; i < data.Size(); i++) {
+    bool head = (i == 0 || data[i] != data[i - 1]);
+    out[i] = dense ? static_cast<uint32_t>(head) : (head ? static_cast<uint32_t>(i + 1) : 0);
+  }
+  if (dense) {
+    using OPT = OperandType<uint32_t, OP_PLUS>;
+    HWY_EXPORT_T(Table, simd_vector_scan_impl<OPT>);
+    HWY_DYNAMIC_DISPATCH_T(Table)(out, out, data.Size());
+  } else {
+    using OPT = OperandType<uint32_t, OP_MAX>;
+    HWY_EXPORT_T(Table, simd_vector_scan_impl<OPT>);
+    HWY_DYNAMIC_DISPATCH_T(Table)(out, out, data.Size());
+  }
+  return result;
+}
+
+template <typename T>
+Vector<uint32_t> simd_vector_rank(Context& ctx, Vector<T> data) {
+  return simd_vector_rank_impl(ctx, data, false);
+}
+template <typename T>
+Vector<uint32_t> simd_vector_dense_rank(Context& ctx, Vector<T> data) {
+  return simd_vector_rank_impl(ctx, data, true);
+}
+Vector<uint32_t> simd_vector_row_number(Context& ctx, uint32_t n) {
+  return simd_vector_iota<uint32_t>(ctx, 1, n);
+}
+
+#define DEFINE_SIMD_SCAN_OP_TEMPLATE(r, op, ii, TYPE)                              \
+  template Vector<TYPE> simd_vector_cumsum(Context&, Vector<TYPE>);                \
+  template Vector<TYPE> simd_vector_cummax(Context&, Vector<TYPE>);                \
+  template Vector<TYPE> simd_vector_cummin(Context&, Vector<TYPE>);                \
+  template Vector<TYPE> simd_vector_lag(Context&, Vector<TYPE>, uint32_t);         \
+  template Vector<TYPE> simd_vector_lead(Context&, Vector<TYPE>, uint32_t);        \
+  template Vector<TYPE> simd_vector_rolling_sum(Context&, Vector<TYPE>, uint32_t); \
+  template Vector<uint32_t> simd_vector_rank(Context&, Vector<TYPE>);              \
+  template Vector<uint32_t> simd_vector_dense_rank(Context&, Vector<TYPE>);
+#define DEFINE_SIMD_SCAN_OP(...) \
+  BOOST_PP_SEQ_FOR_EACH_I(DEFINE_SIMD_SCAN_OP_TEMPLATE, op, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
+DEFINE_SIMD_SCAN_OP(float, double, uint64_t, int64_t, uint32_t, int32_t);
+
+#define DEFINE_SIMD_ROLLING_AVG_OP_TEMPLATE(r, op, ii, TYPE) \
+  template Vector<TYPE> simd_vector_rolling_avg(Context&, Vector<TYPE>, uint32_t);
+#define DEFINE_SIMD_ROLLING_AVG_OP(...) \
+  BOOST_PP_SEQ_FOR_EACH_I(DEFINE_SIMD_ROLLING_AVG_OP_TEMPLATE, op, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
+DEFINE_SIMD_ROLLING_AVG_OP(float, double);
+
+#define DEFINE_SIMD_RANK_OP_TEMPLATE(r, op, ii, TYPE)                 \
+  template Vector<uint32_t> simd_vector_rank(Context&, Vector<TYPE>); \
+  template Vector<uint32_t> simd_vector_dense_rank(Context&, Vector<TYPE>);
+#define DEFINE_SIMD_RANK_OP(...) \
+  BOOST_PP_SEQ_FOR_EACH_I(DEFINE_SIMD_RANK_OP_TEMPLATE, op, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
+DEFINE_SIMD_RANK_OP(StringView);
+
+}  // namespace functions
+}  // namespace rapidudf
+#endif  // HWY_ONCE
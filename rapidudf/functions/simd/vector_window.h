@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "rapidudf/context/context.h"
+#include "rapidudf/meta/optype.h"
+#include "rapidudf/types/vector.h"
+namespace rapidudf {
+namespace functions {
+template <typename T>
+Vector<T> simd_vector_cumsum(Context& ctx, Vector<T> data);
+template <typename T>
+Vector<T> simd_vector_cummax(Context& ctx, Vector<T> data);
+template <typename T>
+Vector<T> simd_vector_cummin(Context& ctx, Vector<T> data);
+
+/**
+** lag/lead shift values by `n` positions, filling vacated slots with zero.
+*/
+template <typename T>
+Vector<T> simd_vector_lag(Context& ctx, Vector<T> data, uint32_t n);
+template <typename T>
+Vector<T> simd_vector_lead(Context& ctx, Vector<T> data, uint32_t n);
+
+/**
+** rolling sum/avg over the trailing `window` values, the first `window-1` rows use the partial window.
+*/
+template <typename T>
+Vector<T> simd_vector_rolling_sum(Context& ctx, Vector<T> data, uint32_t window);
+template <typename T>
+Vector<T> simd_vector_rolling_avg(Context& ctx, Vector<T> data, uint32_t window);
+
+/**
+** rank/dense_rank over the current order of `data`, equal adjacent values share a rank(1-based).
+*/
+template <typename T>
+Vector<uint32_t> simd_vector_rank(Context& ctx, Vector<T> data);
+template <typename T>
+Vector<uint32_t> simd_vector_dense_rank(Context& ctx, Vector<T> data);
+Vector<uint32_t> simd_vector_row_number(Context& ctx, uint32_t n);
+}  // namespace functions
+}  // namespace rapidudf
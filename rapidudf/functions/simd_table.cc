@@ -14,10 +14,15 @@
  * limitations under the License.
  */
 #include <stdexcept>
+#include <string>
 #include <tuple>
+#include <vector>
+
+#include "absl/strings/str_split.h"
 
 #include "rapidudf/functions/names.h"
 #include "rapidudf/meta/dtype_enums.h"
+#include "rapidudf/meta/exception.h"
 #include "rapidudf/meta/function.h"
 #include "rapidudf/reflect/struct.h"
 #include "rapidudf/table/table.h"
@@ -51,6 +56,37 @@ struct SimdTableHelper {
     return table->Topk(by, k, descending);
   }
   /**
+  **   Topk on rows selected by bits, without filtering the whole table first.
+  */
+  template <typename T>
+  static table::Table* topk_filter(table::Table* table, Vector<T> by, uint32_t k, bool descending, Vector<Bit> bits) {
+    return table->Topk(by, k, descending, bits);
+  }
+  /**
+  **   Reorder rows to keep at most max_per_window rows of same category in every window rows.
+  */
+  static table::Table* diversify(table::Table* table, StringView column, uint32_t window, uint32_t max_per_window) {
+    return table->Diversify(column, window, max_per_window);
+  }
+  /**
+  **   Select k rows by maximal marginal relevance with row-major flatten embeddings.
+  */
+  template <typename T>
+  static table::Table* mmr(table::Table* table, Vector<T> scores, Vector<T> embeddings, uint32_t k, T lambda) {
+    return table->Mmr(scores, embeddings, k, lambda);
+  }
+  /**
+  **   Shuffle rows by seed & request id of context.
+  */
+  static table::Table* shuffle(table::Table* table, uint64_t seed) { return table->Shuffle(seed); }
+  /**
+  **   Sample k rows without replacement by weights.
+  */
+  template <typename T>
+  static table::Table* weighted_sample(table::Table* table, Vector<T> weights, uint32_t k, uint64_t seed) {
+    return table->WeightedSample(weights, k, seed);
+  }
+  /**
   **   Returns the first num rows as a list of Row.
   */
   static table::Table* head(table::Table* table, uint32_t k) { return table->Head(k); }
@@ -65,6 +101,16 @@ struct SimdTableHelper {
    */
   static uint32_t count(table::Table* table) { return table->Count(); }
 
+  /**
+   **   Returns 1-based row number over current table order
+   */
+  static Vector<uint32_t> row_number(table::Table* table) { return table->RowNumber(); }
+  /**
+   **   Returns rank/dense_rank of given column over current table order
+   */
+  static Vector<uint32_t> rank(table::Table* table, StringView column) { return table->Rank(column, false); }
+  static Vector<uint32_t> dense_rank(table::Table* table, StringView column) { return table->Rank(column, true); }
+
   /**
    **   Returns the first num rows as a list of Row.
    */
@@ -75,6 +121,21 @@ struct SimdTableHelper {
     return table->GroupBy(by);
   }
   static absl::Span<table::Table*> group_by_column(table::Table* table, StringView by) { return table->GroupBy(by); }
+  static absl::Span<table::Table*> partition(table::Table* table, Vector<uint32_t> bucket_ids, uint32_t n) {
+    return table->Partition(bucket_ids, n);
+  }
+
+  /**
+   **   Split string column by sep and parse parts into columns named by comma separated `names`.
+   */
+  static table::Table* split_to_columns(table::Table* table, StringView column, StringView sep, StringView names) {
+    std::vector<std::string> column_names = absl::StrSplit(names.get_absl_string_view(), ',', absl::SkipEmpty());
+    auto status = table->SplitToColumns(column.str(), sep, column_names);
+    if (!status.ok()) {
+      THROW_LOGIC_ERR("split_to_columns error:{}", status.ToString());
+    }
+    return table;
+  }
 
   template <typename T>
   static Vector<T> get_column(table::Table* table, uint32_t offset) {
@@ -82,13 +143,24 @@ struct SimdTableHelper {
   }
 
   static void Init() {
-    RUDF_STRUCT_HELPER_METHODS_BIND(SimdTableHelper, column_count, filter, head, tail, count, concat);
+    RUDF_STRUCT_HELPER_METHODS_BIND(SimdTableHelper, column_count, filter, head, tail, count, concat, row_number,
+                                    rank, dense_rank, diversify, shuffle, partition, split_to_columns);
     RUDF_STRUCT_HELPER_METHOD_BIND("topk_f32", topk<float>);
     RUDF_STRUCT_HELPER_METHOD_BIND("topk_f64", topk<double>);
     RUDF_STRUCT_HELPER_METHOD_BIND("topk_u32", topk<uint32_t>);
     RUDF_STRUCT_HELPER_METHOD_BIND("topk_i32", topk<int32_t>);
     RUDF_STRUCT_HELPER_METHOD_BIND("topk_u64", topk<uint64_t>);
     RUDF_STRUCT_HELPER_METHOD_BIND("topk_i64", topk<int64_t>);
+    RUDF_STRUCT_HELPER_METHOD_BIND("topk_filter_f32", topk_filter<float>);
+    RUDF_STRUCT_HELPER_METHOD_BIND("topk_filter_f64", topk_filter<double>);
+    RUDF_STRUCT_HELPER_METHOD_BIND("topk_filter_u32", topk_filter<uint32_t>);
+    RUDF_STRUCT_HELPER_METHOD_BIND("topk_filter_i32", topk_filter<int32_t>);
+    RUDF_STRUCT_HELPER_METHOD_BIND("topk_filter_u64", topk_filter<uint64_t>);
+    RUDF_STRUCT_HELPER_METHOD_BIND("topk_filter_i64", topk_filter<int64_t>);
+    RUDF_STRUCT_HELPER_METHOD_BIND("mmr_f32", mmr<float>);
+    RUDF_STRUCT_HELPER_METHOD_BIND("mmr_f64", mmr<double>);
+    RUDF_STRUCT_HELPER_METHOD_BIND("weighted_sample_f32", weighted_sample<float>);
+    RUDF_STRUCT_HELPER_METHOD_BIND("weighted_sample_f64", weighted_sample<double>);
 
     RUDF_STRUCT_HELPER_METHOD_BIND("order_by_f32", order_by<float>);
     RUDF_STRUCT_HELPER_METHOD_BIND("order_by_f64", order_by<double>);
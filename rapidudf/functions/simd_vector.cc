@@ -34,8 +34,10 @@ namespace rapidudf {
 namespace functions {
 
 static void throw_vector_expression_ex(int line, StringView src_line, StringView msg) {
-  throw VectorExpressionException(line, src_line, msg);
+  RUDF_RAISE_ERR(kVectorExpression, , RUDF_THROW_ERR(kVectorExpression, VectorExpressionException(line, src_line, msg)),
+                 std::string(VectorExpressionException(line, src_line, msg).what()));
 }
+static int32_t* get_error_code() { return &GetErrorSlot().code; }
 
 template <typename T>
 static Vector<T> new_simd_vector(Context& ctx, uint32_t n) {
@@ -53,21 +55,24 @@ static void register_unary_simd_vector_op() {
   DType dtype = get_dtype<T>();
   std::string func_name = GetFunctionName(op, dtype.ToSimdVector());
   void (*simd_f)(const T*, T*) = simd_vector_unary_op<T, op>;
-  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_f);
+  void* (*resolve_f)() = resolve_simd_vector_unary_op<T, op>;
+  RUDF_FUNC_REGISTER_WITH_RESOLVER(func_name.c_str(), simd_f, resolve_f);
 }
 template <typename T, OpToken op>
 static void register_binary_simd_vector_op() {
   DType dtype = get_dtype<T>();
   std::string func_name = GetFunctionName(op, dtype.ToSimdVector());
   void (*simd_f)(const T*, const T*, T*) = simd_vector_binary_op<T, op>;
-  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_f);
+  void* (*resolve_f)() = resolve_simd_vector_binary_op<T, op>;
+  RUDF_FUNC_REGISTER_WITH_RESOLVER(func_name.c_str(), simd_f, resolve_f);
 }
 template <typename T, OpToken op>
 static void register_ternary_simd_vector_op() {
   DType dtype = get_dtype<T>();
   std::string func_name = GetFunctionName(op, dtype.ToSimdVector());
   void (*simd_f)(const T*, const T*, const T*, T*) = simd_vector_ternary_op<T, op>;
-  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_f);
+  void* (*resolve_f)() = resolve_simd_vector_ternary_op<T, op>;
+  RUDF_FUNC_REGISTER_WITH_RESOLVER(func_name.c_str(), simd_f, resolve_f);
 }
 
 template <typename T>
@@ -113,6 +118,118 @@ static void register_simd_vector_gather() {
   RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_f0);
 }
 
+template <typename T>
+static void register_simd_vector_window() {
+  DType dtype = get_dtype<T>().ToSimdVector();
+  std::string func_name = GetFunctionName(OP_CUMSUM, dtype);
+  Vector<T> (*simd_f0)(Context&, Vector<T>) = simd_vector_cumsum<T>;
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_f0);
+
+  func_name = GetFunctionName(OP_CUMMAX, dtype);
+  Vector<T> (*simd_f1)(Context&, Vector<T>) = simd_vector_cummax<T>;
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_f1);
+
+  func_name = GetFunctionName(OP_CUMMIN, dtype);
+  Vector<T> (*simd_f2)(Context&, Vector<T>) = simd_vector_cummin<T>;
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_f2);
+
+  func_name = GetFunctionName(OP_LAG, dtype);
+  Vector<T> (*simd_f3)(Context&, Vector<T>, uint32_t) = simd_vector_lag<T>;
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_f3);
+
+  func_name = GetFunctionName(OP_LEAD, dtype);
+  Vector<T> (*simd_f4)(Context&, Vector<T>, uint32_t) = simd_vector_lead<T>;
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_f4);
+
+  func_name = GetFunctionName(OP_ROLLING_SUM, dtype);
+  Vector<T> (*simd_f5)(Context&, Vector<T>, uint32_t) = simd_vector_rolling_sum<T>;
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_f5);
+
+  if constexpr (std::is_floating_point_v<T>) {
+    func_name = GetFunctionName(OP_ROLLING_AVG, dtype);
+    Vector<T> (*simd_f6)(Context&, Vector<T>, uint32_t) = simd_vector_rolling_avg<T>;
+    RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_f6);
+  }
+}
+
+template <typename T>
+static void register_simd_vector_rank() {
+  DType dtype = get_dtype<T>().ToSimdVector();
+  std::string func_name = GetFunctionName(OP_RANK, dtype);
+  Vector<uint32_t> (*simd_f0)(Context&, Vector<T>) = simd_vector_rank<T>;
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_f0);
+
+  func_name = GetFunctionName(OP_DENSE_RANK, dtype);
+  Vector<uint32_t> (*simd_f1)(Context&, Vector<T>) = simd_vector_dense_rank<T>;
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_f1);
+}
+
+template <typename T>
+static void register_simd_vector_hash() {
+  DType dtype = get_dtype<T>().ToSimdVector();
+  std::string func_name = GetFunctionName(OP_HASH, dtype);
+  Vector<uint64_t> (*simd_f0)(Context&, Vector<T>) = simd_vector_hash<T>;
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_f0);
+}
+
+template <typename T>
+static void register_simd_vector_bucketize() {
+  DType dtype = get_dtype<T>().ToSimdVector();
+  std::string func_name = GetFunctionName(OP_BUCKETIZE, dtype);
+  Vector<uint32_t> (*simd_f0)(Context&, Vector<T>, Vector<T>) = simd_vector_bucketize<T>;
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_f0);
+}
+
+static void register_simd_vector_hash_bucket() {
+  DType dtype = get_dtype<uint64_t>().ToSimdVector();
+  std::string func_name = GetFunctionName(OP_HASH_COMBINE, dtype);
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_vector_hash_combine);
+  func_name = GetFunctionName(OP_MOD_BUCKET, dtype);
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_vector_mod_bucket);
+}
+
+template <typename T>
+static void register_simd_vector_to_f32() {
+  DType dtype = get_dtype<T>().ToSimdVector();
+  std::string func_name = GetFunctionName(OP_TO_F32, dtype);
+  Vector<float> (*simd_f0)(Context&, Vector<T>) = simd_vector_to_f32<T>;
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_f0);
+}
+
+static void register_simd_vector_convert() {
+  DType f32_dtype = get_dtype<float>().ToSimdVector();
+  std::string func_name = GetFunctionName(OP_TO_F16, f32_dtype);
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_vector_to_f16);
+  func_name = GetFunctionName(OP_TO_BF16, f32_dtype);
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_vector_to_bf16);
+  func_name = GetFunctionName(OP_QUANTIZE, f32_dtype);
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_vector_quantize);
+  func_name = GetFunctionName(OP_DEQUANTIZE, get_dtype<int8_t>().ToSimdVector());
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_vector_dequantize);
+}
+
+static void register_simd_vector_time() {
+  DType dtype = get_dtype<int64_t>().ToSimdVector();
+  std::string func_name = GetFunctionName(OP_HOUR_OF_DAY, dtype);
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_vector_hour_of_day);
+  func_name = GetFunctionName(OP_DAY_OF_WEEK, dtype);
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_vector_day_of_week);
+  func_name = GetFunctionName(OP_DAYS_SINCE, dtype);
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_vector_days_since);
+  func_name = GetFunctionName(OP_TZ_OFFSET, dtype);
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_vector_tz_offset);
+}
+
+static void register_simd_vector_random() {
+  DType dtype = get_dtype<uint64_t>().ToSimdVector();
+  std::string func_name = GetFunctionName(OP_RAND_UNIFORM, dtype);
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_vector_rand_uniform);
+  func_name = GetFunctionName(OP_RAND_NORMAL, dtype);
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_vector_rand_normal);
+  func_name = GetFunctionName(OP_RAND_BERNOULLI, dtype);
+  RUDF_FUNC_REGISTER_WITH_NAME(func_name.c_str(), simd_vector_rand_bernoulli);
+}
+
 template <typename T>
 static void register_simd_vector_sort() {
   DType dtype = get_dtype<T>();
@@ -182,8 +299,9 @@ static void register_simd_vector_key_value_sort() {
 
 void init_builtin_simd_vector_funcs() {
   RUDF_FUNC_REGISTER_WITH_NAME(kBuiltinThrowVectorExprEx, throw_vector_expression_ex);
+  RUDF_FUNC_REGISTER_WITH_NAME(kBuiltinErrorCode, get_error_code);
   REGISTER_SIMD_VECTOR_FUNCS(register_new_simd_vector, float, double, long double, int64_t, int32_t, int16_t, int8_t,
-                             uint64_t, uint32_t, uint16_t, uint8_t, Bit, StringView)
+                             uint64_t, uint32_t, uint16_t, uint8_t, Bit, StringView, Float16, BFloat16)
   REGISTER_SIMD_VECTOR_FUNCS(register_simd_vector_dot, float, double)
   REGISTER_SIMD_VECTOR_FUNCS(register_simd_vector_iota, float, double, int64_t, int32_t, uint64_t, uint32_t)
   REGISTER_SIMD_VECTOR_FUNCS(register_simd_vector_sum, float, double, int64_t, int32_t, uint64_t, uint32_t)
@@ -191,8 +309,18 @@ void init_builtin_simd_vector_funcs() {
                              uint32_t, uint16_t, uint8_t, StringView, Bit)
   REGISTER_SIMD_VECTOR_FUNCS(register_simd_vector_gather, float, double, int64_t, int32_t, int16_t, int8_t, uint64_t,
                              uint32_t, uint16_t, uint8_t, StringView, Bit)
+  REGISTER_SIMD_VECTOR_FUNCS(register_simd_vector_window, float, double, int64_t, int32_t, uint64_t, uint32_t)
+  REGISTER_SIMD_VECTOR_FUNCS(register_simd_vector_rank, float, double, int64_t, int32_t, uint64_t, uint32_t,
+                             StringView)
   REGISTER_SIMD_VECTOR_FUNCS(register_simd_vector_sort, float, double, int64_t, int32_t, int16_t, uint64_t, uint32_t,
                              uint16_t);
+  REGISTER_SIMD_VECTOR_FUNCS(register_simd_vector_hash, uint64_t, int64_t, uint32_t, int32_t, StringView)
+  REGISTER_SIMD_VECTOR_FUNCS(register_simd_vector_bucketize, float, double, int64_t, int32_t, uint64_t, uint32_t)
+  register_simd_vector_hash_bucket();
+  REGISTER_SIMD_VECTOR_FUNCS(register_simd_vector_to_f32, Float16, BFloat16)
+  register_simd_vector_convert();
+  register_simd_vector_time();
+  register_simd_vector_random();
 
   BOOST_PP_SEQ_FOR_EACH_PRODUCT(RUDF_SIMD_VECTOR_SORT_KV_REGISTER, (KEY_VALUE_SORT_DTYPES)(KEY_VALUE_SORT_DTYPES))
 
@@ -20,6 +20,8 @@
 #include <string_view>
 
 #include "rapidudf/functions/names.h"
+#include "rapidudf/functions/simd/string.h"
+#include "rapidudf/functions/simd/string_match.h"
 #include "rapidudf/log/log.h"
 #include "rapidudf/meta/dtype_enums.h"
 #include "rapidudf/meta/function.h"
@@ -82,6 +84,8 @@ struct StringViewHelper {
   static bool ends_with_ignore_case(StringView s, StringView part) {
     return StringView::ends_with_ignore_case(s, part);
   }
+  static bool like(StringView s, StringView pattern) { return string_like(s, pattern); }
+  static bool regex_match(StringView s, StringView pattern) { return string_regex_match(s, pattern); }
 };
 
 struct StdStringViewHelper {
@@ -90,7 +94,7 @@ struct StdStringViewHelper {
 
 void init_builtin_strings_funcs() {
   RUDF_STRUCT_HELPER_METHODS_BIND(StringViewHelper, size, contains, starts_with, ends_with, contains_ignore_case,
-                                  starts_with_ignore_case, ends_with_ignore_case)
+                                  starts_with_ignore_case, ends_with_ignore_case, like, regex_match)
   RUDF_STRUCT_HELPER_METHODS_BIND(StdStringViewHelper, size)
   RUDF_FUNC_REGISTER_WITH_NAME(kBuiltinStringViewCmp, compare_string_view);
 
@@ -99,6 +103,13 @@ void init_builtin_strings_funcs() {
   RUDF_FUNC_REGISTER_WITH_NAME(kBuiltinCastStdStrViewToStringView, cast_stdstrview_to_string_view);
 
   register_string_view_vector_cmp_func();
+
+  RUDF_FUNC_REGISTER_WITH_NAME("split", simd_string_split);
+  RUDF_FUNC_REGISTER_WITH_NAME("split_part", simd_vector_split_part);
+  RUDF_FUNC_REGISTER_WITH_NAME("to_int", simd_vector_to_int);
+  RUDF_FUNC_REGISTER_WITH_NAME("to_float", simd_vector_to_float);
+  RUDF_FUNC_REGISTER_WITH_NAME("like", simd_vector_like);
+  RUDF_FUNC_REGISTER_WITH_NAME("regex_match", simd_vector_regex_match);
 }
 }  // namespace functions
 
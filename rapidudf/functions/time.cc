@@ -18,6 +18,7 @@
 #include <time.h>
 #include <cstdint>
 
+#include "rapidudf/context/context.h"
 #include "rapidudf/meta/function.h"
 
 namespace rapidudf {
@@ -35,10 +36,18 @@ static uint64_t now_us() {
 static uint64_t now_ms() { return now_us() / 1000; }
 static uint64_t now_s() { return now_us() / 1000000; }
 
+// request scoped time, captured once per context
+static uint64_t ctx_now_us(Context& ctx) { return static_cast<uint64_t>(ctx.NowUs()); }
+static uint64_t ctx_now_ms(Context& ctx) { return static_cast<uint64_t>(ctx.NowUs() / 1000); }
+static uint64_t ctx_now_s(Context& ctx) { return static_cast<uint64_t>(ctx.NowUs() / 1000000); }
+
 void init_builtin_time_funcs() {
   RUDF_FUNC_REGISTER(now_us);
   RUDF_FUNC_REGISTER(now_ms);
   RUDF_FUNC_REGISTER(now_s);
+  RUDF_FUNC_REGISTER(ctx_now_us);
+  RUDF_FUNC_REGISTER(ctx_now_ms);
+  RUDF_FUNC_REGISTER(ctx_now_s);
 }
 }  // namespace functions
 }  // namespace rapidudf
\ No newline at end of file
@@ -36,8 +36,11 @@ void DTypeFactory::Visit(std::function<void(const std::string&, DType)>&& f) {
   for (uint32_t t = DATA_U8; t <= DATA_STRING_VIEW; t++) {
     f(std::string(kFundamentalTypeStrs[t]), static_cast<FundamentalType>(t));
   }
+  f(std::string(kFundamentalTypeStrs[DATA_BF16]), DATA_BF16);
 }
 
+size_t DTypeFactory::Size() { return getNameDTypeMap().size(); }
+
 std::string_view DTypeFactory::GetNameByDType(DType dtype) {
   if (dtype.IsPtr() || dtype.IsCollection()) {
     return "";
@@ -122,6 +125,8 @@ bool DType::IsSigned() const {
     case DATA_I16:
     case DATA_I32:
     case DATA_I64:
+    case DATA_F16:
+    case DATA_BF16:
     case DATA_F32:
     case DATA_F64: {
       return true;
@@ -371,7 +376,9 @@ uint32_t DType::ByteSize() const {
       return 1;
     }
     case DATA_U16:
-    case DATA_I16: {
+    case DATA_I16:
+    case DATA_F16:
+    case DATA_BF16: {
       return 2;
     }
     case DATA_U32:
@@ -401,6 +408,9 @@ bool DType::Equal(const uint8_t* left, const uint8_t* right) const {
     case DATA_I8: {
       return *left == *right;
     }
+    // half floats are compared by bits, so NaN equals itself
+    case DATA_F16:
+    case DATA_BF16:
     case DATA_U16:
     case DATA_I16: {
       return *(reinterpret_cast<const uint16_t*>(left)) == *(reinterpret_cast<const uint16_t*>(right));
@@ -437,6 +447,8 @@ size_t DType::Hash(const uint8_t* data) const {
     case DATA_I8: {
       return *data;
     }
+    case DATA_F16:
+    case DATA_BF16:
     case DATA_U16:
     case DATA_I16: {
       return *(reinterpret_cast<const uint16_t*>(data));
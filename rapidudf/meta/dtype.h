@@ -41,6 +41,7 @@
 #include "rapidudf/meta//dtype_enums.h"
 #include "rapidudf/meta/type_traits.h"
 #include "rapidudf/types/dyn_object.h"
+#include "rapidudf/types/float16.h"
 #include "rapidudf/types/json_object.h"
 #include "rapidudf/types/pointer.h"
 #include "rapidudf/types/string_view.h"
@@ -83,14 +84,21 @@ class DType {
   bool IsPtr() const { return ctrl_.ptr_bit_ == 1; }
   bool IsIntegerPtr() const { return IsPtr() && (PtrTo().IsInteger()); }
   bool IsSimdVectorBit() const { return ctrl_.container_type_ == COLLECTION_SIMD_VECTOR && ctrl_.t0_ == DATA_BIT; }
-  bool IsPrimitive() const { return IsFundamental() && (ctrl_.t0_ >= DATA_BIT && ctrl_.t0_ <= DATA_STRING_VIEW); }
+  bool IsPrimitive() const {
+    return IsFundamental() && ((ctrl_.t0_ >= DATA_BIT && ctrl_.t0_ <= DATA_STRING_VIEW) || ctrl_.t0_ == DATA_BF16);
+  }
   bool IsFundamental() const { return ctrl_.ptr_bit_ == 0 && ctrl_.container_type_ == 0; }
-  bool IsNumber() const { return IsFundamental() && (ctrl_.t0_ >= DATA_U8 && ctrl_.t0_ <= DATA_F80); }
+  bool IsNumber() const {
+    return IsFundamental() && ((ctrl_.t0_ >= DATA_U8 && ctrl_.t0_ <= DATA_F80) || ctrl_.t0_ == DATA_BF16);
+  }
   bool IsF16() const { return IsFundamental() && ctrl_.t0_ == DATA_F16; }
+  bool IsBF16() const { return IsFundamental() && ctrl_.t0_ == DATA_BF16; }
+  // storage only float types, widened to f32 to compute
+  bool IsHalfFloat() const { return IsF16() || IsBF16(); }
   bool IsF32() const { return IsFundamental() && ctrl_.t0_ == DATA_F32; }
   bool IsF64() const { return IsFundamental() && ctrl_.t0_ == DATA_F64; }
   bool IsF80() const { return IsFundamental() && ctrl_.t0_ == DATA_F80; }
-  bool IsFloat() const { return IsF16() || IsF32() || IsF64() || IsF80(); }
+  bool IsFloat() const { return IsF16() || IsBF16() || IsF32() || IsF64() || IsF80(); }
   bool IsInteger() const { return IsFundamental() && (ctrl_.t0_ >= DATA_U8 && ctrl_.t0_ <= DATA_I64); }
   bool IsI64() const { return IsFundamental() && (ctrl_.t0_ == DATA_I64); }
   bool IsU64() const { return IsFundamental() && (ctrl_.t0_ == DATA_U64); }
@@ -200,6 +208,8 @@ class DTypeFactory {
   static DType GetDTypeByName(const std::string& name);
   static std::string_view GetNameByDType(DType dtype);
   static void Visit(std::function<void(const std::string&, DType)>&& f);
+  // number of registered named dtypes, only grows
+  static size_t Size();
 
   template <typename T>
   static bool Add(const std::string& name) {
@@ -493,6 +503,12 @@ DType get_dtype() {
   if constexpr (std::is_same_v<long double, T>) {
     return DType(DATA_F80);
   }
+  if constexpr (std::is_same_v<Float16, T>) {
+    return DType(DATA_F16);
+  }
+  if constexpr (std::is_same_v<BFloat16, T>) {
+    return DType(DATA_BF16);
+  }
   if constexpr (std::is_same_v<std::string_view, T>) {
     return DType(DATA_STD_STRING_VIEW);
   }
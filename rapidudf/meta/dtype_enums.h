@@ -62,6 +62,8 @@ enum FundamentalType {
   DATA_CONTEXT,
   DATA_DYN_OBJECT,
   DATA_TABLE,
+  // appended to keep ids of existing types unchanged
+  DATA_BF16,
   DATA_BUILTIN_TYPE_END,
   // DATA_SIMD_COLUMN,
 
@@ -103,5 +105,6 @@ constexpr std::array<std::string_view, DATA_BUILTIN_TYPE_END> kFundamentalTypeSt
                                                                                       "json",
                                                                                       "Context",
                                                                                       "dyn_obj",
-                                                                                      "table"};
+                                                                                      "table",
+                                                                                      "bf16"};
 }  // namespace rapidudf
\ No newline at end of file
@@ -16,10 +16,14 @@
 
 #pragma once
 
+#include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include "absl/status/status.h"
 #include "fmt/format.h"
 #include "rapidudf/log/log.h"
+#include "rapidudf/metrics/metrics.h"
 #include "rapidudf/types/string_view.h"
 
 namespace rapidudf {
@@ -53,30 +57,176 @@ class VectorExpressionException : public UDFRuntimeException {
   explicit VectorExpressionException(int line, StringView src_line, StringView msg)
       : UDFRuntimeException(fmt::format("Error:{} occurred at line:{}, source ' {} '", msg, line, src_line)) {}
 };
+
+enum class ErrorCode : int32_t {
+  kOk = 0,
+  kLogic,
+  kNullPointer,
+  kReadonly,
+  kSizeMismatch,
+  kOutOfRange,
+  kVectorExpression,
+  kUnknown,
+};
+static_assert(static_cast<size_t>(ErrorCode::kUnknown) == metrics::kExceptionTypeNum,
+              "metrics exception types mismatch with ErrorCode");
+
+/**
+** Per thread error slot of the no-throw execution mode.
+** While `no_throw` is set, builtins record the first error here instead of throwing, jit code compiled with
+** `Options::no_throw` loads `code` after every call and returns early once it's not zero.
+*/
+struct ErrorSlot {
+  int32_t code = 0;
+  bool no_throw = false;
+  std::string msg;
+
+  template <typename F>
+  void Raise(ErrorCode err, F&& get_msg) {
+    metrics::count_exception(static_cast<int32_t>(err));
+    if (code == 0) {
+      code = static_cast<int32_t>(err);
+      msg = get_msg();
+    }
+  }
+  void Clear() {
+    code = 0;
+    msg.clear();
+  }
+  absl::Status TakeStatus() {
+    if (code == 0) {
+      return absl::OkStatus();
+    }
+    absl::Status status = ToStatus(static_cast<ErrorCode>(code), msg);
+    Clear();
+    return status;
+  }
+  static absl::Status ToStatus(ErrorCode err, const std::string& msg) {
+    switch (err) {
+      case ErrorCode::kOk: {
+        return absl::OkStatus();
+      }
+      case ErrorCode::kNullPointer:
+      case ErrorCode::kReadonly: {
+        return absl::FailedPreconditionError(msg);
+      }
+      case ErrorCode::kLogic:
+      case ErrorCode::kSizeMismatch:
+      case ErrorCode::kVectorExpression: {
+        return absl::InvalidArgumentError(msg);
+      }
+      case ErrorCode::kOutOfRange: {
+        return absl::OutOfRangeError(msg);
+      }
+      default: {
+        return absl::InternalError(msg);
+      }
+    }
+  }
+};
+
+/**
+** Status of a `UDFRuntimeException` with the same code as the no-throw mode, other exceptions are internal errors.
+*/
+inline absl::Status ExceptionToStatus(const std::exception& ex) {
+  ErrorCode err = ErrorCode::kUnknown;
+  if (dynamic_cast<const NullPointerException*>(&ex) != nullptr) {
+    err = ErrorCode::kNullPointer;
+  } else if (dynamic_cast<const ReadonlyException*>(&ex) != nullptr) {
+    err = ErrorCode::kReadonly;
+  } else if (dynamic_cast<const SizeMismatchException*>(&ex) != nullptr) {
+    err = ErrorCode::kSizeMismatch;
+  } else if (dynamic_cast<const OutOfRangeException*>(&ex) != nullptr) {
+    err = ErrorCode::kOutOfRange;
+  } else if (dynamic_cast<const VectorExpressionException*>(&ex) != nullptr) {
+    err = ErrorCode::kVectorExpression;
+  }
+  return ErrorSlot::ToStatus(err, ex.what());
+}
+
+inline ErrorSlot& GetErrorSlot() {
+  static thread_local ErrorSlot slot;
+  return slot;
+}
+
+/**
+** Enables the no-throw mode of current thread in scope.
+*/
+class NoThrowScope {
+ public:
+  NoThrowScope() : slot_(GetErrorSlot()), prev_(slot_.no_throw) {
+    slot_.no_throw = true;
+    slot_.Clear();
+  }
+  ~NoThrowScope() { slot_.no_throw = prev_; }
+
+ private:
+  ErrorSlot& slot_;
+  bool prev_;
+};
 }  // namespace rapidudf
 
-#define THROW_LOGIC_ERR(...)                          \
-  do {                                                \
-    RUDF_ERROR(__VA_ARGS__);                          \
-    throw std::logic_error(fmt::format(__VA_ARGS__)); \
+/**
+** Throw `ex` and count it into the builtin metrics by `ErrorCode::code`.
+*/
+#define RUDF_THROW_ERR(code, ex)                                                             \
+  do {                                                                                       \
+    ::rapidudf::metrics::count_exception(static_cast<int32_t>(::rapidudf::ErrorCode::code)); \
+    throw ex;                                                                                \
   } while (0)
 
-#define THROW_NULL_POINTER_ERR(msg)                                                               \
-  do {                                                                                            \
-    throw rapidudf::NullPointerException(fmt::format("{}:{} error:{}", __FILE__, __LINE__, msg)); \
+#define THROW_LOGIC_ERR(...)                                            \
+  do {                                                                  \
+    RUDF_ERROR(__VA_ARGS__);                                            \
+    RUDF_THROW_ERR(kLogic, std::logic_error(fmt::format(__VA_ARGS__))); \
   } while (0)
 
-#define THROW_READONLY_ERR(msg)                                                                \
-  do {                                                                                         \
-    throw rapidudf::ReadonlyException(fmt::format("{}:{} error:{}", __FILE__, __LINE__, msg)); \
-  } while (0)
+#define THROW_NULL_POINTER_ERR(msg) \
+  RUDF_THROW_ERR(kNullPointer,      \
+                 rapidudf::NullPointerException(fmt::format("{}:{} error:{}", __FILE__, __LINE__, msg)))
 
-#define THROW_SIZE_MISMATCH_ERR(current, expect)                                                      \
-  do {                                                                                                \
-    throw rapidudf::SizeMismatchException(current, expect, fmt::format("{}:{}", __FILE__, __LINE__)); \
-  } while (0)
+#define THROW_READONLY_ERR(msg) \
+  RUDF_THROW_ERR(kReadonly, rapidudf::ReadonlyException(fmt::format("{}:{} error:{}", __FILE__, __LINE__, msg)))
+
+#define THROW_SIZE_MISMATCH_ERR(current, expect) \
+  RUDF_THROW_ERR(kSizeMismatch,                  \
+                 rapidudf::SizeMismatchException(current, expect, fmt::format("{}:{}", __FILE__, __LINE__)))
+
+#define THROW_OUT_OF_RANGE_ERR(requested, limit) \
+  RUDF_THROW_ERR(kOutOfRange,                    \
+                 rapidudf::OutOfRangeException(requested, limit, fmt::format("{}:{}", __FILE__, __LINE__)))
 
-#define THROW_OUT_OF_RANGE_ERR(requested, limit)                                                     \
-  do {                                                                                               \
-    throw rapidudf::OutOfRangeException(requested, limit, fmt::format("{}:{}", __FILE__, __LINE__)); \
+/**
+** RAISE_XXX_ERR(ret, ...) throw like THROW_XXX_ERR, or record the error into the thread's error slot and
+** `return ret` in no-throw mode, `ret` is left empty in void functions.
+*/
+#define RUDF_RAISE_ERR(code, ret, throw_stmt, msg_expr)                           \
+  do {                                                                            \
+    auto& rudf_err_slot = ::rapidudf::GetErrorSlot();                             \
+    if (!rudf_err_slot.no_throw) {                                                \
+      throw_stmt;                                                                 \
+    }                                                                             \
+    rudf_err_slot.Raise(::rapidudf::ErrorCode::code, [&]() { return msg_expr; }); \
+    return ret;                                                                   \
   } while (0)
+
+#define RAISE_LOGIC_ERR(ret, ...) RUDF_RAISE_ERR(kLogic, ret, THROW_LOGIC_ERR(__VA_ARGS__), fmt::format(__VA_ARGS__))
+
+#define RAISE_NULL_POINTER_ERR(ret, msg)                        \
+  RUDF_RAISE_ERR(kNullPointer, ret, THROW_NULL_POINTER_ERR(msg), \
+                 fmt::format("{}:{} error:{}", __FILE__, __LINE__, msg))
+
+#define RAISE_READONLY_ERR(ret, msg) \
+  RUDF_RAISE_ERR(kReadonly, ret, THROW_READONLY_ERR(msg), fmt::format("{}:{} error:{}", __FILE__, __LINE__, msg))
+
+#define RAISE_SIZE_MISMATCH_ERR(ret, current, expect)                                                          \
+  RUDF_RAISE_ERR(                                                                                              \
+      kSizeMismatch, ret, THROW_SIZE_MISMATCH_ERR(current, expect),                                            \
+      std::string(                                                                                             \
+          rapidudf::SizeMismatchException(current, expect, fmt::format("{}:{}", __FILE__, __LINE__)).what()))
+
+#define RAISE_OUT_OF_RANGE_ERR(ret, requested, limit)                                                          \
+  RUDF_RAISE_ERR(                                                                                              \
+      kOutOfRange, ret, THROW_OUT_OF_RANGE_ERR(requested, limit),                                              \
+      std::string(                                                                                             \
+          rapidudf::OutOfRangeException(requested, limit, fmt::format("{}:{}", __FILE__, __LINE__)).what()))
@@ -45,6 +45,10 @@ std::string GetFunctionName(std::string_view op, DType dtype0, DType dtype1) {
   }
 }
 
+std::string GetVectorFunctionName(std::string_view name) {
+  return fmt::format("{}_{}", FunctionFactory::kSimdVectorFuncPrefix, name);
+}
+
 std::string GetMemberFuncName(DType dtype, const std::string& member) {
   std::string fname = fmt::format("{}_{}", dtype.GetTypeString(), member);
   return fname;
@@ -74,10 +78,16 @@ uint32_t FunctionDesc::GetOperandCount() const {
   if (is_vector_func) {
     n--;
   }
+  if (has_lanes_arg) {
+    n--;
+  }
   return n;
 }
 
 const DType& FunctionDesc::LastArg() const { return arg_types[arg_types.size() - 1]; }
+const DType& FunctionDesc::VectorOutputArg() const {
+  return has_lanes_arg ? arg_types[arg_types.size() - 2] : arg_types[arg_types.size() - 1];
+}
 bool FunctionDesc::PassArgByValue(size_t argno) const {
   if (argno >= arg_types.size()) {
     return false;
@@ -109,6 +119,9 @@ bool FunctionDesc::ValidateArgs(const std::vector<DType>& ts) const {
   if (is_vector_func) {
     verify_arg_size--;
   }
+  if (has_lanes_arg) {
+    verify_arg_size--;
+  }
   if (ts.size() != verify_arg_size) {
     RUDF_ERROR("Func:{} expect {} args, while only {} args given", verify_arg_size, ts.size());
     return false;
@@ -174,8 +187,15 @@ absl::Status FunctionFactory::RegisterVectorFunction(FunctionDesc&& desc) {
   //   RUDF_LOG_RETURN_FMT_ERROR("Vector function:{}'s first and last arg have different type:{}/{}", desc.name,
   //                             first_arg_dtype, last_arg_dtype);
   // }
-  for (auto& arg_dtype : desc.arg_types) {
-    if (!arg_dtype.IsPtr()) {
+  size_t ptr_args = desc.arg_types.size();
+  if (desc.has_lanes_arg) {
+    ptr_args--;
+    if (ptr_args < 2 || !desc.arg_types[ptr_args].IsU32()) {
+      RUDF_LOG_RETURN_FMT_ERROR("Vector function:{}'s last arg is not u32 lanes", desc.name);
+    }
+  }
+  for (size_t i = 0; i < ptr_args; i++) {
+    if (!desc.arg_types[i].IsPtr()) {
       RUDF_LOG_RETURN_FMT_ERROR("Vector function:{}'s  arg is not all pointer", desc.name);
     }
   }
@@ -22,6 +22,7 @@
 
 #include "rapidudf/log/log.h"
 #include "rapidudf/meta/dtype.h"
+#include "rapidudf/meta/exception.h"
 #include "rapidudf/meta/optype.h"
 
 namespace rapidudf {
@@ -36,6 +37,18 @@ constexpr uint64_t fnv1a_hash(const char* str) {
 }
 constexpr uint64_t fnv1a_hash(std::string_view str) { return fnv1a_hash(str.data()); }
 
+template <typename R>
+R null_member_func_call(const std::string& func_name) {
+  std::string msg = fmt::format("NULL object pointer to call member func:{}", func_name);
+  if constexpr (std::is_void_v<R>) {
+    RUDF_RAISE_ERR(kNullPointer, , RUDF_THROW_ERR(kNullPointer, std::logic_error(msg)), std::move(msg));
+  } else if constexpr (std::is_default_constructible_v<R>) {
+    RUDF_RAISE_ERR(kNullPointer, R{}, RUDF_THROW_ERR(kNullPointer, std::logic_error(msg)), std::move(msg));
+  } else {
+    RUDF_THROW_ERR(kNullPointer, std::logic_error(msg));
+  }
+}
+
 struct FunctionDesc {
   std::string name;
   // return types
@@ -43,15 +56,23 @@ struct FunctionDesc {
   // args types
   std::vector<DType> arg_types;
   void* func = nullptr;
+  // returns the implementation with same signature to call from jit code instead of `func`, e.g. the best target
+  // kernel of a highway dynamic dispatched function, invoked once when the jit symbol is bound.
+  void* (*resolve_func)() = nullptr;
   int context_arg_idx = -1;
   bool is_vector_func = false;
+  // vector func takes the live lane count of the block as the last arg, after the output pointer
+  bool has_lanes_arg = false;
 
   void Init();
+  void* GetJitFunc() const { return nullptr != resolve_func ? resolve_func() : func; }
   bool ValidateArgs(const std::vector<DType>& ts) const;
   bool CompareSignature(DType rtype, const std::vector<DType>& args_types) const;
 
   bool PassArgByValue(size_t i) const;
   const DType& LastArg() const;
+  // output pointer arg of vector func
+  const DType& VectorOutputArg() const;
   uint32_t GetOperandCount() const;
 };
 
@@ -78,10 +99,11 @@ class FunctionFactory {
   static const FunctionDesc* GetFunction(const std::string& name);
 
   template <typename... Args>
-  static absl::Status RegisterVectorFunction(std::string_view name, void (*f)(Args...)) {
+  static absl::Status RegisterVectorFunction(std::string_view name, void (*f)(Args...), bool has_lanes_arg = false) {
     FunctionDesc desc;
     desc.name = std::string(name);
     desc.func = reinterpret_cast<void*>(f);
+    desc.has_lanes_arg = has_lanes_arg;
     desc.return_type = DType(DATA_VOID);
     (desc.arg_types.emplace_back(get_function_arg_dtype<Args>()), ...);
     return RegisterVectorFunction(std::move(desc));
@@ -108,13 +130,24 @@ class FuncRegister {
     (desc.arg_types.emplace_back(get_function_arg_dtype<Args>()), ...);
     FunctionFactory::Register(std::move(desc));
   }
+  template <typename RET, typename... Args>
+  FuncRegister(std::string_view name, RET (*f)(Args...), void* (*resolve)()) {
+    static_assert(std::is_void_v<SAFE_WRAPPER>, "resolved function can not be wrapped");
+    FunctionDesc desc;
+    desc.name = std::string(name);
+    desc.func = reinterpret_cast<void*>(f);
+    desc.resolve_func = resolve;
+    desc.return_type = get_dtype<RET>();
+    (desc.arg_types.emplace_back(get_function_arg_dtype<Args>()), ...);
+    FunctionFactory::Register(std::move(desc));
+  }
 };
 
 class VectorFuncRegister {
  public:
   template <typename... Args>
-  VectorFuncRegister(std::string_view name, void (*f)(Args...)) {
-    auto status = FunctionFactory::RegisterVectorFunction(name, f);
+  VectorFuncRegister(std::string_view name, void (*f)(Args...), bool has_lanes_arg = false) {
+    auto status = FunctionFactory::RegisterVectorFunction(name, f, has_lanes_arg);
     if (!status.ok()) {
       RUDF_CRITICAL("Invalid func:{} with reason:{}", name, status.ToString());
     }
@@ -122,10 +155,29 @@ class VectorFuncRegister {
 };
 
 std::string GetMemberFuncName(DType dtype, const std::string& member);
+std::string GetVectorFunctionName(std::string_view name);
 std::string GetFunctionName(OpToken op, DType dtype);
 std::string GetFunctionName(OpToken op, DType dtype0, DType dtype1);
 std::string GetFunctionName(std::string_view op, DType dtype);
 
+/**
+** Lifts a scalar function into a vector kernel which loops the scalar func over the live lanes of one
+** `kVectorUnitSize` block, padding lanes of the tail block are never passed to the scalar func.
+** The scalar func is a template arg so the compiler could inline it into the loop.
+*/
+template <typename F, F f>
+struct ScalarVectorFunctionWrapper;
+template <typename R, typename... Args, R (*f)(Args...)>
+struct ScalarVectorFunctionWrapper<R (*)(Args...), f> {
+  template <typename T>
+  using lane_arg_t = std::conditional_t<std::is_pointer_v<T>, T*, const std::remove_cv_t<std::remove_reference_t<T>>*>;
+  static void Call(lane_arg_t<Args>... args, R* output, uint32_t lanes) {
+    for (uint32_t i = 0; i < lanes; i++) {
+      output[i] = f(args[i]...);
+    }
+  }
+};
+
 template <uint64_t, uint32_t, uint64_t, typename F>
 struct MemberFunctionWrapper;
 
@@ -143,7 +195,7 @@ struct MemberFunctionWrapper<SOURCE, LINE, HASH, R (T::*)(Args...)> {
   }
   static R Call(T* p, Args... args) {
     if (nullptr == p) {
-      throw std::logic_error(fmt::format("NULL object pointer to call member func:{}", GetFuncName()));
+      return null_member_func_call<R>(GetFuncName());
     }
     auto func = GetFunc();
     if constexpr (std::is_same_v<void, R>) {
@@ -167,7 +219,7 @@ struct MemberFunctionWrapper<SOURCE, LINE, HASH, R (T::*)(Args...) const> {
   }
   static R Call(const T* p, Args... args) {
     if (nullptr == p) {
-      throw std::logic_error(fmt::format("NULL object pointer to call member func:{}", GetFuncName()));
+      return null_member_func_call<R>(GetFuncName());
     }
     auto func = GetFunc();
     if constexpr (std::is_same_v<void, R>) {
@@ -240,7 +292,7 @@ struct FunctionWrapper<SOURCE, LINE, HASH, R (T::*)(Args...)> {
   }
   static R SafeCall(T* p, Args... args) {
     if (nullptr == p) {
-      throw std::logic_error(fmt::format("NULL object pointer to call member func:{}", GetFuncName()));
+      return null_member_func_call<R>(GetFuncName());
     }
     auto func = GetFunc();
     if constexpr (std::is_same_v<void, R>) {
@@ -265,7 +317,7 @@ struct FunctionWrapper<SOURCE, LINE, HASH, R (T::*)(Args...) const> {
   }
   static R SafeCall(const T* p, Args... args) {
     if (nullptr == p) {
-      throw std::logic_error(fmt::format("NULL object pointer to call member func:{}", GetFuncName()));
+      return null_member_func_call<R>(GetFuncName());
     }
     auto func = GetFunc();
     if constexpr (std::is_same_v<void, R>) {
@@ -310,9 +362,18 @@ struct FunctionWrapper<SOURCE, LINE, HASH, R (T::*)(Args...) const> {
 #define RUDF_VECTOR_FUNC_REGISTER(f) \
   static ::rapidudf::VectorFuncRegister BOOST_PP_CAT(rudf_reg_funcs_, __COUNTER__)(BOOST_PP_STRINGIZE(f), f);
 
+#define RUDF_SCALAR_VECTOR_FUNC_REGISTER(f)                                                                   \
+  RUDF_FUNC_REGISTER(f)                                                                                       \
+  static ::rapidudf::VectorFuncRegister BOOST_PP_CAT(rudf_reg_funcs_, __COUNTER__)(                           \
+      ::rapidudf::GetVectorFunctionName(BOOST_PP_STRINGIZE(f)),                                               \
+      &::rapidudf::ScalarVectorFunctionWrapper<decltype(&f), &f>::Call, true);
+
 #define RUDF_FUNC_REGISTER_WITH_NAME(NAME, f) \
   static ::rapidudf::FuncRegister BOOST_PP_CAT(rudf_reg_funcs_, __COUNTER__)(NAME, f);
 
+#define RUDF_FUNC_REGISTER_WITH_RESOLVER(NAME, f, resolve) \
+  static ::rapidudf::FuncRegister BOOST_PP_CAT(rudf_reg_funcs_, __COUNTER__)(NAME, f, resolve);
+
 #define RUDF_VECTOR_FUNC_REGISTER_WITH_NAME(NAME, f) \
   static ::rapidudf::VectorFuncRegister BOOST_PP_CAT(rudf_reg_funcs_, __COUNTER__)(NAME, f);
 
@@ -114,6 +114,31 @@ enum OpToken {
   OP_CLONE,
   OP_FILTER,
   OP_GATHER,
+  OP_CUMSUM,
+  OP_CUMMAX,
+  OP_CUMMIN,
+  OP_LAG,
+  OP_LEAD,
+  OP_ROLLING_SUM,
+  OP_ROLLING_AVG,
+  OP_RANK,
+  OP_DENSE_RANK,
+  OP_HASH,
+  OP_HASH_COMBINE,
+  OP_BUCKETIZE,
+  OP_MOD_BUCKET,
+  OP_TO_F32,
+  OP_TO_F16,
+  OP_TO_BF16,
+  OP_QUANTIZE,
+  OP_DEQUANTIZE,
+  OP_HOUR_OF_DAY,
+  OP_DAY_OF_WEEK,
+  OP_DAYS_SINCE,
+  OP_TZ_OFFSET,
+  OP_RAND_UNIFORM,
+  OP_RAND_NORMAL,
+  OP_RAND_BERNOULLI,
   OP_MISC_END,
   OP_END,
 };
@@ -208,6 +233,31 @@ constexpr std::array<std::string_view, OP_END> kOpTokenStrs = {"invalid",
                                                                "clone",
                                                                "filter",
                                                                "gather",
+                                                               "cumsum",
+                                                               "cummax",
+                                                               "cummin",
+                                                               "lag",
+                                                               "lead",
+                                                               "rolling_sum",
+                                                               "rolling_avg",
+                                                               "rank",
+                                                               "dense_rank",
+                                                               "hash",
+                                                               "hash_combine",
+                                                               "bucketize",
+                                                               "mod_bucket",
+                                                               "to_f32",
+                                                               "to_f16",
+                                                               "to_bf16",
+                                                               "quantize",
+                                                               "dequantize",
+                                                               "hour_of_day",
+                                                               "day_of_week",
+                                                               "days_since",
+                                                               "tz_offset",
+                                                               "rand_uniform",
+                                                               "rand_normal",
+                                                               "rand_bernoulli",
                                                                "misc_end"};
 }  // namespace rapidudf
 
@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "rapidudf/metrics/metrics.h"
+#include <algorithm>
+#include <limits>
+#include "fmt/format.h"
+
+namespace rapidudf {
+namespace metrics {
+namespace {
+constexpr size_t kCounterShards = 16;
+constexpr size_t kHistogramBuckets = 64;
+
+size_t thread_shard() {
+  static std::atomic<size_t> thread_seed = {0};
+  static thread_local size_t shard = thread_seed.fetch_add(1, std::memory_order_relaxed) % kCounterShards;
+  return shard;
+}
+
+class InProcessCounter : public Counter {
+ public:
+  void Add(int64_t v) override { shards_[thread_shard()].value.fetch_add(v, std::memory_order_relaxed); }
+  int64_t Value() const {
+    int64_t sum = 0;
+    for (auto& shard : shards_) {
+      sum += shard.value.load(std::memory_order_relaxed);
+    }
+    return sum;
+  }
+
+ private:
+  struct alignas(64) Shard {
+    std::atomic<int64_t> value = {0};
+  };
+  Shard shards_[kCounterShards];
+};
+
+class InProcessGauge : public Gauge {
+ public:
+  void Add(int64_t v) override { value_.fetch_add(v, std::memory_order_relaxed); }
+  void Set(int64_t v) override { value_.store(v, std::memory_order_relaxed); }
+  int64_t Value() const { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<int64_t> value_ = {0};
+};
+
+class InProcessHistogram : public Histogram {
+ public:
+  void Observe(int64_t v) override {
+    // bucket i holds values <= 2^i as the exported `le` bound, so bucket by the bit width of v - 1
+    uint64_t uv = v > 1 ? static_cast<uint64_t>(v) - 1 : 0;
+    size_t idx = uv == 0 ? 0 : std::min<size_t>(64 - __builtin_clzll(uv), kHistogramBuckets - 1);
+    buckets_[idx].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(v, std::memory_order_relaxed);
+  }
+  void Fill(MetricSample& sample) const {
+    sample.value = sum_.load(std::memory_order_relaxed);
+    sample.count = count_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < kHistogramBuckets; i++) {
+      uint64_t n = buckets_[i].load(std::memory_order_relaxed);
+      if (n > 0) {
+        int64_t upper = i == kHistogramBuckets - 1 ? std::numeric_limits<int64_t>::max() : (int64_t{1} << i);
+        sample.buckets.emplace_back(upper, n);
+      }
+    }
+  }
+  uint64_t Count() const { return count_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<uint64_t> buckets_[kHistogramBuckets] = {};
+  std::atomic<uint64_t> count_ = {0};
+  std::atomic<int64_t> sum_ = {0};
+};
+
+std::string metric_key(std::string_view name, const Labels& labels) {
+  std::string key(name);
+  for (auto& [k, v] : labels) {
+    key.append("|").append(k).append("=").append(v);
+  }
+  return key;
+}
+
+std::string format_labels(const Labels& labels, std::string_view extra_key = {}, std::string_view extra_val = {}) {
+  if (labels.empty() && extra_key.empty()) {
+    return "";
+  }
+  std::string s = "{";
+  for (size_t i = 0; i < labels.size(); i++) {
+    if (i > 0) {
+      s.append(",");
+    }
+    s.append(fmt::format("{}=\"{}\"", labels[i].first, labels[i].second));
+  }
+  if (!extra_key.empty()) {
+    if (!labels.empty()) {
+      s.append(",");
+    }
+    s.append(fmt::format("{}=\"{}\"", extra_key, extra_val));
+  }
+  s.append("}");
+  return s;
+}
+
+bool g_registry_installed = false;
+std::mutex g_install_mutex;
+
+// builtin metrics are never freed since hot paths and static destructors may still hold them
+std::vector<std::unique_ptr<BuiltinMetrics>>& all_builtin_metrics() {
+  static auto* all = new std::vector<std::unique_ptr<BuiltinMetrics>>;
+  return *all;
+}
+
+void install_registry(std::shared_ptr<MetricsRegistry> registry, bool only_if_absent) {
+  std::lock_guard<std::mutex> guard(g_install_mutex);
+  if (only_if_absent && g_registry_installed) {
+    return;
+  }
+  g_registry_installed = true;
+  if (!registry) {
+    g_builtin_metrics.store(nullptr, std::memory_order_release);
+    return;
+  }
+  auto m = std::make_unique<BuiltinMetrics>();
+  m->registry = registry;
+  m->compile_total = registry->GetCounter("rapidudf_compile_total");
+  m->compile_failed = registry->GetCounter("rapidudf_compile_failed_total");
+  static constexpr std::string_view kPhaseNames[kCompilePhaseEnd] = {"parse",    "parse_validate", "ir_build",
+                                                                     "optimize", "compile",        "codegen"};
+  for (size_t i = 0; i < kCompilePhaseEnd; i++) {
+    m->compile_phase_us[i] =
+        registry->GetHistogram("rapidudf_compile_phase_us", {{"phase", std::string(kPhaseNames[i])}});
+  }
+  m->eval_cache_hits = registry->GetCounter("rapidudf_eval_cache_hits_total");
+  m->eval_cache_misses = registry->GetCounter("rapidudf_eval_cache_misses_total");
+  m->eval_cache_evictions = registry->GetCounter("rapidudf_eval_cache_evictions_total");
+  m->eval_cache_size = registry->GetGauge("rapidudf_eval_cache_size");
+  m->jit_code_bytes = registry->GetGauge("rapidudf_jit_code_bytes");
+  m->context_resets = registry->GetCounter("rapidudf_context_resets_total");
+  m->arena_allocated_bytes = registry->GetCounter("rapidudf_context_arena_allocated_bytes_total");
+  m->arena_bytes_per_reset = registry->GetHistogram("rapidudf_context_arena_bytes_per_reset");
+  static constexpr std::string_view kTableOpNames[kTableOpEnd] = {"add_rows", "filter", "order_by", "topk",
+                                                                  "group_by", "dedup",  "partition"};
+  for (size_t i = 0; i < kTableOpEnd; i++) {
+    Labels labels{{"op", std::string(kTableOpNames[i])}};
+    m->table_ops[i] = registry->GetCounter("rapidudf_table_ops_total", labels);
+    m->table_rows[i] = registry->GetCounter("rapidudf_table_rows_total", labels);
+  }
+  static constexpr std::string_view kExceptionNames[kExceptionTypeNum] = {
+      "logic", "null_pointer", "readonly", "size_mismatch", "out_of_range", "vector_expression", "unknown"};
+  for (size_t i = 0; i < kExceptionTypeNum; i++) {
+    m->exceptions[i] = registry->GetCounter("rapidudf_exceptions_total", {{"type", std::string(kExceptionNames[i])}});
+  }
+  g_builtin_metrics.store(m.get(), std::memory_order_release);
+  all_builtin_metrics().emplace_back(std::move(m));
+}
+
+struct DefaultRegistryInstaller {
+  DefaultRegistryInstaller() { install_registry(get_default_metrics_registry(), true); }
+};
+DefaultRegistryInstaller g_default_installer;
+}  // namespace
+
+std::atomic<const BuiltinMetrics*> g_builtin_metrics = {nullptr};
+
+InProcessRegistry::Entry& InProcessRegistry::GetOrCreate(std::string_view name, const Labels& labels,
+                                                         MetricType type) {
+  std::string key = metric_key(name, labels);
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto found = metrics_.find(key);
+  if (found != metrics_.end()) {
+    return found->second;
+  }
+  Entry& entry = metrics_[key];
+  entry.name = std::string(name);
+  entry.labels = labels;
+  entry.type = type;
+  switch (type) {
+    case MetricType::kCounter: {
+      entry.counter = std::make_unique<InProcessCounter>();
+      break;
+    }
+    case MetricType::kGauge: {
+      entry.gauge = std::make_unique<InProcessGauge>();
+      break;
+    }
+    case MetricType::kHistogram: {
+      entry.histogram = std::make_unique<InProcessHistogram>();
+      break;
+    }
+  }
+  return entry;
+}
+
+// a name registered with another metric type returns a nullptr, which is a programming error.
+Counter* InProcessRegistry::GetCounter(std::string_view name, const Labels& labels) {
+  return GetOrCreate(name, labels, MetricType::kCounter).counter.get();
+}
+Gauge* InProcessRegistry::GetGauge(std::string_view name, const Labels& labels) {
+  return GetOrCreate(name, labels, MetricType::kGauge).gauge.get();
+}
+Histogram* InProcessRegistry::GetHistogram(std::string_view name, const Labels& labels) {
+  return GetOrCreate(name, labels, MetricType::kHistogram).histogram.get();
+}
+
+std::vector<MetricSample> InProcessRegistry::Snapshot() const {
+  std::vector<MetricSample> samples;
+  std::lock_guard<std::mutex> guard(mutex_);
+  samples.reserve(metrics_.size());
+  for (auto& [_, entry] : metrics_) {
+    MetricSample sample;
+    sample.name = entry.name;
+    sample.labels = entry.labels;
+    sample.type = entry.type;
+    switch (entry.type) {
+      case MetricType::kCounter: {
+        sample.value = static_cast<const InProcessCounter*>(entry.counter.get())->Value();
+        break;
+      }
+      case MetricType::kGauge: {
+        sample.value = static_cast<const InProcessGauge*>(entry.gauge.get())->Value();
+        break;
+      }
+      case MetricType::kHistogram: {
+        static_cast<const InProcessHistogram*>(entry.histogram.get())->Fill(sample);
+        break;
+      }
+    }
+    samples.emplace_back(std::move(sample));
+  }
+  return samples;
+}
+
+int64_t InProcessRegistry::GetValue(std::string_view name, const Labels& labels) const {
+  std::string key = metric_key(name, labels);
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto found = metrics_.find(key);
+  if (found == metrics_.end()) {
+    return 0;
+  }
+  auto& entry = found->second;
+  switch (entry.type) {
+    case MetricType::kCounter: {
+      return static_cast<const InProcessCounter*>(entry.counter.get())->Value();
+    }
+    case MetricType::kGauge: {
+      return static_cast<const InProcessGauge*>(entry.gauge.get())->Value();
+    }
+    case MetricType::kHistogram: {
+      return static_cast<int64_t>(static_cast<const InProcessHistogram*>(entry.histogram.get())->Count());
+    }
+  }
+  return 0;
+}
+
+std::string InProcessRegistry::ToPrometheusText() const {
+  static constexpr std::string_view kTypeNames[] = {"counter", "gauge", "histogram"};
+  std::string text;
+  std::string_view last_name;
+  auto samples = Snapshot();
+  // samples are sorted by key, which groups all labels of the same name together
+  for (auto& sample : samples) {
+    if (sample.name != last_name) {
+      text.append(fmt::format("# TYPE {} {}\n", sample.name, kTypeNames[static_cast<int>(sample.type)]));
+      last_name = sample.name;
+    }
+    if (sample.type != MetricType::kHistogram) {
+      text.append(fmt::format("{}{} {}\n", sample.name, format_labels(sample.labels), sample.value));
+      continue;
+    }
+    uint64_t cumulative = 0;
+    for (auto& [upper, n] : sample.buckets) {
+      cumulative += n;
+      if (upper == std::numeric_limits<int64_t>::max()) {
+        continue;
+      }
+      text.append(fmt::format("{}_bucket{} {}\n", sample.name,
+                              format_labels(sample.labels, "le", std::to_string(upper)), cumulative));
+    }
+    text.append(fmt::format("{}_bucket{} {}\n", sample.name, format_labels(sample.labels, "le", "+Inf"), sample.count));
+    text.append(fmt::format("{}_sum{} {}\n", sample.name, format_labels(sample.labels), sample.value));
+    text.append(fmt::format("{}_count{} {}\n", sample.name, format_labels(sample.labels), sample.count));
+  }
+  return text;
+}
+
+void set_metrics_registry(std::shared_ptr<MetricsRegistry> registry) { install_registry(std::move(registry), false); }
+
+std::shared_ptr<InProcessRegistry> get_default_metrics_registry() {
+  static auto* registry = new std::shared_ptr<InProcessRegistry>(std::make_shared<InProcessRegistry>());
+  return *registry;
+}
+}  // namespace metrics
+}  // namespace rapidudf
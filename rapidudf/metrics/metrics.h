@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace rapidudf {
+namespace metrics {
+
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+class Counter {
+ public:
+  virtual ~Counter() = default;
+  virtual void Add(int64_t v = 1) = 0;
+};
+
+class Gauge {
+ public:
+  virtual ~Gauge() = default;
+  virtual void Add(int64_t v) = 0;
+  virtual void Set(int64_t v) = 0;
+};
+
+class Histogram {
+ public:
+  virtual ~Histogram() = default;
+  virtual void Observe(int64_t v) = 0;
+};
+
+/**
+** Pluggable metrics backend, implement it to forward metrics into an existing monitoring system.
+** Metric objects are created once per name & labels, and must stay valid as long as the registry.
+*/
+class MetricsRegistry {
+ public:
+  virtual ~MetricsRegistry() = default;
+  virtual Counter* GetCounter(std::string_view name, const Labels& labels = {}) = 0;
+  virtual Gauge* GetGauge(std::string_view name, const Labels& labels = {}) = 0;
+  virtual Histogram* GetHistogram(std::string_view name, const Labels& labels = {}) = 0;
+};
+
+enum class MetricType {
+  kCounter,
+  kGauge,
+  kHistogram,
+};
+
+struct MetricSample {
+  std::string name;
+  Labels labels;
+  MetricType type = MetricType::kCounter;
+  // counter/gauge value, or the sum of observed values of histogram
+  int64_t value = 0;
+  uint64_t count = 0;
+  // (upper bound, count) of non-empty histogram buckets, bucket i holds values in (2^(i-1), 2^i]
+  std::vector<std::pair<int64_t, uint64_t>> buckets;
+};
+
+/**
+** Default in-process registry.
+** Counters are sharded by thread and updated with relaxed atomics, histograms use power of 2 buckets.
+*/
+class InProcessRegistry : public MetricsRegistry {
+ public:
+  Counter* GetCounter(std::string_view name, const Labels& labels = {}) override;
+  Gauge* GetGauge(std::string_view name, const Labels& labels = {}) override;
+  Histogram* GetHistogram(std::string_view name, const Labels& labels = {}) override;
+
+  std::vector<MetricSample> Snapshot() const;
+  /**
+  ** Value of counter/gauge, or observed count of histogram, 0 if not exist.
+  */
+  int64_t GetValue(std::string_view name, const Labels& labels = {}) const;
+  /**
+  ** Export all metrics in prometheus text format.
+  */
+  std::string ToPrometheusText() const;
+
+ private:
+  struct Entry {
+    std::string name;
+    Labels labels;
+    MetricType type;
+    std::unique_ptr<Counter> counter;
+    std::unique_ptr<Gauge> gauge;
+    std::unique_ptr<Histogram> histogram;
+  };
+  Entry& GetOrCreate(std::string_view name, const Labels& labels, MetricType type);
+
+  mutable std::mutex mutex_;
+  std::map<std::string, Entry> metrics_;
+};
+
+enum TableOp {
+  kTableAddRows = 0,
+  kTableFilter,
+  kTableOrderBy,
+  kTableTopk,
+  kTableGroupBy,
+  kTableDedup,
+  kTablePartition,
+  kTableOpEnd,
+};
+
+enum CompilePhase {
+  kCompileParse = 0,
+  kCompileParseValidate,
+  kCompileIRBuild,
+  kCompileOptimize,
+  kCompileCompile,
+  kCompileCodegen,
+  kCompilePhaseEnd,
+};
+
+// same order as `rapidudf::ErrorCode` without `kOk`
+constexpr size_t kExceptionTypeNum = 7;
+
+/**
+** Metrics recorded by rapidudf itself, resolved once when the registry installed.
+*/
+struct BuiltinMetrics {
+  std::shared_ptr<MetricsRegistry> registry;
+
+  Counter* compile_total = nullptr;
+  Counter* compile_failed = nullptr;
+  std::array<Histogram*, kCompilePhaseEnd> compile_phase_us = {};
+
+  Counter* eval_cache_hits = nullptr;
+  Counter* eval_cache_misses = nullptr;
+  Counter* eval_cache_evictions = nullptr;
+  Gauge* eval_cache_size = nullptr;
+
+  Gauge* jit_code_bytes = nullptr;
+
+  Counter* context_resets = nullptr;
+  Counter* arena_allocated_bytes = nullptr;
+  Histogram* arena_bytes_per_reset = nullptr;
+
+  std::array<Counter*, kTableOpEnd> table_ops = {};
+  std::array<Counter*, kTableOpEnd> table_rows = {};
+
+  std::array<Counter*, kExceptionTypeNum> exceptions = {};
+};
+
+extern std::atomic<const BuiltinMetrics*> g_builtin_metrics;
+
+/**
+** Install the metrics registry, `nullptr` disables all builtin metrics.
+** The default is an `InProcessRegistry` which could be fetched by `get_default_metrics_registry`.
+*/
+void set_metrics_registry(std::shared_ptr<MetricsRegistry> registry);
+std::shared_ptr<InProcessRegistry> get_default_metrics_registry();
+
+/**
+** Returns `nullptr` if metrics disabled.
+*/
+inline const BuiltinMetrics* builtin_metrics() { return g_builtin_metrics.load(std::memory_order_acquire); }
+
+/**
+** `code` is the value of `rapidudf::ErrorCode`.
+*/
+inline void count_exception(int32_t code) {
+  if (auto* m = builtin_metrics(); m != nullptr && code > 0 && static_cast<size_t>(code) <= kExceptionTypeNum) {
+    m->exceptions[code - 1]->Add(1);
+  }
+}
+
+inline void count_table_op(TableOp op, size_t rows) {
+  if (auto* m = builtin_metrics()) {
+    m->table_ops[op]->Add(1);
+    m->table_rows[op]->Add(static_cast<int64_t>(rows));
+  }
+}
+
+}  // namespace metrics
+}  // namespace rapidudf
@@ -16,10 +16,13 @@
 
 #pragma once
 #include "rapidudf/compiler/compiler.h"
+#include "rapidudf/compiler/compiler_pool.h"
 #include "rapidudf/compiler/options.h"
+#include "rapidudf/compiler/udf_library.h"
 #include "rapidudf/context/context.h"
 #include "rapidudf/exec/eval_engine.h"
 #include "rapidudf/log/log.h"
+#include "rapidudf/metrics/metrics.h"
 #include "rapidudf/reflect/macros.h"
 #include "rapidudf/table/table.h"
 #include "rapidudf/table/table_schema.h"
@@ -28,6 +31,8 @@
 
 namespace rapidudf {
 using JitCompiler = compiler::JitCompiler;
+using JitCompilerPool = compiler::JitCompilerPool;
+using UdfLibrary = compiler::UdfLibrary;
 // using JitCompilerCache = llvm::JitCompilerCache;
 
 template <typename RET, typename... Args>
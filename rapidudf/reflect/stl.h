@@ -56,6 +56,61 @@ struct STLArgType<std::string> {
   static arg_type default_value() { return ""; }
 };
 
+template <typename C, typename = void>
+struct is_transparent_lookup : std::false_type {};
+template <typename C>
+struct is_transparent_lookup<C, std::void_t<typename C::key_compare::is_transparent>> : std::true_type {};
+template <typename C>
+struct is_transparent_lookup<
+    C, std::void_t<typename C::hasher::is_transparent, typename C::key_equal::is_transparent>>
+    : std::true_type {};
+
+/**
+** Converts the FFI key arg into a lookup key without allocating:
+** string keys use `std::string_view` for containers with transparent compare/hash(std::map<std::string, V,
+** std::less<>>, absl containers), otherwise a thread local key buffer whose capacity is reused across lookups.
+*/
+template <typename C>
+struct STLLookupKey {
+  using key_type = typename C::key_type;
+  using arg_type_t = typename STLArgType<key_type>::arg_type;
+  static decltype(auto) from(arg_type_t key) {
+    if constexpr (!std::is_same_v<std::string, key_type>) {
+      return STLArgType<key_type>::from(key);
+    } else if constexpr (is_transparent_lookup<C>::value) {
+      return key.get_string_view();
+    } else {
+      static thread_local std::string lookup_key;
+      lookup_key.assign(key.data(), key.size());
+      return static_cast<const std::string&>(lookup_key);
+    }
+  }
+};
+
+/**
+** Branch free compare over fixed size blocks which compilers vectorize, only the matched block is rescanned.
+*/
+template <typename T>
+int stl_vector_find(const T* data, size_t n, T val) {
+  constexpr size_t kBlockSize = 64;
+  size_t i = 0;
+  for (; i + kBlockSize <= n; i += kBlockSize) {
+    bool hit = false;
+    for (size_t j = 0; j < kBlockSize; j++) {
+      hit |= (data[i + j] == val);
+    }
+    if (hit) {
+      break;
+    }
+  }
+  for (; i < n; i++) {
+    if (data[i] == val) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
 template <typename VEC>
 struct VectorHelper {
   using value_type = typename VEC::value_type;
@@ -70,6 +125,9 @@ struct VectorHelper {
     if (nullptr == v) {
       return -1;
     }
+    if constexpr (std::is_arithmetic_v<value_type> && !std::is_same_v<bool, value_type>) {
+      return stl_vector_find(v->data(), v->size(), val);
+    }
     for (size_t i = 0; i < v->size(); i++) {
       auto element_v = STLArgType<value_type>::value(v->at(i));
       if (element_v == val) {
@@ -111,7 +169,7 @@ struct SetHelper {
     if (nullptr == v) {
       return false;
     }
-    return v->find(STLArgType<key_type>::from(val)) != v->end();
+    return v->find(STLLookupKey<Set>::from(val)) != v->end();
   }
   static bool insert(Set* vec, arg_type_t val) {
     if (nullptr == vec) {
@@ -144,13 +202,13 @@ struct MapHelper {
     if (nullptr == v) {
       return false;
     }
-    return v->find(STLArgType<key_type>::from(key)) != v->end();
+    return v->find(STLLookupKey<Map>::from(key)) != v->end();
   }
   static arg_value_type_t get(Map* v, arg_key_type_t key) {
     if (nullptr == v) {
       THROW_NULL_POINTER_ERR("null map");
     }
-    auto found = v->find(STLArgType<key_type>::from(key));
+    auto found = v->find(STLLookupKey<Map>::from(key));
     if (found == v->end()) {
       return {};
     }
@@ -15,17 +15,36 @@
  */
 
 #pragma once
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
+#include "absl/status/statusor.h"
 #include "rapidudf/reflect/struct.h"
 #include "rapidudf/table/row.h"
+#include "rapidudf/types/vector.h"
 
 namespace rapidudf {
 namespace table {
+class Table;
+
+/**
+** Column evaluated from the vector expression `expr` over other columns of the table.
+*/
+struct ComputedColumn {
+  using EvalFunc = std::function<absl::StatusOr<VectorBuf>(Table*)>;
+  std::string expr;
+  // offsets of columns referenced by `expr`, all added before this column
+  std::vector<uint32_t> deps;
+  EvalFunc eval;
+};
+
 struct Column {
   std::string name;
   reflect::Field field;
   const RowSchema* schema = nullptr;
   uint32_t field_idx = 0;
+  std::shared_ptr<const ComputedColumn> computed;
 
   const ::google::protobuf::FieldDescriptor* GetProtobufField() const { return schema->pb_desc->field(field_idx); }
   const StructMember* GetStructField() const { return schema->struct_members->at(field_idx); }
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "rapidudf/table/row.h"
+#include <algorithm>
 #include <cstring>
 #include <vector>
 #include "rapidudf/functions/simd/vector.h"
@@ -59,6 +60,18 @@ absl::Status Rows::Insert(size_t pos, const uint8_t* ptr) {
   objs_.insert(objs_.begin() + pos, ptr);
   return absl::OkStatus();
 }
+void Rows::Insert(const std::vector<size_t>& positions, const std::vector<const uint8_t*>& objs) {
+  std::vector<const uint8_t*> merged;
+  merged.reserve(std::max(objs_.capacity(), objs_.size() + objs.size()));
+  size_t cursor = 0;
+  for (size_t i = 0; i < objs.size(); i++) {
+    merged.insert(merged.end(), objs_.begin() + cursor, objs_.begin() + positions[i]);
+    merged.emplace_back(objs[i]);
+    cursor = positions[i];
+  }
+  merged.insert(merged.end(), objs_.begin() + cursor, objs_.end());
+  objs_ = std::move(merged);
+}
 Vector<Pointer> Rows::GetRowPtrs() const {
   VectorBuf vdata(objs_.data(), objs_.size());
   return Vector<Pointer>(vdata);
@@ -56,10 +56,13 @@ class Rows {
       : ctx_(ctx), objs_(std::move(objs)), schema_(s) {}
   absl::Status Insert(size_t pos, const uint8_t* ptr);
   void Append(const std::vector<const uint8_t*>& objs);
+  // insert `objs[i]` before row `positions[i]`, `positions` is ascending
+  void Insert(const std::vector<size_t>& positions, const std::vector<const uint8_t*>& objs);
+  void Reserve(size_t n) { objs_.reserve(n); }
 
   const RowSchema& GetSchema() const { return schema_; }
   Vector<Pointer> GetRowPtrs() const;
-  const std::vector<const uint8_t*> GetRawRowPtrs() const { return objs_; }
+  const std::vector<const uint8_t*>& GetRawRowPtrs() const { return objs_; }
 
   size_t RowCount() const { return objs_.size(); }
 
@@ -15,10 +15,15 @@
  */
 
 #include "rapidudf/table/table.h"
+#include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <numeric>
+#include <queue>
 #include <string_view>
 #include <type_traits>
 #include <utility>
@@ -29,21 +34,125 @@
 
 #include "rapidudf/common/allign.h"
 #include "rapidudf/functions/simd/bits.h"
+#include "rapidudf/functions/simd/string.h"
 #include "rapidudf/functions/simd/vector.h"
+#include "rapidudf/functions/simd/vector_hash.h"
 #include "rapidudf/log/log.h"
 #include "rapidudf/meta/dtype.h"
 #include "rapidudf/meta/dtype_enums.h"
 #include "rapidudf/meta/exception.h"
+#include "rapidudf/metrics/metrics.h"
 #include "rapidudf/table/row.h"
 #include "rapidudf/table/table_schema.h"
 #include "rapidudf/types/bit.h"
 #include "rapidudf/types/dyn_object_impl.h"
+#include "rapidudf/types/float16.h"
 #include "rapidudf/types/pointer.h"
 #include "rapidudf/types/string_view.h"
 #include "rapidudf/types/vector.h"
 
 namespace rapidudf {
 namespace table {
+static inline uint64_t hash_mix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+template <typename T>
+using hash_widen_t = std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>;
+
+// same mixing as `functions::simd_vector_hash` for types it does not support, floats are hashed by bits.
+template <typename T>
+static void hash_column(const T* data, size_t n, uint64_t* hashes) {
+  for (size_t i = 0; i < n; i++) {
+    T v = data[i];
+    if constexpr (std::is_floating_point_v<T>) {
+      // -0.0 == 0.0
+      if (v == 0) {
+        v = 0;
+      }
+      using bits_t = std::conditional_t<sizeof(T) == 8, uint64_t, uint32_t>;
+      bits_t bits;
+      memcpy(&bits, &v, sizeof(T));
+      hashes[i] = hash_mix(bits);
+    } else {
+      hashes[i] = hash_mix(static_cast<uint64_t>(static_cast<hash_widen_t<T>>(v)));
+    }
+  }
+}
+
+template <typename T>
+static Vector<uint64_t> hash_column(Context& ctx, const uint8_t* data, size_t n) {
+  Vector<T> values(reinterpret_cast<const T*>(data), n);
+  if constexpr (std::is_same_v<T, StringView> || std::is_same_v<T, int64_t> || std::is_same_v<T, uint64_t> ||
+                std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t>) {
+    return functions::simd_vector_hash(ctx, values);
+  } else {
+    VectorBuf vdata = ctx.NewVectorBuf<uint64_t>(n);
+    hash_column(values.Data(), n, vdata.MutableData<uint64_t>());
+    return Vector<uint64_t>(vdata);
+  }
+}
+
+static absl::StatusOr<Vector<uint64_t>> hash_column(Context& ctx, const DType& dtype, const uint8_t* data, size_t n) {
+  switch (dtype.GetFundamentalType()) {
+    case DATA_F64: {
+      return hash_column<double>(ctx, data, n);
+    }
+    case DATA_F32: {
+      return hash_column<float>(ctx, data, n);
+    }
+    case DATA_U64: {
+      return hash_column<uint64_t>(ctx, data, n);
+    }
+    case DATA_I64: {
+      return hash_column<int64_t>(ctx, data, n);
+    }
+    case DATA_U32: {
+      return hash_column<uint32_t>(ctx, data, n);
+    }
+    case DATA_I32: {
+      return hash_column<int32_t>(ctx, data, n);
+    }
+    case DATA_F16:
+    case DATA_BF16:
+    case DATA_U16: {
+      return hash_column<uint16_t>(ctx, data, n);
+    }
+    case DATA_I16: {
+      return hash_column<int16_t>(ctx, data, n);
+    }
+    case DATA_U8: {
+      return hash_column<uint8_t>(ctx, data, n);
+    }
+    case DATA_I8: {
+      return hash_column<int8_t>(ctx, data, n);
+    }
+    case DATA_STRING_VIEW: {
+      return hash_column<StringView>(ctx, data, n);
+    }
+    default: {
+      return absl::InvalidArgumentError(fmt::format("Invalid dtype:{} to hash.", dtype));
+    }
+  }
+}
+
+template <typename T>
+static void scatter_column(Context& ctx, const T* data, const uint32_t* ids, const uint32_t* positions, size_t n,
+                           absl::Span<const uint32_t> counts, absl::Span<VectorBuf> outputs) {
+  std::vector<T*> dsts(counts.size());
+  for (size_t b = 0; b < counts.size(); b++) {
+    outputs[b] = ctx.NewVectorBuf<T>(counts[b]);
+    dsts[b] = outputs[b].MutableData<T>();
+  }
+  for (size_t i = 0; i < n; i++) {
+    dsts[ids[i]][positions[i]] = data[i];
+  }
+}
+
 static std::vector<int32_t> get_indices(size_t n) {
   static constexpr uint32_t kDefaultIndiceCount = 10000;
   static std::vector<int32_t> default_indices;
@@ -95,11 +204,12 @@ absl::StatusOr<uint32_t> Table::GetColumnOffset(const std::string& name) {
   return field_offset;
 }
 size_t Table::GetColumnMemorySize(const DType& dtype) {
+  size_t count = std::max(Count(), reserved_rows_);
   if (dtype.IsBit()) {
-    uint32_t n = Count() / 8;
-    return Count() % 8 > 0 ? n + 1 : n;
+    size_t n = count / 8;
+    return count % 8 > 0 ? n + 1 : n;
   } else {
-    return dtype.ByteSize() * Count();
+    return dtype.ByteSize() * count;
   }
 }
 uint8_t* Table::GetColumnMemory(uint32_t offset, const DType& dtype) {
@@ -116,6 +226,22 @@ uint8_t* Table::GetColumnMemory(uint32_t offset, const DType& dtype) {
     return p;
   }
 }
+uint8_t* Table::GrowColumnMemory(uint32_t offset, const DType& dtype, size_t keep) {
+  uint8_t* vec_ptr = reinterpret_cast<uint8_t*>(this) + offset;
+  VectorBuf* vdata = (reinterpret_cast<VectorBuf*>(vec_ptr));
+  size_t request_memory_size = GetColumnMemorySize(dtype);
+  if (vdata->BytesCapacity() >= request_memory_size) {
+    return vdata->MutableData<uint8_t>();
+  }
+  // doubled capacity keeps row by row appends amortized O(1)
+  size_t capacity = std::max(request_memory_size, vdata->BytesCapacity() * 2);
+  uint8_t* p = ctx_.ArenaAllocate(capacity);
+  memcpy(p, vdata->Data(), dtype.IsBit() ? (keep + 7) / 8 : keep * dtype.ByteSize());
+  VectorBuf alloc(p, keep, capacity);
+  alloc.SetReadonly(false);
+  *vdata = alloc;
+  return p;
+}
 void Table::SetColumnSize(const Column& column, void* p) {
   uint8_t* vec_ptr = reinterpret_cast<uint8_t*>(this) + column.field.bytes_offset;
   VectorBuf* vdata = (reinterpret_cast<VectorBuf*>(vec_ptr));
@@ -126,53 +252,69 @@ void Table::SetColumnSize(const Column& column, void* p) {
 }
 
 template <typename T>
-absl::Status Table::LoadColumn(const Vector<Pointer>& objs, const Column& column) {
+absl::Status Table::LoadColumn(const Vector<Pointer>& objs, const Column& column, T* vec) {
   if (column.schema->pb_desc != nullptr) {
-    return LoadProtobufColumn<T>(objs, column);
+    return LoadProtobufColumn<T>(objs, column, vec);
   } else if (column.schema->fbs_table != nullptr) {
-    return LoadFlatbuffersColumn<T>(objs, column);
+    return LoadFlatbuffersColumn<T>(objs, column, vec);
   } else {
-    return LoadStructColumn<T>(objs, column);
+    return LoadStructColumn<T>(objs, column, vec);
   }
 }
 
 absl::Status Table::LoadColumn(const Rows& rows, const Column& column) {
+  uint8_t* data = GetColumnMemory(column.field.bytes_offset, column.field.dtype.Elem());
+  auto status = LoadColumn(rows.GetRowPtrs(), column, data);
+  if (!status.ok()) {
+    return status;
+  }
+  SetColumnSize(column, data);
+  return absl::OkStatus();
+}
+
+absl::Status Table::LoadColumn(const Vector<Pointer>& objs, const Column& column, uint8_t* data) {
   switch (column.field.dtype.Elem().GetFundamentalType()) {
     case DATA_F32: {
-      return LoadColumn<float>(rows.GetRowPtrs(), column);
+      return LoadColumn<float>(objs, column, reinterpret_cast<float*>(data));
     }
     case DATA_F64: {
-      return LoadColumn<double>(rows.GetRowPtrs(), column);
+      return LoadColumn<double>(objs, column, reinterpret_cast<double*>(data));
+    }
+    case DATA_F16: {
+      return LoadColumn<Float16>(objs, column, reinterpret_cast<Float16*>(data));
+    }
+    case DATA_BF16: {
+      return LoadColumn<BFloat16>(objs, column, reinterpret_cast<BFloat16*>(data));
     }
     case DATA_U64: {
-      return LoadColumn<uint64_t>(rows.GetRowPtrs(), column);
+      return LoadColumn<uint64_t>(objs, column, reinterpret_cast<uint64_t*>(data));
     }
     case DATA_U32: {
-      return LoadColumn<uint32_t>(rows.GetRowPtrs(), column);
+      return LoadColumn<uint32_t>(objs, column, reinterpret_cast<uint32_t*>(data));
     }
     case DATA_U16: {
-      return LoadColumn<uint16_t>(rows.GetRowPtrs(), column);
+      return LoadColumn<uint16_t>(objs, column, reinterpret_cast<uint16_t*>(data));
     }
     case DATA_U8: {
-      return LoadColumn<uint8_t>(rows.GetRowPtrs(), column);
+      return LoadColumn<uint8_t>(objs, column, reinterpret_cast<uint8_t*>(data));
     }
     case DATA_I64: {
-      return LoadColumn<int64_t>(rows.GetRowPtrs(), column);
+      return LoadColumn<int64_t>(objs, column, reinterpret_cast<int64_t*>(data));
     }
     case DATA_I32: {
-      return LoadColumn<int32_t>(rows.GetRowPtrs(), column);
+      return LoadColumn<int32_t>(objs, column, reinterpret_cast<int32_t*>(data));
     }
     case DATA_I16: {
-      return LoadColumn<int16_t>(rows.GetRowPtrs(), column);
+      return LoadColumn<int16_t>(objs, column, reinterpret_cast<int16_t*>(data));
     }
     case DATA_I8: {
-      return LoadColumn<int8_t>(rows.GetRowPtrs(), column);
+      return LoadColumn<int8_t>(objs, column, reinterpret_cast<int8_t*>(data));
     }
     case DATA_STRING_VIEW: {
-      return LoadColumn<StringView>(rows.GetRowPtrs(), column);
+      return LoadColumn<StringView>(objs, column, reinterpret_cast<StringView*>(data));
     }
     case DATA_BIT: {
-      return LoadColumn<bool>(rows.GetRowPtrs(), column);
+      return LoadColumn<bool>(objs, column, reinterpret_cast<bool*>(data));
     }
     default: {
       RUDF_LOG_RETURN_FMT_ERROR("Unsupported column:{} with dtype:{}", column.name, column.field.dtype);
@@ -181,8 +323,7 @@ absl::Status Table::LoadColumn(const Rows& rows, const Column& column) {
 }
 
 template <typename T>
-absl::Status Table::LoadProtobufColumn(const Vector<Pointer>& pb_vector, const Column& column) {
-  T* vec = reinterpret_cast<T*>(GetColumnMemory(column.field.bytes_offset, get_dtype<T>()));
+absl::Status Table::LoadProtobufColumn(const Vector<Pointer>& pb_vector, const Column& column, T* vec) {
   const ::google::protobuf::FieldDescriptor* field_desc = column.GetProtobufField();
   for (size_t i = 0; i < pb_vector.Size(); i++) {
     auto obj = pb_vector[i];
@@ -203,6 +344,12 @@ absl::Status Table::LoadProtobufColumn(const Vector<Pointer>& pb_vector, const C
         vec[i] = (reflect->GetFloat(*msg, field_desc));
       } else if constexpr (std::is_same_v<double, T>) {
         vec[i] = (reflect->GetDouble(*msg, field_desc));
+      } else if constexpr (is_half_float_v<T>) {
+        if (field_desc->cpp_type() == ::google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE) {
+          vec[i] = T(static_cast<float>(reflect->GetDouble(*msg, field_desc)));
+        } else {
+          vec[i] = T(reflect->GetFloat(*msg, field_desc));
+        }
       } else if constexpr (std::is_same_v<StringView, T>) {
         static std::string empty;
         const std::string& ref = reflect->GetStringReference(*msg, field_desc, &empty);
@@ -220,12 +367,10 @@ absl::Status Table::LoadProtobufColumn(const Vector<Pointer>& pb_vector, const C
     }
   }
 
-  SetColumnSize(column, vec);
   return absl::OkStatus();
 }
 template <typename T>
-absl::Status Table::LoadFlatbuffersColumn(const Vector<Pointer>& fbs_vector, const Column& column) {
-  T* vec = reinterpret_cast<T*>(GetColumnMemory(column.field.bytes_offset, get_dtype<T>()));
+absl::Status Table::LoadFlatbuffersColumn(const Vector<Pointer>& fbs_vector, const Column& column, T* vec) {
   for (size_t i = 0; i < fbs_vector.Size(); i++) {
     auto fbs = fbs_vector[i];
     const uint8_t* ptr = nullptr;
@@ -242,6 +387,12 @@ absl::Status Table::LoadFlatbuffersColumn(const Vector<Pointer>& fbs_vector, con
                   std::is_same_v<int32_t, T> || std::is_same_v<int64_t, T> || std::is_same_v<uint64_t, T> ||
                   std::is_same_v<float, T> || std::is_same_v<double, T>) {
       vec[i] = (flatbuffers::ReadScalar<T>(ptr));
+    } else if constexpr (is_half_float_v<T>) {
+      if (column.schema->fbs_table->type_codes[column.field_idx].base_type == flatbuffers::ET_DOUBLE) {
+        vec[i] = T(static_cast<float>(flatbuffers::ReadScalar<double>(ptr)));
+      } else {
+        vec[i] = T(flatbuffers::ReadScalar<float>(ptr));
+      }
     } else if constexpr (std::is_same_v<StringView, T>) {
       ptr += flatbuffers::ReadScalar<flatbuffers::uoffset_t>(ptr);
       const flatbuffers::String* str = reinterpret_cast<const flatbuffers::String*>(ptr);
@@ -250,15 +401,13 @@ absl::Status Table::LoadFlatbuffersColumn(const Vector<Pointer>& fbs_vector, con
     }
   }
 
-  SetColumnSize(column, vec);
   return absl::OkStatus();
 }
 
 template <typename T>
-absl::Status Table::LoadStructColumn(const Vector<Pointer>& struct_vector, const Column& column) {
+absl::Status Table::LoadStructColumn(const Vector<Pointer>& struct_vector, const Column& column, T* vec) {
   DType expect_dtype = get_dtype<T>();
   DType actual_dtype;
-  T* vec = reinterpret_cast<T*>(GetColumnMemory(column.field.bytes_offset, expect_dtype));
   if (column.GetStructField()->HasField()) {
     actual_dtype = *(column.GetStructField()->member_field_dtype);
   } else {
@@ -291,6 +440,21 @@ absl::Status Table::LoadStructColumn(const Vector<Pointer>& struct_vector, const
           RUDF_LOG_RETURN_FMT_ERROR("Unexpected state with column dtype:{}, field dtype:{}", expect_dtype,
                                     actual_dtype);
         }
+      } else if constexpr (is_half_float_v<T>) {
+        if (obj.IsNull()) {
+          vec[i] = (T{});
+        } else if (actual_dtype.GetFundamentalType() == DATA_F64) {
+          const double* ptr =
+              reinterpret_cast<const double*>(obj.As<const uint8_t>() + column.GetStructField()->member_field_offset);
+          vec[i] = T(static_cast<float>(*ptr));
+        } else if (actual_dtype.GetFundamentalType() == DATA_F32) {
+          const float* ptr =
+              reinterpret_cast<const float*>(obj.As<const uint8_t>() + column.GetStructField()->member_field_offset);
+          vec[i] = T(*ptr);
+        } else {
+          RUDF_LOG_RETURN_FMT_ERROR("Unexpected state with column dtype:{}, field dtype:{}", expect_dtype,
+                                    actual_dtype);
+        }
       } else if constexpr (std::is_same_v<StringView, T>) {
         if (!obj.IsNull()) {
           if (expect_dtype == actual_dtype) {
@@ -336,6 +500,19 @@ absl::Status Table::LoadStructColumn(const Vector<Pointer>& struct_vector, const
             RUDF_LOG_RETURN_FMT_ERROR("Unexpected state with column dtype:{}, field dtype:{}", expect_dtype,
                                       actual_dtype);
           }
+        } else if constexpr (is_half_float_v<T>) {
+          if (actual_dtype.GetFundamentalType() == DATA_F64) {
+            using func_t = double (*)(void*);
+            func_t f = reinterpret_cast<func_t>(column.GetStructField()->member_func->func);
+            vec[i] = T(static_cast<float>(f(obj.As<uint8_t>())));
+          } else if (actual_dtype.GetFundamentalType() == DATA_F32) {
+            using func_t = float (*)(void*);
+            func_t f = reinterpret_cast<func_t>(column.GetStructField()->member_func->func);
+            vec[i] = T(f(obj.As<uint8_t>()));
+          } else {
+            RUDF_LOG_RETURN_FMT_ERROR("Unexpected state with column dtype:{}, field dtype:{}", expect_dtype,
+                                      actual_dtype);
+          }
         } else if constexpr (std::is_same_v<StringView, T>) {
           if (expect_dtype == actual_dtype) {
             using func_t = T (*)(void*);
@@ -363,7 +540,6 @@ absl::Status Table::LoadStructColumn(const Vector<Pointer>& struct_vector, const
     }
   }
 
-  SetColumnSize(column, vec);
   return absl::OkStatus();
 }
 
@@ -398,15 +574,24 @@ Table* Table::NewTableBySchema(const std::string& name) {
   return t;
 }
 typename Table::SmartPtr Table::NewTableBySchema(const TableSchema* schema) { return schema->NewTable(ctx_); }
+Table* Table::NewEmptyTable() {
+  uint8_t* bytes = new uint8_t[schema_->ByteSize()];
+  memset(bytes, 0, schema_->ByteSize());
+  new (bytes) Table(ctx_, schema_);
+  Table* t = reinterpret_cast<Table*>(bytes);
+  Deleter d;
+  ctx_.Own(t, d);
+  return t;
+}
 
-std::vector<int32_t> Table::GetIndices() {
+Vector<int32_t> Table::GetIndices() {
   size_t count = Count();
   if (indices_.size() < count) {
     indices_ = get_indices(count);
-  } else if (indices_.size() > count) {
-    indices_.resize(count);
   }
-  return indices_;
+  VectorBuf indices = ctx_.NewVectorBuf<int32_t>(count);
+  memcpy(indices.MutableData<int32_t>(), indices_.data(), sizeof(int32_t) * count);
+  return Vector<int32_t>(indices);
 }
 void Table::SetIndices(std::vector<int32_t>&& indices) { indices_ = std::move(indices); }
 
@@ -423,11 +608,10 @@ absl::Status Table::Validate(const std::vector<RowSchema>& schemas) {
   return absl::OkStatus();
 }
 
-absl::Status Table::DoAddRows(std::vector<PartialRows>&& rows) {
+absl::StatusOr<size_t> Table::CheckPartialRows(const std::vector<PartialRows>& rows) {
   if (rows.size() != GetTableSchema()->row_schemas_.size()) {
     RUDF_RETURN_FMT_ERROR("Expected {} column set, but {} given", GetTableSchema()->row_schemas_.size(), rows.size());
   }
-  // std::lock_guard<std::mutex> guard(table_mutex_);
   size_t row_count = 0;
   for (size_t i = 0; i < rows.size(); i++) {
     auto& [schema, columns] = rows[i];
@@ -441,29 +625,171 @@ absl::Status Table::DoAddRows(std::vector<PartialRows>&& rows) {
         RUDF_RETURN_FMT_ERROR("Rows[{}] has mismatch rows size {}/{}", i, row_count, columns.size());
       }
     }
-    rows_[i].Append(columns);
   }
-  UnloadAllColumns();
+  return row_count;
+}
+
+absl::Status Table::DoAddRows(std::vector<PartialRows>&& rows) {
+  // std::lock_guard<std::mutex> guard(table_mutex_);
+  auto check_result = CheckPartialRows(rows);
+  if (!check_result.ok()) {
+    return check_result.status();
+  }
+  size_t row_count = check_result.value();
+  size_t start = Count();
+  for (size_t i = 0; i < rows.size(); i++) {
+    rows_[i].Append(rows[i].second);
+  }
+  ExtendLoadedColumns(start);
+  UnloadComputedColumns();
+  metrics::count_table_op(metrics::kTableAddRows, row_count);
   return absl::OkStatus();
 }
 
-absl::Status Table::InsertRow(size_t pos, const std::vector<PartialRow>& rows) {
-  if (rows.size() != GetTableSchema()->row_schemas_.size()) {
-    RUDF_RETURN_FMT_ERROR("Expected {} partial rows, but {} given", GetTableSchema()->row_schemas_.size(), rows.size());
+absl::Status Table::DoInsertRows(const std::vector<size_t>& positions, std::vector<PartialRows>&& rows) {
+  auto check_result = CheckPartialRows(rows);
+  if (!check_result.ok()) {
+    return check_result.status();
+  }
+  size_t row_count = check_result.value();
+  if (positions.size() != row_count) {
+    RUDF_RETURN_FMT_ERROR("Expected {} insert positions, but {} given", row_count, positions.size());
+  }
+  size_t count = Count();
+  for (size_t i = 0; i < positions.size(); i++) {
+    if (positions[i] > count) {
+      return absl::OutOfRangeError("too large pos to insert");
+    }
+    if (i > 0 && positions[i] < positions[i - 1]) {
+      RUDF_RETURN_FMT_ERROR("Insert positions are not ascending at {}", i);
+    }
+  }
+  if (positions.empty() || positions[0] == count) {
+    // all rows appended at the end
+    return DoAddRows(std::move(rows));
   }
-  // std::lock_guard<std::mutex> guard(table_mutex_);
   for (size_t i = 0; i < rows.size(); i++) {
-    auto& [schema, columns] = rows[i];
-    if (rows_[i].GetSchema() != *schema) {
-      RUDF_RETURN_FMT_ERROR("Rows[{}] has invalid schema to insert.", i);
+    rows_[i].Insert(positions, rows[i].second);
+  }
+  InsertLoadedColumns(positions, rows);
+  UnloadComputedColumns();
+  metrics::count_table_op(metrics::kTableAddRows, row_count);
+  return absl::OkStatus();
+}
+
+absl::Status Table::InsertRow(size_t pos, const std::vector<PartialRow>& row) {
+  std::vector<PartialRows> rows;
+  for (auto& [schema, obj] : row) {
+    rows.emplace_back(schema, std::vector<const uint8_t*>{obj});
+  }
+  return DoInsertRows({pos}, std::move(rows));
+}
+
+void Table::Reserve(size_t rows) {
+  reserved_rows_ = rows;
+  for (auto& rs : rows_) {
+    rs.Reserve(rows);
+  }
+  for (auto& column : GetTableSchema()->columns_) {
+    uint32_t offset = column.field.bytes_offset;
+    if (column.schema != nullptr && IsColumnLoaded(offset)) {
+      GrowColumnMemory(offset, column.field.dtype.Elem(), Count());
+    }
+  }
+}
+
+void Table::ExtendLoadedColumns(size_t start) {
+  size_t count = Count();
+  for (auto& column : GetTableSchema()->columns_) {
+    uint32_t offset = column.field.bytes_offset;
+    if (column.schema == nullptr || !IsColumnLoaded(offset)) {
+      continue;
+    }
+    VectorBuf* vdata = reinterpret_cast<VectorBuf*>(reinterpret_cast<uint8_t*>(this) + offset);
+    int row_idx = GetRowIdx(*column.schema);
+    if (vdata->Size() != start || row_idx < 0) {
+      vdata->SetSize(0);
+      continue;
     }
-    auto status = rows_[i].Insert(pos, columns);
+    DType dtype = column.field.dtype.Elem();
+    Vector<Pointer> objs = rows_[row_idx].GetRowPtrs().SubVector(start, count - start);
+    // load new rows aside, bit columns could not be loaded from an unaligned position
+    uint8_t* new_data = ctx_.ArenaAllocate(dtype.IsBit() ? (objs.Size() + 7) / 8 : dtype.ByteSize() * objs.Size());
+    auto status = LoadColumn(objs, column, new_data);
     if (!status.ok()) {
-      return status;
+      RUDF_ERROR("Failed to extend column:{} with error:{}", column.name, status.ToString());
+      vdata->SetSize(0);
+      continue;
+    }
+    uint8_t* data = GrowColumnMemory(offset, dtype, start);
+    if (dtype.IsBit()) {
+      for (size_t i = 0; i < objs.Size(); i++) {
+        bits_set(data, start + i, bits_get(new_data, i));
+      }
+    } else {
+      memcpy(data + start * dtype.ByteSize(), new_data, objs.Size() * dtype.ByteSize());
     }
+    vdata->SetSize(count);
+    vdata->SetReadonly(false);
+  }
+}
+
+void Table::InsertLoadedColumns(const std::vector<size_t>& positions, const std::vector<PartialRows>& rows) {
+  size_t count = Count();
+  size_t old_count = count - positions.size();
+  for (auto& column : GetTableSchema()->columns_) {
+    uint32_t offset = column.field.bytes_offset;
+    if (column.schema == nullptr || !IsColumnLoaded(offset)) {
+      continue;
+    }
+    VectorBuf* vdata = reinterpret_cast<VectorBuf*>(reinterpret_cast<uint8_t*>(this) + offset);
+    int row_idx = GetRowIdx(*column.schema);
+    if (vdata->Size() != old_count || row_idx < 0) {
+      vdata->SetSize(0);
+      continue;
+    }
+    DType dtype = column.field.dtype.Elem();
+    const auto& new_objs = rows[row_idx].second;
+    Vector<Pointer> objs(VectorBuf(new_objs.data(), new_objs.size()));
+    uint8_t* new_data = ctx_.ArenaAllocate(dtype.IsBit() ? (objs.Size() + 7) / 8 : dtype.ByteSize() * objs.Size());
+    auto status = LoadColumn(objs, column, new_data);
+    if (!status.ok()) {
+      RUDF_ERROR("Failed to insert column:{} with error:{}", column.name, status.ToString());
+      vdata->SetSize(0);
+      continue;
+    }
+    // merge old & new values into a new buffer in one pass
+    const uint8_t* old_data = vdata->ReadableData<uint8_t>();
+    size_t capacity = GetColumnMemorySize(dtype);
+    uint8_t* data = ctx_.ArenaAllocate(capacity);
+    size_t cursor = 0;
+    size_t out = 0;
+    if (dtype.IsBit()) {
+      for (size_t i = 0; i <= positions.size(); i++) {
+        size_t end = i < positions.size() ? positions[i] : old_count;
+        for (; cursor < end; cursor++) {
+          bits_set(data, out++, bits_get(old_data, cursor));
+        }
+        if (i < positions.size()) {
+          bits_set(data, out++, bits_get(new_data, i));
+        }
+      }
+    } else {
+      size_t elem_size = dtype.ByteSize();
+      for (size_t i = 0; i <= positions.size(); i++) {
+        size_t end = i < positions.size() ? positions[i] : old_count;
+        memcpy(data + out * elem_size, old_data + cursor * elem_size, (end - cursor) * elem_size);
+        out += end - cursor;
+        cursor = end;
+        if (i < positions.size()) {
+          memcpy(data + out * elem_size, new_data + i * elem_size, elem_size);
+          out++;
+        }
+      }
+    }
+    *vdata = VectorBuf(data, count, capacity);
+    vdata->SetReadonly(false);
   }
-  UnloadAllColumns();
-  return absl::OkStatus();
 }
 
 VectorBuf Table::GetColumnByOffset(uint32_t offset) {
@@ -478,6 +804,17 @@ VectorBuf Table::GetColumnByOffset(uint32_t offset) {
     if (column == nullptr) {
       THROW_LOGIC_ERR("No column found for offset:{}", offset);
     }
+    if (column->computed) {
+      if (Count() == 0) {
+        return vdata;
+      }
+      auto result = column->computed->eval(this);
+      if (!result.ok()) {
+        THROW_LOGIC_ERR("Eval computed column:{} error:{}", column->name, result.status().ToString());
+      }
+      SetColumn(offset, result.value());
+      return result.value();
+    }
     const Rows* rows = nullptr;
     for (auto& rs : rows_) {
       if (rs.GetSchema() == *(column->schema)) {
@@ -516,6 +853,9 @@ absl::StatusOr<VectorBuf> Table::GatherField(uint8_t* vec_ptr, const DType& dtyp
           functions::simd_vector_gather(ctx_, *reinterpret_cast<Vector<uint8_t>*>(vec_ptr), indices).GetVectorBuf();
       break;
     }
+    // half floats are only moved, gather their bits
+    case DATA_F16:
+    case DATA_BF16:
     case DATA_U16: {
       new_vec =
           functions::simd_vector_gather(ctx_, *reinterpret_cast<Vector<uint16_t>*>(vec_ptr), indices).GetVectorBuf();
@@ -601,16 +941,125 @@ void Table::DoFilter(Vector<Bit> bits) {
 }
 
 Table* Table::Filter(Vector<Bit> bits) {
+  metrics::count_table_op(metrics::kTableFilter, Count());
   Table* new_table = Clone();
   new_table->DoFilter(bits);
   return new_table;
 }
 std::pair<Table*, Table*> Table::Split(Vector<Bit> bits) {
-  Vector<Bit> other = ctx_.NewVectorBuf<Bit>(bits.Size());
-  functions::simd_vector_bits_not(bits, other);
-  Table* first = Filter(bits);
-  Table* second = Filter(other);
-  return {first, second};
+  if (bits.Size() != Count()) {
+    THROW_LOGIC_ERR("Invalid split bits with size:{}, while table row size:{}", bits.Size(), Count());
+  }
+  // rows with bit set go to bucket 0
+  VectorBuf ids = ctx_.NewVectorBuf<uint32_t>(bits.Size());
+  uint32_t* ids_data = ids.MutableData<uint32_t>();
+  for (size_t i = 0; i < bits.Size(); i++) {
+    ids_data[i] = bits[i] ? 0 : 1;
+  }
+  auto tables = Partition(Vector<uint32_t>(ids), 2);
+  return {tables[0], tables[1]};
+}
+
+absl::Span<Table*> Table::Partition(Vector<uint32_t> bucket_ids, uint32_t n) {
+  size_t count = Count();
+  if (bucket_ids.Size() != count) {
+    THROW_LOGIC_ERR("Invalid partition bucket ids with size:{}, while table row size:{}", bucket_ids.Size(), count);
+  }
+  if (n == 0) {
+    THROW_LOGIC_ERR("Invalid partition with 0 bucket");
+  }
+  metrics::count_table_op(metrics::kTablePartition, count);
+  std::vector<uint32_t> counts(n);
+  size_t out_of_range = functions::simd_vector_histogram(bucket_ids, n, counts.data());
+  if (out_of_range > 0) {
+    THROW_LOGIC_ERR("{} bucket ids out of range [0, {})", out_of_range, n);
+  }
+  // position of every row in its bucket, shared by rows & all loaded columns
+  const uint32_t* ids = bucket_ids.Data();
+  std::vector<uint32_t> positions(count);
+  std::vector<uint32_t> cursors(n, 0);
+  for (size_t i = 0; i < count; i++) {
+    positions[i] = cursors[ids[i]]++;
+  }
+
+  Table** tables = reinterpret_cast<Table**>(ctx_.ArenaAllocate(sizeof(Table*) * n));
+  for (uint32_t b = 0; b < n; b++) {
+    tables[b] = NewEmptyTable();
+  }
+  std::vector<std::vector<const uint8_t*>> bucket_ptrs(n);
+  for (size_t r = 0; r < rows_.size(); r++) {
+    Vector<Pointer> ptrs = rows_[r].GetRowPtrs();
+    const uint8_t* const* raw_ptrs = reinterpret_cast<const uint8_t* const*>(ptrs.Data());
+    for (uint32_t b = 0; b < n; b++) {
+      bucket_ptrs[b].resize(counts[b]);
+    }
+    for (size_t i = 0; i < count; i++) {
+      bucket_ptrs[ids[i]][positions[i]] = raw_ptrs[i];
+    }
+    for (uint32_t b = 0; b < n; b++) {
+      tables[b]->rows_[r].Reset(std::move(bucket_ptrs[b]));
+      bucket_ptrs[b] = {};
+    }
+  }
+
+  std::vector<VectorBuf> outputs(n);
+  Table* this_table = this;
+  schema_->VisitField([&](const std::string& name, const DType& dtype, uint32_t offset) {
+    // computed columns may not be row wise, evaluated again on partitions
+    if (!IsColumnLoaded(offset) || IsComputedColumn(offset)) {
+      return;
+    }
+    const VectorBuf& vec = *reinterpret_cast<const VectorBuf*>(reinterpret_cast<uint8_t*>(this_table) + offset);
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(vec.Data());
+    if (dtype.Elem().IsBit()) {
+      Vector<Bit> bits(vec);
+      std::vector<uint64_t*> dsts(n);
+      for (uint32_t b = 0; b < n; b++) {
+        outputs[b] = ctx_.NewVectorBuf<Bit>(counts[b]);
+        dsts[b] = outputs[b].MutableData<uint64_t>();
+      }
+      for (size_t i = 0; i < count; i++) {
+        bits_set(dsts[ids[i]], positions[i], bits[i]);
+      }
+    } else {
+      // scatter by element size, string views & pointers are moved as is
+      switch (dtype.Elem().ByteSize()) {
+        case 1: {
+          scatter_column(ctx_, data, ids, positions.data(), count, counts, absl::MakeSpan(outputs));
+          break;
+        }
+        case 2: {
+          scatter_column(ctx_, reinterpret_cast<const uint16_t*>(data), ids, positions.data(), count, counts,
+                         absl::MakeSpan(outputs));
+          break;
+        }
+        case 4: {
+          scatter_column(ctx_, reinterpret_cast<const uint32_t*>(data), ids, positions.data(), count, counts,
+                         absl::MakeSpan(outputs));
+          break;
+        }
+        case 8: {
+          scatter_column(ctx_, reinterpret_cast<const uint64_t*>(data), ids, positions.data(), count, counts,
+                         absl::MakeSpan(outputs));
+          break;
+        }
+        case sizeof(StringView): {
+          scatter_column(ctx_, reinterpret_cast<const StringView*>(data), ids, positions.data(), count, counts,
+                         absl::MakeSpan(outputs));
+          break;
+        }
+        default: {
+          // reloaded lazily from rows
+          RUDF_ERROR("Unsupported column:{} with dtype:{} to partition", name, dtype);
+          return;
+        }
+      }
+    }
+    for (uint32_t b = 0; b < n; b++) {
+      tables[b]->SetColumn(offset, outputs[b]);
+    }
+  });
+  return absl::Span<Table*>(tables, n);
 }
 
 Table* Table::Head(uint32_t k) {
@@ -638,8 +1087,8 @@ Table* Table::Tail(uint32_t k) {
 
 template <typename T>
 Table* Table::OrderBy(Vector<T> by, bool descending) {
-  auto tmp_indices = GetIndices();
-  Vector<int32_t> indices(tmp_indices);
+  metrics::count_table_op(metrics::kTableOrderBy, by.Size());
+  Vector<int32_t> indices = GetIndices();
   functions::simd_vector_sort_key_value(ctx_, by, indices, descending);
   Table* new_table = Clone();
   for (auto& rows : new_table->rows_) {
@@ -650,14 +1099,393 @@ Table* Table::OrderBy(Vector<T> by, bool descending) {
 }
 template <typename T>
 Table* Table::Topk(Vector<T> by, uint32_t k, bool descending) {
-  auto tmp_indices = GetIndices();
-  Vector<int32_t> indices(tmp_indices);
-  if (k > indices.Size()) {
-    k = indices.Size();
+  return Topk(by, k, descending, Vector<Bit>());
+}
+
+template <typename T>
+Table* Table::Topk(Vector<T> by, uint32_t k, bool descending, Vector<Bit> mask) {
+  if (by.Size() != Count()) {
+    THROW_LOGIC_ERR("Invalid topk column with size:{}, while table row size:{}", by.Size(), Count());
+  }
+  metrics::count_table_op(metrics::kTableTopk, by.Size());
+  return GatherRows(TopkIndices(by.Data(), by.Size(), k, descending, mask, {}));
+}
+
+Table* Table::Diversify(absl::Span<const StringView> columns, uint32_t window, uint32_t max_per_window) {
+  if (window == 0 || max_per_window == 0) {
+    THROW_LOGIC_ERR("Invalid diversify window:{} with max_per_window:{}", window, max_per_window);
+  }
+  DistinctGroups groups = DistinctByColumns(columns);
+  const std::vector<int32_t>& row_groups = groups.row_groups;
+  size_t n = row_groups.size();
+  size_t group_count = groups.group_heads.size();
+  VectorBuf indices_buf = ctx_.NewVectorBuf<int32_t>(n);
+  int32_t* indices = indices_buf.MutableData<int32_t>();
+
+  // category counts of the last `window - 1` placed rows, kept by a ring buffer of category codes.
+  std::vector<uint32_t> window_counts(group_count, 0);
+  std::vector<int32_t> recent_groups(window - 1);
+  size_t recent_cursor = 0;
+  // rows skipped because their category was capped, linked per category in current order, the head row of every
+  // non empty list is in a min-heap so the earliest row of an uncapped category is found by popping capped ones.
+  std::vector<int32_t> deferred_head(group_count, -1);
+  std::vector<int32_t> deferred_tail(group_count, -1);
+  std::vector<int32_t> deferred_next(n, -1);
+  using DeferredEntry = std::pair<int32_t, int32_t>;
+  std::priority_queue<DeferredEntry, std::vector<DeferredEntry>, std::greater<DeferredEntry>> deferred_heads;
+  std::vector<DeferredEntry> capped;
+
+  auto allowed = [&](int32_t group) { return window_counts[group] < max_per_window; };
+  auto defer = [&](int32_t row) {
+    int32_t group = row_groups[row];
+    if (deferred_head[group] < 0) {
+      deferred_head[group] = row;
+      deferred_heads.emplace(row, group);
+    } else {
+      deferred_next[deferred_tail[group]] = row;
+    }
+    deferred_tail[group] = row;
+  };
+  auto pop_deferred = [&](int32_t group) {
+    int32_t row = deferred_head[group];
+    deferred_head[group] = deferred_next[row];
+    if (deferred_head[group] >= 0) {
+      deferred_heads.emplace(deferred_head[group], group);
+    }
+    return row;
+  };
+
+  size_t next = 0;
+  for (size_t pos = 0; pos < n; pos++) {
+    int32_t chosen = -1;
+    capped.clear();
+    while (!deferred_heads.empty()) {
+      DeferredEntry entry = deferred_heads.top();
+      deferred_heads.pop();
+      if (allowed(entry.second)) {
+        chosen = pop_deferred(entry.second);
+        break;
+      }
+      capped.emplace_back(entry);
+    }
+    for (auto& entry : capped) {
+      deferred_heads.emplace(entry);
+    }
+    while (chosen < 0 && next < n) {
+      int32_t row = static_cast<int32_t>(next++);
+      if (allowed(row_groups[row])) {
+        chosen = row;
+      } else {
+        defer(row);
+      }
+    }
+    if (chosen < 0) {
+      // every remaining row is capped, relax the cap with the earliest one.
+      DeferredEntry entry = deferred_heads.top();
+      deferred_heads.pop();
+      chosen = pop_deferred(entry.second);
+    }
+    indices[pos] = chosen;
+    if (!recent_groups.empty()) {
+      if (pos >= recent_groups.size()) {
+        window_counts[recent_groups[recent_cursor]]--;
+      }
+      int32_t group = row_groups[chosen];
+      recent_groups[recent_cursor] = group;
+      window_counts[group]++;
+      recent_cursor = (recent_cursor + 1) % recent_groups.size();
+    }
+  }
+  return GatherRows(Vector<int32_t>(indices_buf));
+}
+
+template <typename T>
+Table* Table::Mmr(Vector<T> scores, Vector<T> embeddings, uint32_t k, T lambda) {
+  size_t n = Count();
+  if (scores.Size() != n) {
+    THROW_LOGIC_ERR("Invalid mmr scores with size:{}, while table row size:{}", scores.Size(), n);
+  }
+  if (n == 0 || embeddings.Size() == 0 || embeddings.Size() % n != 0) {
+    THROW_LOGIC_ERR("Invalid mmr embeddings with size:{}, while table row size:{}", embeddings.Size(), n);
+  }
+  size_t dim = embeddings.Size() / n;
+  size_t select_n = std::min<size_t>(k, n);
+  auto embedding = [&](size_t row) { return Vector<T>(embeddings.Data() + row * dim, dim); };
+
+  VectorBuf indices_buf = ctx_.NewVectorBuf<int32_t>(select_n);
+  int32_t* indices = indices_buf.MutableData<int32_t>();
+  // max similarity to selected rows of every row, updated only against the last selected row.
+  std::vector<T> max_similarity(n, 0);
+  std::vector<uint8_t> selected(n, 0);
+  for (size_t pos = 0; pos < select_n; pos++) {
+    size_t best = n;
+    T best_score = std::numeric_limits<T>::lowest();
+    for (size_t i = 0; i < n; i++) {
+      if (selected[i]) {
+        continue;
+      }
+      T mmr_score = lambda * scores[i] - (1 - lambda) * max_similarity[i];
+      if (best == n || mmr_score > best_score) {
+        best = i;
+        best_score = mmr_score;
+      }
+    }
+    selected[best] = 1;
+    indices[pos] = static_cast<int32_t>(best);
+    if (pos + 1 == select_n) {
+      break;
+    }
+    Vector<T> best_embedding = embedding(best);
+    for (size_t i = 0; i < n; i++) {
+      if (selected[i]) {
+        continue;
+      }
+      T similarity = 1 - functions::simd_vector_cosine_distance<T>(embedding(i), best_embedding);
+      if (pos == 0 || similarity > max_similarity[i]) {
+        max_similarity[i] = similarity;
+      }
+    }
+  }
+  return GatherRows(Vector<int32_t>(indices_buf));
+}
+
+static VectorBuf new_row_ids(Context& ctx, size_t n) {
+  VectorBuf ids = ctx.NewVectorBuf<uint64_t>(n);
+  std::iota(ids.MutableData<uint64_t>(), ids.MutableData<uint64_t>() + n, 0);
+  return ids;
+}
+
+Table* Table::Shuffle(uint64_t seed) {
+  size_t n = Count();
+  VectorBuf keys = new_row_ids(ctx_, n);
+  uint64_t* key_data = keys.MutableData<uint64_t>();
+  functions::philox_random(seed, ctx_.GetRequestId(), key_data, key_data, n);
+  return OrderBy(Vector<uint64_t>(keys), false);
+}
+
+template <typename T>
+Table* Table::WeightedSample(Vector<T> weights, uint32_t k, uint64_t seed) {
+  size_t n = Count();
+  if (weights.Size() != n) {
+    THROW_LOGIC_ERR("Invalid weighted sample weights with size:{}, while table row size:{}", weights.Size(), n);
+  }
+  Vector<double> uniforms = functions::simd_vector_rand_uniform(ctx_, Vector<uint64_t>(new_row_ids(ctx_, n)), seed);
+  VectorBuf keys_buf = ctx_.NewVectorBuf<double>(n);
+  double* keys = keys_buf.MutableData<double>();
+  size_t positive = 0;
+  for (size_t i = 0; i < n; i++) {
+    double w = static_cast<double>(weights[i]);
+    if (w > 0) {
+      // log(u^(1/w)), u in (0, 1]
+      keys[i] = std::log(1.0 - uniforms[i]) / w;
+      positive++;
+    } else {
+      keys[i] = -std::numeric_limits<double>::infinity();
+    }
+  }
+  return Topk(Vector<double>(keys_buf), static_cast<uint32_t>(std::min<size_t>(k, positive)), true);
+}
+
+Table* Table::Topk(absl::Span<const StringView> columns, absl::Span<const bool> descending, uint32_t k,
+                   Vector<Bit> mask) {
+  if (columns.empty() || columns.size() != descending.size()) {
+    THROW_LOGIC_ERR("Invalid topk columns size:{} with descending size:{}", columns.size(), descending.size());
+  }
+  metrics::count_table_op(metrics::kTableTopk, Count());
+  std::vector<TopkTieBreaker> tie_breakers;
+  DType by_dtype;
+  const uint8_t* by = nullptr;
+  for (size_t i = 0; i < columns.size(); i++) {
+    auto result = schema_->GetField(columns[i]);
+    if (!result.ok()) {
+      THROW_LOGIC_ERR("No column:{} found.", columns[i]);
+    }
+    auto [dtype, offset] = result.value();
+    const uint8_t* data = GetColumnByOffset(offset).ReadableData<uint8_t>();
+    if (i == 0) {
+      by_dtype = dtype.Elem();
+      by = data;
+    } else {
+      tie_breakers.emplace_back(TopkTieBreaker{dtype.Elem(), data, descending[i]});
+    }
+  }
+  size_t n = Count();
+  Vector<int32_t> indices;
+  switch (by_dtype.GetFundamentalType()) {
+    case DATA_F64: {
+      indices = TopkIndices(reinterpret_cast<const double*>(by), n, k, descending[0], mask, tie_breakers);
+      break;
+    }
+    case DATA_F32: {
+      indices = TopkIndices(reinterpret_cast<const float*>(by), n, k, descending[0], mask, tie_breakers);
+      break;
+    }
+    case DATA_U64: {
+      indices = TopkIndices(reinterpret_cast<const uint64_t*>(by), n, k, descending[0], mask, tie_breakers);
+      break;
+    }
+    case DATA_I64: {
+      indices = TopkIndices(reinterpret_cast<const int64_t*>(by), n, k, descending[0], mask, tie_breakers);
+      break;
+    }
+    case DATA_U32: {
+      indices = TopkIndices(reinterpret_cast<const uint32_t*>(by), n, k, descending[0], mask, tie_breakers);
+      break;
+    }
+    case DATA_I32: {
+      indices = TopkIndices(reinterpret_cast<const int32_t*>(by), n, k, descending[0], mask, tie_breakers);
+      break;
+    }
+    default: {
+      THROW_LOGIC_ERR("Invalid column:{} with dtype:{} to topk.", columns[0], by_dtype);
+    }
+  }
+  return GatherRows(indices);
+}
+
+template <typename T>
+static int compare_value(const T* data, int32_t left, int32_t right) {
+  if (data[left] < data[right]) {
+    return -1;
+  }
+  if (data[right] < data[left]) {
+    return 1;
+  }
+  return 0;
+}
+
+static int compare_value(const DType& dtype, const uint8_t* data, int32_t left, int32_t right) {
+  switch (dtype.GetFundamentalType()) {
+    case DATA_F64: {
+      return compare_value(reinterpret_cast<const double*>(data), left, right);
+    }
+    case DATA_F32: {
+      return compare_value(reinterpret_cast<const float*>(data), left, right);
+    }
+    case DATA_U64: {
+      return compare_value(reinterpret_cast<const uint64_t*>(data), left, right);
+    }
+    case DATA_I64: {
+      return compare_value(reinterpret_cast<const int64_t*>(data), left, right);
+    }
+    case DATA_U32: {
+      return compare_value(reinterpret_cast<const uint32_t*>(data), left, right);
+    }
+    case DATA_I32: {
+      return compare_value(reinterpret_cast<const int32_t*>(data), left, right);
+    }
+    case DATA_U16: {
+      return compare_value(reinterpret_cast<const uint16_t*>(data), left, right);
+    }
+    case DATA_F16: {
+      return compare_value(reinterpret_cast<const Float16*>(data), left, right);
+    }
+    case DATA_BF16: {
+      return compare_value(reinterpret_cast<const BFloat16*>(data), left, right);
+    }
+    case DATA_I16: {
+      return compare_value(reinterpret_cast<const int16_t*>(data), left, right);
+    }
+    case DATA_U8: {
+      return compare_value(reinterpret_cast<const uint8_t*>(data), left, right);
+    }
+    case DATA_I8: {
+      return compare_value(reinterpret_cast<const int8_t*>(data), left, right);
+    }
+    case DATA_STRING_VIEW: {
+      return compare_value(reinterpret_cast<const StringView*>(data), left, right);
+    }
+    default: {
+      THROW_LOGIC_ERR("Invalid dtype:{} to compare.", dtype);
+    }
+  }
+}
+
+template <typename T>
+Vector<int32_t> Table::TopkIndices(const T* by, size_t n, uint32_t k, bool descending, Vector<Bit> mask,
+                                   absl::Span<const TopkTieBreaker> tie_breakers) {
+  // one mask word per block
+  constexpr size_t kBlockSize = 64;
+  const uint64_t* mask_bits = nullptr;
+  if (mask.Size() > 0) {
+    if (mask.Size() != n) {
+      THROW_LOGIC_ERR("Invalid topk mask with size:{}, while table row size:{}", mask.Size(), n);
+    }
+    mask_bits = reinterpret_cast<const uint64_t*>(mask.Data());
+  }
+  if (k > n) {
+    k = n;
+  }
+  if (k == 0) {
+    return {};
+  }
+  auto before = [&](int32_t left, int32_t right) {
+    if (by[left] != by[right]) {
+      return descending ? by[left] > by[right] : by[left] < by[right];
+    }
+    for (auto& tie_breaker : tie_breakers) {
+      int cmp = compare_value(tie_breaker.dtype, tie_breaker.data, left, right);
+      if (cmp != 0) {
+        return tie_breaker.descending ? cmp > 0 : cmp < 0;
+      }
+    }
+    return left < right;
+  };
+
+  // bounded heap of selected rows, the top is the last ranked row
+  std::vector<int32_t> heap;
+  heap.reserve(k);
+  for (size_t block = 0; block < n; block += kBlockSize) {
+    size_t block_end = std::min(n, block + kBlockSize);
+    uint64_t block_mask = mask_bits == nullptr ? ~0ULL : mask_bits[block / kBlockSize];
+    if (block_mask == 0) {
+      continue;
+    }
+    if (heap.size() == k) {
+      T threshold = by[heap.front()];
+      T best = by[block];
+      if (descending) {
+        for (size_t i = block + 1; i < block_end; i++) {
+          best = std::max(best, by[i]);
+        }
+      } else {
+        for (size_t i = block + 1; i < block_end; i++) {
+          best = std::min(best, by[i]);
+        }
+      }
+      // later rows lose ties on the whole key by row order, tie breaker columns may still let them win
+      bool skip = false;
+      if (tie_breakers.empty()) {
+        skip = descending ? !(best > threshold) : !(best < threshold);
+      } else {
+        skip = descending ? best < threshold : best > threshold;
+      }
+      if (skip) {
+        continue;
+      }
+    }
+    for (size_t i = block; i < block_end; i++) {
+      if (((block_mask >> (i - block)) & 1) == 0) {
+        continue;
+      }
+      int32_t row = static_cast<int32_t>(i);
+      if (heap.size() < k) {
+        heap.emplace_back(row);
+        std::push_heap(heap.begin(), heap.end(), before);
+      } else if (before(row, heap.front())) {
+        std::pop_heap(heap.begin(), heap.end(), before);
+        heap.back() = row;
+        std::push_heap(heap.begin(), heap.end(), before);
+      }
+    }
   }
+  std::sort_heap(heap.begin(), heap.end(), before);
+  VectorBuf indices = ctx_.NewVectorBuf<int32_t>(heap.size());
+  memcpy(indices.MutableData<int32_t>(), heap.data(), sizeof(int32_t) * heap.size());
+  return Vector<int32_t>(indices);
+}
 
-  functions::simd_vector_topk_key_value(ctx_, by, indices, k, descending);
-  indices = indices.Resize(k);
+Table* Table::GatherRows(Vector<int32_t> indices) {
   Table* new_table = Clone();
   for (auto& rows : new_table->rows_) {
     rows.Gather(indices);
@@ -674,7 +1502,7 @@ Table* Table::SubTable(std::vector<int32_t>& indices) {
   Table* this_table = this;
   schema_->VisitField([&](const std::string& name, const DType& dtype, uint32_t offset) {
     uint8_t* vec_ptr = reinterpret_cast<uint8_t*>(this_table) + offset;
-    if (!IsColumnLoaded(offset)) {
+    if (!IsColumnLoaded(offset) || IsComputedColumn(offset)) {
       // lazy load column
       return;
     }
@@ -724,6 +1552,7 @@ Table* Table::OrderBy(StringView column, bool descending) {
 
 template <typename T>
 absl::Span<Table*> Table::GroupBy(const T* by, size_t n) {
+  metrics::count_table_op(metrics::kTableGroupBy, n);
   absl::flat_hash_map<T, std::vector<int32_t>> group_idxs;
   for (size_t i = 0; i < n; i++) {
     group_idxs[by[i]].emplace_back(static_cast<int32_t>(i));
@@ -761,20 +1590,35 @@ absl::Span<Table*> Table::GroupBy(Vector<T> by) {
 }
 
 absl::Span<Table*> Table::GroupBy(absl::Span<const StringView> columns) {
-  auto indice_table = DistinctByColumns(columns);
-  Table** group_tables = reinterpret_cast<Table**>(ctx_.ArenaAllocate(sizeof(Table*) * indice_table.size()));
-  size_t table_idx = 0;
-  for (auto& [indice, duplicate_indices] : indice_table) {
-    duplicate_indices.emplace_back(indice);
-    Table* new_table = SubTable(duplicate_indices);
-    group_tables[table_idx] = new_table;
-    table_idx++;
+  metrics::count_table_op(metrics::kTableGroupBy, Count());
+  DistinctGroups groups = DistinctByColumns(columns);
+  size_t group_count = groups.group_heads.size();
+  // counting sort row indices by group
+  std::vector<int32_t> group_offsets(group_count + 1, 0);
+  for (auto group : groups.row_groups) {
+    group_offsets[group + 1]++;
+  }
+  for (size_t i = 0; i < group_count; i++) {
+    group_offsets[i + 1] += group_offsets[i];
+  }
+  std::vector<int32_t> group_cursors(group_offsets.begin(), group_offsets.end() - 1);
+  std::vector<int32_t> sorted_indices(groups.row_groups.size());
+  for (size_t i = 0; i < groups.row_groups.size(); i++) {
+    sorted_indices[group_cursors[groups.row_groups[i]]++] = static_cast<int32_t>(i);
   }
-  return absl::Span<Table*>(group_tables, indice_table.size());
+
+  Table** group_tables = reinterpret_cast<Table**>(ctx_.ArenaAllocate(sizeof(Table*) * group_count));
+  for (size_t i = 0; i < group_count; i++) {
+    std::vector<int32_t> indices(sorted_indices.begin() + group_offsets[i],
+                                 sorted_indices.begin() + group_offsets[i + 1]);
+    group_tables[i] = SubTable(indices);
+  }
+  return absl::Span<Table*>(group_tables, group_count);
 }
 
 template <typename T>
 Vector<Bit> Table::Dedup(const T* data, size_t n, size_t k) {
+  metrics::count_table_op(metrics::kTableDedup, n);
   using DedupMap = absl::flat_hash_map<T, uint32_t>;
   DedupMap dedup_map;
   dedup_map.reserve(n);
@@ -854,55 +1698,148 @@ Vector<Bit> Table::Dedup(StringView column, uint32_t k) {
   return bits;
 }
 
+Vector<Bit> Table::Dedup(absl::Span<const StringView> columns, uint32_t k) {
+  if (columns.size() == 1) {
+    return Dedup(columns[0], k);
+  }
+  metrics::count_table_op(metrics::kTableDedup, Count());
+  DistinctGroups groups = DistinctByColumns(columns);
+  size_t n = groups.row_groups.size();
+  size_t bits_n = n / 64;
+  if (n % 64 > 0) {
+    bits_n++;
+  }
+  uint64_t* bits = reinterpret_cast<uint64_t*>(ctx_.ArenaAllocate(sizeof(uint64_t) * bits_n));
+  std::vector<uint32_t> group_counts(groups.group_heads.size(), 0);
+  for (size_t i = 0; i < n; i++) {
+    size_t exist_n = group_counts[groups.row_groups[i]]++;
+    bits_set(bits, i, exist_n < k);
+  }
+  VectorBuf vdata(bits, n, sizeof(uint64_t) * bits_n);
+  return Vector<Bit>(vdata);
+}
+
 absl::Status Table::Distinct(absl::Span<const StringView> columns) {
-  Vector<Bit> select;
-  for (auto column : columns) {
-    Vector<Bit> mask = Dedup(column, 1);
-    if (select.Size() == 0) {
-      select = mask;
-    } else {
-      functions::simd_vector_bits_and(select, mask, select);
+  DoFilter(Dedup(columns, 1));
+  return absl::OkStatus();
+}
+
+Vector<uint32_t> Table::RowNumber() { return functions::simd_vector_row_number(ctx_, Count()); }
+
+template <typename T>
+static Vector<uint32_t> rank_column(Context& ctx, const VectorBuf& vec_data, size_t n, bool dense) {
+  Vector<T> column(reinterpret_cast<const T*>(vec_data.Data()), n);
+  return dense ? functions::simd_vector_dense_rank(ctx, column) : functions::simd_vector_rank(ctx, column);
+}
+
+Vector<uint32_t> Table::Rank(StringView column, bool dense) {
+  auto result = schema_->GetField(column);
+  if (!result.ok()) {
+    THROW_LOGIC_ERR("No column:{} found.", column);
+  }
+  auto [dtype, offset] = result.value();
+  size_t row_size = Count();
+  VectorBuf vec_data = GetColumnByOffset(offset);
+  switch (dtype.GetFundamentalType()) {
+    case DATA_F64: {
+      return rank_column<double>(ctx_, vec_data, row_size, dense);
+    }
+    case DATA_F32: {
+      return rank_column<float>(ctx_, vec_data, row_size, dense);
+    }
+    case DATA_U64: {
+      return rank_column<uint64_t>(ctx_, vec_data, row_size, dense);
+    }
+    case DATA_I64: {
+      return rank_column<int64_t>(ctx_, vec_data, row_size, dense);
+    }
+    case DATA_U32: {
+      return rank_column<uint32_t>(ctx_, vec_data, row_size, dense);
+    }
+    case DATA_I32: {
+      return rank_column<int32_t>(ctx_, vec_data, row_size, dense);
+    }
+    case DATA_STRING_VIEW: {
+      return rank_column<StringView>(ctx_, vec_data, row_size, dense);
+    }
+    default: {
+      THROW_LOGIC_ERR("Unsupported rank column:{} with dtype:{}", column, dtype);
     }
   }
-  DoFilter(select);
-  return absl::OkStatus();
 }
 
-typename Table::DistinctIndiceTable Table::DistinctByColumns(absl::Span<const StringView> columns) {
+Vector<uint64_t> Table::HashColumns(absl::Span<const StringView> columns) {
   size_t count = Count();
-  std::vector<DType> key_dtypes;
-  std::vector<VectorBuf> key_vecs;
-  for (auto column : columns) {
-    auto result = schema_->GetField(column);
+  if (columns.empty()) {
+    VectorBuf vdata = ctx_.NewVectorBuf<uint64_t>(count);
+    memset(vdata.MutableData<uint64_t>(), 0, sizeof(uint64_t) * count);
+    return Vector<uint64_t>(vdata);
+  }
+  Vector<uint64_t> hashes;
+  for (size_t i = 0; i < columns.size(); i++) {
+    auto result = schema_->GetField(columns[i]);
     if (!result.ok()) {
-      THROW_LOGIC_ERR("No column:{} found.", column);
+      THROW_LOGIC_ERR("No column:{} found.", columns[i]);
     }
     auto [dtype, offset] = result.value();
     VectorBuf vec_data = GetColumnByOffset(offset);
-    key_dtypes.emplace_back(dtype.Elem());
-    key_vecs.emplace_back(vec_data);
+    auto column_hashes = hash_column(ctx_, dtype.Elem(), vec_data.ReadableData<uint8_t>(), count);
+    if (!column_hashes.ok()) {
+      THROW_LOGIC_ERR("Invalid column:{} with dtype:{} to hash.", columns[i], dtype);
+    }
+    hashes = i == 0 ? column_hashes.value() : functions::simd_vector_hash_combine(ctx_, hashes, column_hashes.value());
   }
-  DistinctIndiceTable indice_table;
-  using DistinctTable = absl::flat_hash_map<DistinctKey, int32_t, DistinctKeyHash, DistinctKeyCompare>;
-  DistinctTable distinc_table;
-  distinc_table.reserve(count);
+  return hashes;
+}
 
-  for (size_t i = 0; i < count; i++) {
-    DistinctKey key;
-    for (size_t j = 0; j < key_dtypes.size(); j++) {
-      key.emplace_back(
-          std::make_pair(&key_dtypes[j], key_vecs[j].ReadableData<uint8_t>() + key_dtypes[j].ByteSize() * i));
+typename Table::DistinctGroups Table::DistinctByColumns(absl::Span<const StringView> columns) {
+  size_t count = Count();
+  Vector<uint64_t> hashes = HashColumns(columns);
+  std::vector<std::pair<DType, const uint8_t*>> keys;
+  for (auto column : columns) {
+    auto [dtype, offset] = schema_->GetField(column).value();
+    keys.emplace_back(dtype.Elem(), GetColumnByOffset(offset).ReadableData<uint8_t>());
+  }
+  auto key_equal = [&](int32_t left, int32_t right) {
+    for (auto& [dtype, data] : keys) {
+      size_t width = dtype.ByteSize();
+      if (!dtype.Equal(data + width * left, data + width * right)) {
+        return false;
+      }
     }
+    return true;
+  };
 
-    auto [iter, success] = distinc_table.emplace(std::move(key), static_cast<int32_t>(i));
-    if (success) {
-      indice_table.emplace(static_cast<int32_t>(i), std::vector<int32_t>{});
-    } else {
-      indice_table[iter->second].emplace_back(static_cast<int32_t>(i));
+  DistinctGroups groups;
+  groups.row_groups.resize(count);
+  // open addressing table of group index, keys are only compared when hashes are equal
+  size_t capacity = 16;
+  while (capacity < count * 2) {
+    capacity <<= 1;
+  }
+  size_t mask = capacity - 1;
+  std::vector<int32_t> slots(capacity, -1);
+  for (size_t i = 0; i < count; i++) {
+    uint64_t h = hashes[i];
+    size_t pos = h & mask;
+    while (true) {
+      int32_t group = slots[pos];
+      if (group < 0) {
+        group = static_cast<int32_t>(groups.group_heads.size());
+        slots[pos] = group;
+        groups.group_heads.emplace_back(static_cast<int32_t>(i));
+        groups.row_groups[i] = group;
+        break;
+      }
+      int32_t head = groups.group_heads[group];
+      if (hashes[head] == h && key_equal(head, static_cast<int32_t>(i))) {
+        groups.row_groups[i] = group;
+        break;
+      }
+      pos = (pos + 1) & mask;
     }
   }
-
-  return indice_table;
+  return groups;
 }
 
 absl::Status Table::UnloadColumn(const std::string& name) {
@@ -913,12 +1850,47 @@ absl::Status Table::UnloadColumn(const std::string& name) {
   uint32_t offset = offset_result.value();
   uint32_t idx = GetIdxByOffset(offset);
   auto* column = GetTableSchema()->GetColumnByIdx(idx);
-  if (column == nullptr || column->schema == nullptr) {
+  if (column == nullptr || (column->schema == nullptr && !column->computed)) {
     RUDF_LOG_RETURN_FMT_ERROR("Invalid column:{} to unload", name);
   }
-  uint8_t* vec_ptr = reinterpret_cast<uint8_t*>(this) + offset;
-  VectorBuf* vdata = (reinterpret_cast<VectorBuf*>(vec_ptr));
-  vdata->SetSize(0);  // clear size for reuse
+  if (column->computed) {
+    SetColumn(offset, VectorBuf());
+  } else {
+    uint8_t* vec_ptr = reinterpret_cast<uint8_t*>(this) + offset;
+    VectorBuf* vdata = (reinterpret_cast<VectorBuf*>(vec_ptr));
+    vdata->SetSize(0);  // clear size for reuse
+  }
+  InvalidateComputedColumns(offset);
+  return absl::OkStatus();
+}
+absl::Status Table::SplitToColumns(const std::string& column, StringView sep, absl::Span<const std::string> names) {
+  auto strs = Get<StringView>(column);
+  if (!strs.ok()) {
+    return strs.status();
+  }
+  std::vector<DType> dtypes;
+  std::vector<uint32_t> offsets;
+  for (auto& name : names) {
+    auto result = schema_->GetField(name);
+    if (!result.ok()) {
+      return result.status();
+    }
+    auto [dtype, offset] = result.value();
+    if (IsComputedColumn(offset)) {
+      RUDF_LOG_RETURN_FMT_ERROR("Can not split into computed column:{}", name);
+    }
+    dtypes.emplace_back(dtype.Elem());
+    offsets.emplace_back(offset);
+  }
+  std::vector<VectorBuf> columns;
+  auto status = functions::simd_vector_split_to_columns(ctx_, strs.value(), sep, dtypes, columns);
+  if (!status.ok()) {
+    return status;
+  }
+  for (size_t i = 0; i < offsets.size(); i++) {
+    SetColumn(offsets[i], columns[i]);
+    InvalidateComputedColumns(offsets[i]);
+  }
   return absl::OkStatus();
 }
 void Table::UnloadAllColumns() {
@@ -930,6 +1902,38 @@ void Table::UnloadAllColumns() {
       vdata->SetSize(0);  // clear size for reuse
     }
   }
+  UnloadComputedColumns();
+}
+
+void Table::UnloadComputedColumns() {
+  for (auto& column : GetTableSchema()->columns_) {
+    if (column.computed) {
+      // computed results are not reused, reset to evaluate again at next access
+      SetColumn(column.field.bytes_offset, VectorBuf());
+    }
+  }
+}
+
+void Table::InvalidateComputedColumns(uint32_t offset) {
+  // dependencies are always added before, so one pass in column order covers indirect dependents
+  std::vector<uint32_t> changed{offset};
+  for (auto& column : GetTableSchema()->columns_) {
+    if (!column.computed) {
+      continue;
+    }
+    for (uint32_t dep : column.computed->deps) {
+      if (std::find(changed.begin(), changed.end(), dep) != changed.end()) {
+        SetColumn(column.field.bytes_offset, VectorBuf());
+        changed.emplace_back(column.field.bytes_offset);
+        break;
+      }
+    }
+  }
+}
+
+bool Table::IsComputedColumn(uint32_t offset) {
+  auto* column = GetTableSchema()->GetColumnByIdx(GetIdxByOffset(offset));
+  return column != nullptr && column->computed != nullptr;
 }
 
 const RowSchema* Table::GetRowSchema(const RowSchema& schema) {
@@ -949,20 +1953,85 @@ int Table::GetRowIdx(const RowSchema& schema) {
   return -1;
 }
 
-Table* Table::Concat(Table* other) {
-  if (GetTableSchema() != other->GetTableSchema()) {
-    THROW_LOGIC_ERR("Can NOT merge table:{} to {}", other->GetTableSchema()->Name(), GetTableSchema()->Name());
+Table* Table::Concat(absl::Span<Table*> others) {
+  size_t total = Count();
+  for (Table* other : others) {
+    if (GetTableSchema() != other->GetTableSchema()) {
+      THROW_LOGIC_ERR("Can NOT merge table:{} to {}", other->GetTableSchema()->Name(), GetTableSchema()->Name());
+    }
+    total += other->Count();
   }
-  Table* new_table = Clone();
-  new_table->UnloadAllColumns();
-  for (size_t i = 0; i < new_table->rows_.size(); i++) {
-    for (size_t j = 0; j < other->rows_.size(); j++) {
-      if (new_table->rows_[i].GetSchema() == other->rows_[j].GetSchema()) {
-        new_table->rows_[i].Append(other->rows_[j].GetRawRowPtrs());
-        break;
+  std::vector<Table*> tables;
+  tables.reserve(others.size() + 1);
+  tables.emplace_back(this);
+  tables.insert(tables.end(), others.begin(), others.end());
+
+  Table* new_table = NewEmptyTable();
+  // tables of same schema hold rows of same row schemas in same order
+  for (size_t i = 0; i < rows_.size(); i++) {
+    std::vector<const uint8_t*> ptrs(total);
+    size_t cursor = 0;
+    for (Table* table : tables) {
+      const auto& src = table->rows_[i].GetRawRowPtrs();
+      if (!src.empty()) {
+        memcpy(ptrs.data() + cursor, src.data(), sizeof(const uint8_t*) * src.size());
       }
+      cursor += src.size();
     }
+    new_table->rows_[i].Reset(std::move(ptrs));
   }
+
+  schema_->VisitField([&](const std::string& name, const DType& dtype, uint32_t offset) {
+    if (IsComputedColumn(offset)) {
+      return;
+    }
+    std::vector<VectorBuf> vecs;
+    for (Table* table : tables) {
+      if (table->Count() == 0) {
+        continue;
+      }
+      const VectorBuf& vec = *reinterpret_cast<const VectorBuf*>(reinterpret_cast<uint8_t*>(table) + offset);
+      if (vec.Size() != table->Count()) {
+        // lazy load from rows
+        return;
+      }
+      vecs.emplace_back(vec);
+    }
+    if (vecs.empty()) {
+      return;
+    }
+    DType elem_dtype = dtype.Elem();
+    VectorBuf new_vec;
+    size_t cursor = 0;
+    if (elem_dtype.IsBit()) {
+      new_vec = ctx_.NewVectorBuf<Bit>(total);
+      uint8_t* bits = new_vec.MutableData<uint8_t>();
+      for (auto& vec : vecs) {
+        const uint8_t* src = reinterpret_cast<const uint8_t*>(vec.Data());
+        for (size_t i = 0; i < vec.Size(); i++) {
+          bits_set(bits, cursor++, bits_get(src, i));
+        }
+      }
+    } else if (elem_dtype.IsStringView()) {
+      new_vec = ctx_.NewVectorBuf<StringView>(total);
+      StringView* strs = new_vec.MutableData<StringView>();
+      for (auto& vec : vecs) {
+        const StringView* src = reinterpret_cast<const StringView*>(vec.Data());
+        std::copy(src, src + vec.Size(), strs + cursor);
+        cursor += vec.Size();
+      }
+    } else {
+      size_t elem_size = elem_dtype.ByteSize();
+      new_vec = ctx_.NewVectorBuf<uint8_t>(total * elem_size);
+      uint8_t* data = new_vec.MutableData<uint8_t>();
+      for (auto& vec : vecs) {
+        memcpy(data + cursor * elem_size, vec.Data(), vec.Size() * elem_size);
+        cursor += vec.Size();
+      }
+      new_vec.SetSize(total);
+    }
+    new_table->SetColumn(offset, new_vec);
+  });
   return new_table;
 }
 
@@ -979,6 +2048,16 @@ template Table* Table::Topk<uint64_t>(Vector<uint64_t> by, uint32_t k, bool desc
 template Table* Table::Topk<int64_t>(Vector<int64_t> by, uint32_t k, bool descending);
 template Table* Table::Topk<float>(Vector<float> by, uint32_t k, bool descending);
 template Table* Table::Topk<double>(Vector<double> by, uint32_t k, bool descending);
+template Table* Table::Topk<uint32_t>(Vector<uint32_t> by, uint32_t k, bool descending, Vector<Bit> mask);
+template Table* Table::Topk<int32_t>(Vector<int32_t> by, uint32_t k, bool descending, Vector<Bit> mask);
+template Table* Table::Topk<uint64_t>(Vector<uint64_t> by, uint32_t k, bool descending, Vector<Bit> mask);
+template Table* Table::Topk<int64_t>(Vector<int64_t> by, uint32_t k, bool descending, Vector<Bit> mask);
+template Table* Table::Topk<float>(Vector<float> by, uint32_t k, bool descending, Vector<Bit> mask);
+template Table* Table::Topk<double>(Vector<double> by, uint32_t k, bool descending, Vector<Bit> mask);
+template Table* Table::Mmr<float>(Vector<float> scores, Vector<float> embeddings, uint32_t k, float lambda);
+template Table* Table::Mmr<double>(Vector<double> scores, Vector<double> embeddings, uint32_t k, double lambda);
+template Table* Table::WeightedSample<float>(Vector<float> weights, uint32_t k, uint64_t seed);
+template Table* Table::WeightedSample<double>(Vector<double> weights, uint32_t k, uint64_t seed);
 
 template absl::Span<Table*> Table::GroupBy<double>(Vector<double> by);
 template absl::Span<Table*> Table::GroupBy<float>(Vector<float> by);
@@ -48,6 +48,9 @@ absl::StatusOr<R> eval_function(const std::string& source, Args... args);
 
 template <class R, class... Args>
 absl::StatusOr<R> eval_expression(const std::string& source, const std::vector<std::string>& arg_names, Args... args);
+
+template <class R, class... Args>
+absl::StatusOr<R> eval_table_expression(const std::string& source, const std::string& schema, Args... args);
 }  // namespace exec
 namespace table {
 
@@ -60,7 +63,12 @@ class Table : public DynObject {
 
   using PartialRows = std::pair<const RowSchema*, std::vector<const uint8_t*>>;
   using PartialRow = std::pair<const RowSchema*, const uint8_t*>;
-  using DistinctIndiceTable = absl::flat_hash_map<int32_t, std::vector<int32_t>>;
+  struct DistinctGroups {
+    // group index of every row
+    std::vector<int32_t> row_groups;
+    // first row of every group, ordered by first appearance
+    std::vector<int32_t> group_heads;
+  };
 
  public:
   using SmartPtr = std::unique_ptr<Table, Deleter>;
@@ -80,13 +88,33 @@ class Table : public DynObject {
   VectorBuf GetColumnByOffset(uint32_t offset);
 
   /**
-  ** Unload loaded column(defined by protobuf/flatbuffers/struct)
+  ** Unload loaded column(defined by protobuf/flatbuffers/struct) or computed column, computed columns depending on
+  ** it are unloaded too.
   */
   absl::Status UnloadColumn(const std::string& name);
   /**
-   ** Unload all loaded column(defined by protobuf/flatbuffers/struct)
+   ** Unload all loaded column(defined by protobuf/flatbuffers/struct) and computed columns
    */
   void UnloadAllColumns();
+  /**
+  ** Set column `name` to `v`, computed columns depending on it are unloaded.
+  */
+  template <typename T>
+  absl::Status Set(const std::string& name, T&& v) {
+    auto status = DynObject::Set(name, std::forward<T>(v));
+    if (status.ok()) {
+      auto offset = GetColumnOffset(name);
+      if (offset.ok()) {
+        InvalidateComputedColumns(offset.value());
+      }
+    }
+    return status;
+  }
+  /**
+  ** Split string column `column` by `sep` once per row and parse the `i`th field into column `names[i]` by its dtype,
+  ** computed columns depending on them are unloaded.
+  */
+  absl::Status SplitToColumns(const std::string& column, StringView sep, absl::Span<const std::string> names);
 
   template <typename... T>
   absl::Status AddRows(const std::vector<T>&... rows) {
@@ -104,6 +132,37 @@ class Table : public DynObject {
     return DoAddRows(std::move(add_rows));
   }
 
+  /**
+  ** Same as `AddRows`, loaded columns are extended by loading fields of the new rows only.
+  */
+  template <typename... T>
+  absl::Status AppendRows(const std::vector<T>&... rows) {
+    return AddRows(rows...);
+  }
+  /**
+  ** Insert `rows[i]` before current row `positions[i]` in one merge pass, `positions` must be ascending and
+  ** rows with equal position keep their given order. Loaded columns are merged with fields of the new rows.
+  */
+  template <typename... T>
+  absl::Status InsertRows(const std::vector<size_t>& positions, const std::vector<T>&... rows) {
+    std::vector<absl::StatusOr<PartialRows>> insert_results;
+    std::vector<PartialRows> insert_rows;
+    (insert_results.push_back(GetPartialRows(rows)), ...);
+
+    for (auto& result : insert_results) {
+      if (!result.ok()) {
+        return result.status();
+      }
+      insert_rows.emplace_back(std::move(result.value()));
+    }
+    return DoInsertRows(positions, std::move(insert_rows));
+  }
+  /**
+  ** Builder mode, reserve row & column capacity for `rows` rows, so that following appends keep loaded columns
+  ** without reallocating them.
+  */
+  void Reserve(size_t rows);
+
   template <typename... T>
   absl::Status InsertRow(size_t pos, const T*... row) {
     std::vector<absl::StatusOr<PartialRow>> add_results;
@@ -160,13 +219,16 @@ class Table : public DynObject {
           RUDF_LOG_RETURN_FMT_ERROR("mask size:{} mismatch table row count:{}", mask->Size(), count);
         }
       }
+      Vector<Pointer> row_ptrs = rows_[row_idx].GetRowPtrs();
       for (int i = 0; i < static_cast<int>(count); i++) {
         if (mask != nullptr) {
-          if (!(*mask)[i]) {
-            continue;
+          // skip unset bits a word a time
+          i = static_cast<int>(bits_next_set(mask->Data(), i, count));
+          if (i >= static_cast<int>(count)) {
+            break;
           }
         }
-        RowType* row = rows_[row_idx].GetRowPtrs()[i].As<RowType>();
+        RowType* row = row_ptrs[i].As<RowType>();
         if constexpr (std::is_void_v<R>) {
           f(static_cast<size_t>(i), row);
         } else {
@@ -203,8 +265,9 @@ class Table : public DynObject {
       }
       for (int i = 0; i < static_cast<int>(count); i++) {
         if (mask != nullptr) {
-          if (!(*mask)[i]) {
-            continue;
+          i = static_cast<int>(bits_next_set(mask->Data(), i, count));
+          if (i >= static_cast<int>(count)) {
+            break;
           }
         }
         if constexpr (std::is_void_v<R>) {
@@ -243,16 +306,96 @@ class Table : public DynObject {
     return filter_mask;
   }
   Table* Filter(Vector<Bit> bits);
+  /**
+  ** Mask of rows matching the boolean vector expression `source` over columns of arg `table`, e.g.
+  ** `table.score > 0.5 && table.city == "sz"`, same as `Map<Bit>(source)`.
+  */
+  absl::StatusOr<Vector<Bit>> Filter(const std::string& source) { return Map<Bit>(source); }
+  /**
+  ** Column computed by the vector expression `source` over columns of arg `table` for all rows, fields are read
+  ** from loaded columns instead of row objects. The expression is compiled once per (schema, source) and cached.
+  */
+  template <typename T>
+  absl::StatusOr<Vector<T>> Map(const std::string& source) {
+    auto result = exec::eval_table_expression<Vector<T>, Context&, Table*>(source, schema_->Name(), ctx_, this);
+    if (!result.ok()) {
+      return result.status();
+    }
+    if (result.value().Size() != Count()) {
+      RUDF_LOG_RETURN_FMT_ERROR("Expression result size:{} mismatch table row count:{}", result.value().Size(),
+                                Count());
+    }
+    return result;
+  }
 
   Vector<Bit> Dedup(StringView column, uint32_t k);
+  Vector<Bit> Dedup(absl::Span<const StringView> columns, uint32_t k);
+
+  /**
+  ** Combined 64bit hash of given columns for every row, same as `hash`/`hash_combine` of the columns for types
+  ** supported by them, all 0 without columns.
+  */
+  Vector<uint64_t> HashColumns(absl::Span<const StringView> columns);
 
+  /**
+  ** 1-based row number of every row in current table order.
+  */
+  Vector<uint32_t> RowNumber();
+  /**
+  ** rank/dense_rank of every row over current table order, adjacent rows with equal `column` value share a rank.
+  */
+  Vector<uint32_t> Rank(StringView column, bool dense = false);
+
+  /**
+  ** Split rows into the bit set ones and the others, same as `Partition` with 2 buckets.
+  */
   std::pair<Table*, Table*> Split(Vector<Bit> bits);
+  /**
+  ** Scatter every row into table `bucket_ids[i]` of `n` tables in one pass, rows keep their order in each table.
+  ** Loaded columns are scattered along with rows instead of being reloaded.
+  */
+  absl::Span<Table*> Partition(Vector<uint32_t> bucket_ids, uint32_t n);
 
   Table* OrderBy(StringView column, bool descending);
   template <typename T>
   Table* OrderBy(Vector<T> by, bool descending);
   template <typename T>
   Table* Topk(Vector<T> by, uint32_t k, bool descending);
+  /**
+  ** Topk over rows selected by `mask`, same as `Filter(mask)->Topk(by, k, descending)` without filtering all rows.
+  */
+  template <typename T>
+  Table* Topk(Vector<T> by, uint32_t k, bool descending, Vector<Bit> mask);
+  /**
+  ** Topk ordered by multiple columns, later columns break ties of former columns, rows with equal keys keep
+  ** their original order.
+  */
+  Table* Topk(absl::Span<const StringView> columns, absl::Span<const bool> descending, uint32_t k,
+              Vector<Bit> mask = {});
+  /**
+  ** Reorder rows so that every `window` consecutive rows hold at most `max_per_window` rows of the same category,
+  ** rows keep current order as much as possible, the cap is relaxed only when no remaining row satisfies it.
+  */
+  Table* Diversify(absl::Span<const StringView> columns, uint32_t window, uint32_t max_per_window);
+  Table* Diversify(StringView column, uint32_t window, uint32_t max_per_window) {
+    return Diversify(absl::Span<const StringView>(&column, 1), window, max_per_window);
+  }
+  /**
+  ** Maximal marginal relevance selection of `k` rows, `embeddings` is the row-major flatten embedding of all rows,
+  ** each selected row maximizes `lambda * score - (1 - lambda) * max cosine similarity to selected rows`.
+  */
+  template <typename T>
+  Table* Mmr(Vector<T> scores, Vector<T> embeddings, uint32_t k, T lambda);
+  /**
+  ** Shuffle rows by philox random keys of (seed, request id of context, row index), same input gives same order.
+  */
+  Table* Shuffle(uint64_t seed);
+  /**
+  ** Weighted sampling of `k` rows without replacement(Efraimidis-Spirakis), rows with non-positive weight are never
+  ** selected, selected rows are ordered by their sampling keys.
+  */
+  template <typename T>
+  Table* WeightedSample(Vector<T> weights, uint32_t k, uint64_t seed);
   Table* Head(uint32_t k);
   Table* Tail(uint32_t k);
   template <typename T>
@@ -260,8 +403,13 @@ class Table : public DynObject {
   absl::Span<Table*> GroupBy(absl::Span<const StringView> columns);
   absl::Span<Table*> GroupBy(StringView column) { return GroupBy(std::vector<StringView>{column}); }
 
-  Table* Concat(Table* other);
+  Table* Concat(Table* other) { return Concat(absl::Span<Table*>(&other, 1)); }
   Table* Concat(Table::SmartPtr& ptr) { return Concat(ptr.get()); }
+  /**
+  ** Rows of this table followed by rows of `others` in order, the output is sized once and columns loaded in all
+  ** non empty tables are concatenated instead of being reloaded.
+  */
+  Table* Concat(absl::Span<Table*> others);
 
   absl::Status Distinct(absl::Span<const StringView> columns);
   absl::Status Distinct(const std::vector<StringView>& columns) {
@@ -285,28 +433,36 @@ class Table : public DynObject {
     auto add_distinct_obj = [&](const void* p) {
       distinct_objs[add_distinct_obj_cursor++].emplace_back(reinterpret_cast<const uint8_t*>(p));
     };
-    DistinctIndiceTable indice_table = DistinctByColumns(columns);
-
-    for (auto& [indice, duplicate_indices] : indice_table) {
-      std::tuple<T*...> exist_row = LoadMutableRow<T...>(indice, std::index_sequence_for<T...>{});
-      for (auto duplicate_indice : duplicate_indices) {
-        std::tuple<T*...> to_merge_row = LoadMutableRow<T...>(duplicate_indice, std::index_sequence_for<T...>{});
-        std::apply(
-            [&](auto&... exist_row_element) {
-              std::apply(
-                  [&](auto&... merge_row_element) {
-                    if constexpr (sizeof...(T) == 1) {
-                      using RowType = first_of_variadic_t<T...>;
-                      RowType* new_row = merge(exist_row_element..., merge_row_element...);
-                      exist_row = std::tuple<T*...>(new_row);
-                    } else {
-                      exist_row = merge(exist_row_element..., merge_row_element...);
-                    }
-                  },
-                  to_merge_row);
-            },
-            exist_row);
+    DistinctGroups groups = DistinctByColumns(columns);
+    std::vector<std::tuple<T*...>> exist_rows;
+    exist_rows.reserve(groups.group_heads.size());
+    for (auto head : groups.group_heads) {
+      exist_rows.emplace_back(LoadMutableRow<T...>(head, std::index_sequence_for<T...>{}));
+    }
+    for (size_t i = 0; i < groups.row_groups.size(); i++) {
+      int32_t group = groups.row_groups[i];
+      if (groups.group_heads[group] == static_cast<int32_t>(i)) {
+        continue;
       }
+      std::tuple<T*...>& exist_row = exist_rows[group];
+      std::tuple<T*...> to_merge_row = LoadMutableRow<T...>(i, std::index_sequence_for<T...>{});
+      std::apply(
+          [&](auto&... exist_row_element) {
+            std::apply(
+                [&](auto&... merge_row_element) {
+                  if constexpr (sizeof...(T) == 1) {
+                    using RowType = first_of_variadic_t<T...>;
+                    RowType* new_row = merge(exist_row_element..., merge_row_element...);
+                    exist_row = std::tuple<T*...>(new_row);
+                  } else {
+                    exist_row = merge(exist_row_element..., merge_row_element...);
+                  }
+                },
+                to_merge_row);
+          },
+          exist_row);
+    }
+    for (auto& exist_row : exist_rows) {
       std::apply([&](auto&... exist_row_element) { (add_distinct_obj(exist_row_element), ...); }, exist_row);
       add_distinct_obj_cursor = 0;
     }
@@ -445,25 +601,10 @@ class Table : public DynObject {
   }
 
  private:
-  using DistinctKey = std::vector<std::pair<const DType*, const uint8_t*>>;
-  struct DistinctKeyHash {
-    std::size_t operator()(const DistinctKey& ks) const {
-      size_t h = ks[0].first->Hash(ks[0].second);
-      for (size_t i = 1; i < ks.size(); i++) {
-        h = h ^ (ks[i].first->Hash(ks[i].second));
-      }
-      return h;
-    }
-  };
-  struct DistinctKeyCompare {
-    bool operator()(const DistinctKey& left, const DistinctKey& right) const {
-      for (size_t i = 0; i < left.size(); i++) {
-        if (!left[i].first->Equal(left[i].second, right[i].second)) {
-          return false;
-        }
-      }
-      return true;
-    }
+  struct TopkTieBreaker {
+    DType dtype;
+    const uint8_t* data = nullptr;
+    bool descending = false;
   };
 
   Table(Context& ctx, const DynObjectSchema* s);
@@ -471,17 +612,30 @@ class Table : public DynObject {
   Table* NewTableBySchema(const std::string& schema);
   SmartPtr NewTableBySchema(const TableSchema* schema);
   Table* Clone();
+  // table with same schema and no rows
+  Table* NewEmptyTable();
 
-  std::vector<int32_t> GetIndices();
+  Vector<int32_t> GetIndices();
   void SetIndices(std::vector<int32_t>&& indices);
 
+  absl::StatusOr<size_t> CheckPartialRows(const std::vector<PartialRows>& rows);
   absl::Status DoAddRows(std::vector<PartialRows>&& rows);
+  absl::Status DoInsertRows(const std::vector<size_t>& positions, std::vector<PartialRows>&& rows);
   absl::Status InsertRow(size_t pos, const std::vector<PartialRow>& row);
+  // load rows from `start` into loaded columns, columns failed to extend are unloaded
+  void ExtendLoadedColumns(size_t start);
+  void InsertLoadedColumns(const std::vector<size_t>& positions, const std::vector<PartialRows>& rows);
+  void UnloadComputedColumns();
+  // unload computed columns depending on column at `offset` directly or indirectly
+  void InvalidateComputedColumns(uint32_t offset);
+  bool IsComputedColumn(uint32_t offset);
 
   absl::StatusOr<uint32_t> GetColumnOffset(const std::string& name);
 
   bool IsColumnLoaded(uint32_t offset);
   uint8_t* GetColumnMemory(uint32_t offset, const DType& dtype);
+  // grow column memory to hold all rows, first `keep` elements are kept
+  uint8_t* GrowColumnMemory(uint32_t offset, const DType& dtype, size_t keep);
   size_t GetColumnMemorySize(const DType& dtype);
   void SetColumnSize(const Column& column, void* p);
 
@@ -574,20 +728,27 @@ class Table : public DynObject {
   absl::Span<Table*> GroupBy(const T* by, size_t n);
 
   Table* SubTable(std::vector<int32_t>& indices);
+  Table* GatherRows(Vector<int32_t> indices);
+
+  template <typename T>
+  Vector<int32_t> TopkIndices(const T* by, size_t n, uint32_t k, bool descending, Vector<Bit> mask,
+                              absl::Span<const TopkTieBreaker> tie_breakers);
 
   void SetColumn(uint32_t offset, VectorBuf vec);
 
   absl::StatusOr<VectorBuf> GatherField(uint8_t* vec_ptr, const DType& dtype, Vector<int32_t> indices);
 
   template <typename T>
-  absl::Status LoadProtobufColumn(const Vector<Pointer>& pb_vector, const Column& column);
+  absl::Status LoadProtobufColumn(const Vector<Pointer>& pb_vector, const Column& column, T* vec);
   template <typename T>
-  absl::Status LoadFlatbuffersColumn(const Vector<Pointer>& fbs_vector, const Column& column);
+  absl::Status LoadFlatbuffersColumn(const Vector<Pointer>& fbs_vector, const Column& column, T* vec);
   template <typename T>
-  absl::Status LoadStructColumn(const Vector<Pointer>& struct_vector, const Column& column);
+  absl::Status LoadStructColumn(const Vector<Pointer>& struct_vector, const Column& column, T* vec);
 
   template <typename T>
-  absl::Status LoadColumn(const Vector<Pointer>& objs, const Column& column);
+  absl::Status LoadColumn(const Vector<Pointer>& objs, const Column& column, T* vec);
+  // load field of `objs` into `data`, which holds `objs.Size()` elements
+  absl::Status LoadColumn(const Vector<Pointer>& objs, const Column& column, uint8_t* data);
 
   absl::Status LoadColumn(const Rows& rows, const Column& column);
   const RowSchema* GetRowSchema(const RowSchema& schema);
@@ -597,11 +758,6 @@ class Table : public DynObject {
   template <typename T>
   Vector<Bit> Dedup(const T* data, size_t n, size_t k);
 
-  template <typename T>
-  absl::Status Set(const std::string& name, T&& v) {
-    return DynObject::Set(name, std::forward<T>(v));
-  }
-
   template <typename R>
   VisitStatusCode HandleIteratorValue(R v) {
     if constexpr (std::is_same_v<VisitStatusCode, R>) {
@@ -617,7 +773,7 @@ class Table : public DynObject {
     }
   }
 
-  DistinctIndiceTable DistinctByColumns(absl::Span<const StringView> columns);
+  DistinctGroups DistinctByColumns(absl::Span<const StringView> columns);
   void DoFilter(Vector<Bit> bits);
 
   template <typename TupleLike, std::size_t I = 0>
@@ -658,6 +814,7 @@ class Table : public DynObject {
   Context& ctx_;
   std::vector<int32_t> indices_;
   std::vector<Rows> rows_;
+  size_t reserved_rows_ = 0;
   friend class TableSchema;
 };
 }  // namespace table
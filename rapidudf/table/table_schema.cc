@@ -15,6 +15,8 @@
  */
 #include "rapidudf/table/table_schema.h"
 #include <fmt/format.h>
+#include <algorithm>
+#include <cctype>
 #include <memory>
 #include "rapidudf/log/log.h"
 #include "rapidudf/meta/dtype_enums.h"
@@ -73,6 +75,58 @@ absl::Status TableSchema::AddColumn(const std::string& name, const DType& dtype,
   return absl::OkStatus();
 }
 
+absl::Status TableSchema::AddComputedColumn(const std::string& name, const DType& dtype, const std::string& expr,
+                                            ComputedColumn::EvalFunc&& eval) {
+  auto computed = std::make_shared<ComputedColumn>();
+  computed->expr = expr;
+  computed->eval = std::move(eval);
+  // dependencies are columns referenced as `table.<column>`, member calls like `table.filter(` are skipped
+  static const std::string kTableArg = "table.";
+  auto is_ident_char = [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; };
+  size_t pos = 0;
+  while ((pos = expr.find(kTableArg, pos)) != std::string::npos) {
+    bool is_arg = pos == 0 || !(is_ident_char(expr[pos - 1]) || expr[pos - 1] == '.');
+    pos += kTableArg.size();
+    size_t end = pos;
+    while (end < expr.size() && is_ident_char(expr[end])) {
+      end++;
+    }
+    std::string ref = expr.substr(pos, end - pos);
+    pos = end;
+    if (!is_arg) {
+      continue;
+    }
+    if (ref == name) {
+      RUDF_LOG_RETURN_FMT_ERROR("Computed column:{} references itself", name);
+    }
+    size_t next = end;
+    while (next < expr.size() && std::isspace(static_cast<unsigned char>(expr[next]))) {
+      next++;
+    }
+    if (next < expr.size() && expr[next] == '(') {
+      continue;
+    }
+    auto found = std::find_if(columns_.begin(), columns_.end(), [&](const Column& c) { return c.name == ref; });
+    if (found == columns_.end()) {
+      RUDF_LOG_RETURN_FMT_ERROR("Computed column:{} references column:{} not added before", name, ref);
+    }
+    if (std::find(computed->deps.begin(), computed->deps.end(), found->field.bytes_offset) == computed->deps.end()) {
+      computed->deps.emplace_back(found->field.bytes_offset);
+    }
+  }
+
+  auto result = Add(name, dtype);
+  if (!result.ok()) {
+    return result.status();
+  }
+  Column column;
+  column.name = name;
+  column.field = result.value();
+  column.computed = std::move(computed);
+  columns_.emplace_back(std::move(column));
+  return absl::OkStatus();
+}
+
 bool TableSchema::ExistColumn(const std::string& name, const DType& dtype) const {
   return DynObjectSchema::ExistField(name, dtype);
 }
@@ -120,11 +174,11 @@ absl::Status TableSchema::AddColumns(const TableColumnOptions& opts, const ::goo
         break;
       }
       case ::google::protobuf::FieldDescriptor::TYPE_DOUBLE: {
-        status = AddColumn<double>(column_name, schema.get(), i);
+        status = AddFloatColumn<double>(opts, field_desc->name(), column_name, schema.get(), i);
         break;
       }
       case ::google::protobuf::FieldDescriptor::TYPE_FLOAT: {
-        status = AddColumn<float>(column_name, schema.get(), i);
+        status = AddFloatColumn<float>(opts, field_desc->name(), column_name, schema.get(), i);
         break;
       }
       case ::google::protobuf::FieldDescriptor::TYPE_SINT64:
@@ -238,11 +292,11 @@ absl::Status TableSchema::AddColumns(const TableColumnOptions& opts, const flatb
         break;
       }
       case flatbuffers::ET_FLOAT: {
-        status = AddColumn<float>(column_name, schema.get(), i);
+        status = AddFloatColumn<float>(opts, name, column_name, schema.get(), i);
         break;
       }
       case flatbuffers::ET_DOUBLE: {
-        status = AddColumn<double>(column_name, schema.get(), i);
+        status = AddFloatColumn<double>(opts, name, column_name, schema.get(), i);
         break;
       }
       case flatbuffers::ET_STRING: {
@@ -348,11 +402,11 @@ absl::Status TableSchema::AddColumns(const TableColumnOptions& opts, const DType
         break;
       }
       case DATA_F32: {
-        status = AddColumn<float>(column_name, schema.get(), i);
+        status = AddFloatColumn<float>(opts, member->name, column_name, schema.get(), i);
         break;
       }
       case DATA_F64: {
-        status = AddColumn<double>(column_name, schema.get(), i);
+        status = AddFloatColumn<double>(opts, member->name, column_name, schema.get(), i);
         break;
       }
       case DATA_STRING:
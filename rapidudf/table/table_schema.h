@@ -30,6 +30,7 @@
 #include "rapidudf/table/table.h"
 #include "rapidudf/types/dyn_object.h"
 #include "rapidudf/types/dyn_object_schema.h"
+#include "rapidudf/types/float16.h"
 #include "rapidudf/types/string_view.h"
 #include "rapidudf/types/vector.h"
 
@@ -39,6 +40,9 @@ struct TableColumnOptions {
   std::unordered_set<std::string> include_fields;
   std::unordered_set<std::string> exclude_fields;
   std::string prefix;
+  // float/double fields stored as f16/bf16 columns, values are narrowed at load and widened to f32 in computation.
+  std::unordered_set<std::string> f16_fields;
+  std::unordered_set<std::string> bf16_fields;
   bool ignore_unsupported_fields = false;
   bool IsAllowed(const std::string& field) const;
 };
@@ -64,6 +68,29 @@ class TableSchema : public DynObjectSchema {
     }
   }
 
+  /**
+  ** Column computed by the vector expression `expr` over columns of arg `table`, e.g. `table.clicks / table.views`,
+  ** only columns added before could be referenced. It's evaluated at the first access like row columns and cached
+  ** until rows of the table change, or a column it depends on directly or indirectly is set or unloaded.
+  */
+  template <typename T>
+  absl::Status AddComputedColumn(const std::string& name, const std::string& expr) {
+    if constexpr (std::is_same_v<std::string, T> || std::is_same_v<std::string_view, T>) {
+      return AddComputedColumn<StringView>(name, expr);
+    } else if constexpr (std::is_same_v<bool, T>) {
+      return AddComputedColumn<Bit>(name, expr);
+    } else {
+      auto eval = [expr](Table* table) -> absl::StatusOr<VectorBuf> {
+        auto result = table->Map<T>(expr);
+        if (!result.ok()) {
+          return result.status();
+        }
+        return result.value().GetVectorBuf();
+      };
+      return AddComputedColumn(name, get_dtype<Vector<T>>(), expr, std::move(eval));
+    }
+  }
+
   bool ExistColumn(const std::string& name, const DType& dtype) const;
   bool ExistRow(const RowSchema& row) const;
 
@@ -89,12 +116,25 @@ class TableSchema : public DynObjectSchema {
     }
   }
 
+  template <typename T>
+  absl::Status AddFloatColumn(const TableColumnOptions& opts, const std::string& field, const std::string& name,
+                              const RowSchema* schema, uint32_t field_idx) {
+    if (opts.f16_fields.count(field) > 0) {
+      return AddColumn<Float16>(name, schema, field_idx);
+    } else if (opts.bf16_fields.count(field) > 0) {
+      return AddColumn<BFloat16>(name, schema, field_idx);
+    }
+    return AddColumn<T>(name, schema, field_idx);
+  }
+
   typename DynObject::SmartPtr NewObject() const { return nullptr; }
 
   absl::Status AddColumns(const TableColumnOptions& opts, const ::google::protobuf::Message* msg);
   absl::Status AddColumns(const TableColumnOptions& opts, const flatbuffers::TypeTable* type_table);
   absl::Status AddColumns(const TableColumnOptions& opts, const DType& dtype);
   absl::Status AddColumn(const std::string& name, const DType& dtype, const RowSchema* schema, uint32_t field_idx);
+  absl::Status AddComputedColumn(const std::string& name, const DType& dtype, const std::string& expr,
+                                 ComputedColumn::EvalFunc&& eval);
 
   std::vector<RowSchemaPtr> row_schemas_;
   std::vector<Column> columns_;
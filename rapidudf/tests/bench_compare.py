@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Compare two google benchmark json outputs and flag regressions.
+
+Usage:
+  bench_compare.py base.json new.json [--threshold 0.1] [--metric cpu_time] [--filter REGEX]
+
+Exits with 1 if any benchmark in both files got slower by more than the threshold.
+Runs with `--benchmark_repetitions` are compared by their median aggregate.
+"""
+
+import argparse
+import json
+import re
+import sys
+
+_UNIT_TO_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_results(path, metric):
+    with open(path) as f:
+        data = json.load(f)
+    benchmarks = data.get("benchmarks", [])
+    has_median = any(b.get("aggregate_name") == "median" for b in benchmarks)
+    results = {}
+    for b in benchmarks:
+        if b.get("error_occurred"):
+            continue
+        if has_median:
+            if b.get("aggregate_name") != "median":
+                continue
+            name = b.get("run_name", b["name"])
+        else:
+            if b.get("run_type", "iteration") != "iteration":
+                continue
+            name = b["name"]
+        results[name] = b[metric] * _UNIT_TO_NS[b.get("time_unit", "ns")]
+    return results
+
+
+def format_ns(v):
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if v >= scale:
+            return "%.2f%s" % (v / scale, unit)
+    return "%.1fns" % v
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("base")
+    parser.add_argument("new")
+    parser.add_argument("--threshold", type=float, default=0.1, help="relative slowdown to flag, default 0.1(10%%)")
+    parser.add_argument("--metric", choices=["cpu_time", "real_time"], default="cpu_time")
+    parser.add_argument("--filter", default=None, help="only compare benchmarks matching the regex")
+    args = parser.parse_args()
+
+    base = load_results(args.base, args.metric)
+    new = load_results(args.new, args.metric)
+    pattern = re.compile(args.filter) if args.filter else None
+
+    regressions = []
+    rows = []
+    for name in sorted(base.keys() & new.keys()):
+        if pattern is not None and not pattern.search(name):
+            continue
+        old_v, new_v = base[name], new[name]
+        change = (new_v - old_v) / old_v if old_v > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "REGRESSION"
+            regressions.append(name)
+        elif change < -args.threshold:
+            flag = "improved"
+        rows.append((name, format_ns(old_v), format_ns(new_v), "%+.1f%%" % (change * 100), flag))
+
+    if rows:
+        width = max(len(r[0]) for r in rows)
+        print("%-*s %12s %12s %9s" % (width, "Benchmark", "Base", "New", "Change"))
+        for r in rows:
+            print("%-*s %12s %12s %9s %s" % (width, r[0], r[1], r[2], r[3], r[4]))
+    for name in sorted(base.keys() - new.keys()):
+        print("missing in new: %s" % name)
+    for name in sorted(new.keys() - base.keys()):
+        print("new benchmark: %s" % name)
+
+    if regressions:
+        print("\n%d regression(s) beyond %.1f%%" % (len(regressions), args.threshold * 100))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,894 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+** Structured benchmark suite, results could be saved as json and compared by `bench_compare.py`:
+**   bench_suite --benchmark_out=base.json --benchmark_out_format=json
+**   bench_suite --benchmark_out=new.json --benchmark_out_format=json
+**   python3 rapidudf/tests/bench_compare.py base.json new.json --threshold 0.1
+*/
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "flatbuffers/flatbuffers.h"
+#include "fmt/format.h"
+#include "rapidudf/context/context.h"
+#include "rapidudf/functions/simd/bits.h"
+#include "rapidudf/functions/simd/vector_sort.h"
+#include "rapidudf/metrics/metrics.h"
+#include "rapidudf/rapidudf.h"
+#include "rapidudf/tests/test_fbs_generated.h"
+#include "rapidudf/tests/test_pb.pb.h"
+#include "rapidudf/types/string_view.h"
+#include "x86simdsort.h"
+
+using namespace rapidudf;
+
+static constexpr int64_t kMinVectorLen = 64;
+static constexpr int64_t kMaxVectorLen = 1 << 20;
+
+template <typename T>
+static std::vector<T> random_values(size_t n, uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::vector<T> vals(n);
+  for (auto& v : vals) {
+    if constexpr (std::is_floating_point_v<T>) {
+      v = std::uniform_real_distribution<T>(1, 100)(gen);
+    } else {
+      // no zero to make division valid
+      v = static_cast<T>(std::uniform_int_distribution<int32_t>(1, 100)(gen));
+    }
+  }
+  return vals;
+}
+
+static void add_stat_counters(benchmark::State& state, const compiler::JitFunctionStat& stat, int64_t n) {
+  auto avg = [&](std::chrono::microseconds cost) {
+    return benchmark::Counter(static_cast<double>(cost.count()) / n);
+  };
+  state.counters["parse_us"] = avg(stat.parse_cost);
+  state.counters["validate_us"] = avg(stat.parse_validate_cost);
+  state.counters["ir_us"] = avg(stat.ir_build_cost);
+  state.counters["opt_us"] = avg(stat.optimize_cost);
+  state.counters["codegen_us"] = avg(stat.compile_cost + stat.codegen_cost);
+}
+
+/**
+** compile latency
+*/
+static const char* kScalarSource = R"(
+    double test_func(double x, double y, double pi){
+      return x + (cos(y - sin(2 / x * pi)) - sin(x - cos(2 * y / pi))) - y;
+    }
+  )";
+static const char* kVectorSource = R"(
+    simd_vector<f32> wilson_ctr(Context ctx, simd_vector<f32> exp_cnt, simd_vector<f32> clk_cnt)
+    {
+       return log10(exp_cnt) *
+         (clk_cnt / exp_cnt +  1.96 * 1.96 / (2 * exp_cnt) -
+          1.96 / (2 * exp_cnt) * sqrt(4 * exp_cnt * (1 - clk_cnt / exp_cnt) * clk_cnt / exp_cnt + 1.96 * 1.96)) /
+         (1 + 1.96 * 1.96 / exp_cnt);
+    }
+  )";
+
+template <typename RET, typename... Args>
+static void BM_compile(benchmark::State& state, const char* source) {
+  compiler::JitFunctionStat total;
+  total.Clear();
+  int64_t n = 0;
+  for (auto _ : state) {
+    JitCompiler compiler;
+    auto rc = compiler.CompileFunction<RET, Args...>(source);
+    if (!rc.ok()) {
+      state.SkipWithError(rc.status().ToString().c_str());
+      return;
+    }
+    const auto& stat = rc.value().Stats();
+    total.parse_cost += stat.parse_cost;
+    total.parse_validate_cost += stat.parse_validate_cost;
+    total.ir_build_cost += stat.ir_build_cost;
+    total.optimize_cost += stat.optimize_cost;
+    total.compile_cost += stat.compile_cost;
+    total.codegen_cost += stat.codegen_cost;
+    n++;
+  }
+  add_stat_counters(state, total, n);
+}
+BENCHMARK_CAPTURE((BM_compile<double, double, double, double>), scalar, kScalarSource)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE((BM_compile<Vector<float>, Context&, Vector<float>, Vector<float>>), vector, kVectorSource)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+** N threads compiling distinct sources, by a new compiler per compile or a shared compiler pool.
+** A new compiler creates its LLJIT & target machine per compile, pooled compilers reuse theirs.
+*/
+static constexpr std::string_view kMTSourceFormat = R"(
+    double test_func_{}_{}(double x, double y){{
+      return x + (cos(y - sin({} / x)) - sin(x - cos({} * y))) - y;
+    }}
+  )";
+static void BM_compile_mt(benchmark::State& state, bool use_pool) {
+  static JitCompilerPool pool;
+  int tid = state.thread_index();
+  int64_t seq = 0;
+  for (auto _ : state) {
+    std::string source = fmt::format(kMTSourceFormat, tid, seq, tid + 2, seq);
+    seq++;
+    absl::StatusOr<JitFunction<double, double, double>> rc;
+    if (use_pool) {
+      rc = pool.CompileFunction<double, double, double>(source);
+    } else {
+      JitCompiler compiler;
+      rc = compiler.CompileFunction<double, double, double>(source);
+    }
+    if (!rc.ok()) {
+      state.SkipWithError(rc.status().ToString().c_str());
+      return;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_compile_mt, new_compiler, false)->ThreadRange(1, 16)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_compile_mt, pool, true)->ThreadRange(1, 16)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+/**
+** scalar call overhead
+*/
+static int64_t __attribute__((noinline)) native_add(int64_t x) { return x + 1; }
+
+static void BM_scalar_call_native(benchmark::State& state) {
+  int64_t v = 0;
+  for (auto _ : state) {
+    v = native_add(v);
+    benchmark::DoNotOptimize(v);
+  }
+}
+BENCHMARK(BM_scalar_call_native);
+
+static void BM_scalar_call_jit(benchmark::State& state) {
+  JitCompiler compiler;
+  auto rc = compiler.CompileExpression<int64_t, int64_t>("x + 1", {"x"});
+  if (!rc.ok()) {
+    state.SkipWithError(rc.status().ToString().c_str());
+    return;
+  }
+  auto f = std::move(rc.value());
+  int64_t v = 0;
+  for (auto _ : state) {
+    v = f(v);
+    benchmark::DoNotOptimize(v);
+  }
+}
+BENCHMARK(BM_scalar_call_jit);
+
+static void BM_scalar_call_jit_no_throw(benchmark::State& state) {
+  JitCompiler compiler;
+  auto rc = compiler.CompileExpression<int64_t, int64_t>("x + 1", {"x"});
+  if (!rc.ok()) {
+    state.SkipWithError(rc.status().ToString().c_str());
+    return;
+  }
+  auto f = std::move(rc.value());
+  int64_t v = 0;
+  for (auto _ : state) {
+    v = f.Call(v).value();
+    benchmark::DoNotOptimize(v);
+  }
+}
+BENCHMARK(BM_scalar_call_jit_no_throw);
+
+/**
+** eval cache hit path, the first call compiles and fills the cache.
+*/
+static void BM_eval_cache_hit(benchmark::State& state) {
+  std::string source = "x * y + 1";
+  std::vector<std::string> args{"x", "y"};
+  double x = 1.5;
+  double y = 2.5;
+  auto first = exec::eval_expression<double, double, double>(source, args, x, y);
+  if (!first.ok()) {
+    state.SkipWithError(first.status().ToString().c_str());
+    return;
+  }
+  for (auto _ : state) {
+    auto result = exec::eval_expression<double, double, double>(source, args, x, y);
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_eval_cache_hit);
+
+/**
+** vector op x dtype x length, functions are compiled at the first run of every case.
+*/
+template <typename R, typename T>
+struct VectorOpCase {
+  using FuncType = JitFunction<R, Context&, Vector<T>, Vector<T>>;
+  std::string expr;
+  compiler::Options opts;
+  std::once_flag once;
+  std::unique_ptr<FuncType> func;
+  std::string err;
+
+  FuncType* Get() {
+    std::call_once(once, [this]() {
+      JitCompiler compiler(opts);
+      auto rc = compiler.CompileExpression<R, Context&, Vector<T>, Vector<T>>(expr, {"_", "x", "y"});
+      if (rc.ok()) {
+        func = std::make_unique<FuncType>(std::move(rc.value()));
+      } else {
+        err = rc.status().ToString();
+      }
+    });
+    return func.get();
+  }
+};
+
+template <typename R, typename T>
+static benchmark::internal::Benchmark* register_vector_op(const std::string& name, const std::string& expr,
+                                                          const compiler::Options& opts) {
+  auto op_case = std::make_shared<VectorOpCase<R, T>>();
+  op_case->expr = expr;
+  op_case->opts = opts;
+  return benchmark::RegisterBenchmark(name.c_str(),
+                               [op_case](benchmark::State& state) {
+                                 auto* f = op_case->Get();
+                                 if (f == nullptr) {
+                                   state.SkipWithError(op_case->err.c_str());
+                                   return;
+                                 }
+                                 size_t n = static_cast<size_t>(state.range(0));
+                                 auto xs = random_values<T>(n, 1);
+                                 auto ys = random_values<T>(n, 2);
+                                 Context ctx;
+                                 for (auto _ : state) {
+                                   ctx.Reset();
+                                   auto result = (*f)(ctx, xs, ys);
+                                   benchmark::DoNotOptimize(result);
+                                 }
+                                 state.SetItemsProcessed(state.iterations() * n);
+                               });
+}
+
+template <typename R, typename T>
+static void register_vector_op(const std::string& op, const std::string& dtype, const std::string& expr) {
+  register_vector_op<R, T>("BM_vector/" + op + "/" + dtype, expr, compiler::Options{})
+      ->RangeMultiplier(16)
+      ->Range(kMinVectorLen, kMaxVectorLen);
+}
+
+template <typename T>
+static void register_vector_ops(const std::string& dtype) {
+  register_vector_op<Vector<T>, T>("add", dtype, "x + y");
+  register_vector_op<Vector<T>, T>("sub", dtype, "x - y");
+  register_vector_op<Vector<T>, T>("mul", dtype, "x * y");
+  register_vector_op<Vector<T>, T>("div", dtype, "x / y");
+  register_vector_op<Vector<T>, T>("max", dtype, "max(x, y)");
+  register_vector_op<Vector<T>, T>("ternary", dtype, "x > y ? x : y");
+  register_vector_op<Vector<Bit>, T>("cmp_gt", dtype, "x > y");
+  register_vector_op<Vector<Bit>, T>("cmp_eq", dtype, "x == y");
+  register_vector_op<Vector<Bit>, T>("logic_and", dtype, "x > 10 && y < 50");
+  if constexpr (std::is_integral_v<T>) {
+    register_vector_op<Vector<uint64_t>, T>("hash", dtype, "hash(x)");
+  }
+  if constexpr (std::is_floating_point_v<T>) {
+    register_vector_op<Vector<T>, T>("sqrt", dtype, "sqrt(x)");
+    register_vector_op<Vector<T>, T>("exp", dtype, "exp(x / 100)");
+    register_vector_op<Vector<T>, T>("log", dtype, "log(x)");
+    register_vector_op<Vector<T>, T>("sin", dtype, "sin(x)");
+    register_vector_op<Vector<T>, T>("pow", dtype, "x ^ 1.5");
+    register_vector_op<Vector<T>, T>("fma", dtype, "x * y + x");
+    register_vector_op<T, T>("dot", dtype, "dot(x, y)");
+  }
+}
+
+/**
+** Per vector block cost of calling simd kernels directly bound to the chosen target vs dispatching through
+** highway's target table, which matters most on short vectors.
+*/
+static void register_simd_dispatch_ops() {
+  std::vector<std::pair<std::string, std::string>> ops = {
+      {"add", "x + y"}, {"sin", "sin(x)"}, {"hypot", "hypot(x, y)"}, {"fma", "x * y + x"}, {"clamp", "clamp(x, y, 50)"},
+  };
+  for (bool direct : {true, false}) {
+    compiler::Options opts;
+    opts.direct_simd_dispatch = direct;
+    for (const auto& [op, expr] : ops) {
+      std::string name = "BM_simd_dispatch/" + op + "/" + (direct ? "direct" : "table");
+      register_vector_op<Vector<float>, float>(name, expr, opts)->RangeMultiplier(4)->Range(kMinVectorLen, 4096);
+    }
+  }
+}
+
+/**
+** f32 argsort by x86-simd-sort key-value sort & `simd_vector_argsort_u32`, which radix sorts large inputs.
+*/
+static void BM_argsort_x86simdsort(benchmark::State& state) {
+  size_t n = static_cast<size_t>(state.range(0));
+  std::vector<float> data = random_values<float>(n, 7);
+  std::vector<float> keys(n);
+  std::vector<uint32_t> indices(n);
+  for (auto _ : state) {
+    keys = data;
+    std::iota(indices.begin(), indices.end(), 0);
+    x86simdsort::keyvalue_qsort(keys.data(), indices.data(), n);
+    benchmark::DoNotOptimize(indices.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_argsort_x86simdsort)->RangeMultiplier(10)->Range(1000, 1000000);
+
+static void BM_argsort_u32(benchmark::State& state) {
+  size_t n = static_cast<size_t>(state.range(0));
+  std::vector<float> data = random_values<float>(n, 7);
+  Context ctx;
+  for (auto _ : state) {
+    auto indices = functions::simd_vector_argsort_u32<float>(ctx, Vector<float>(data.data(), n), false);
+    benchmark::DoNotOptimize(indices.Data());
+    ctx.Reset();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_argsort_u32)->RangeMultiplier(10)->Range(1000, 1000000);
+
+/**
+** table pipelines over pb/fbs/struct rows
+*/
+struct BenchRow {
+  int id;
+  std::string str;
+};
+RUDF_STRUCT_FIELDS(BenchRow, id, str)
+
+static constexpr int kTableIdRange = 1000;
+static constexpr uint32_t kTableTopk = 100;
+
+template <typename T>
+struct BenchRows {
+  std::vector<const T*> rows;
+  std::vector<T> objs;
+  std::vector<std::unique_ptr<flatbuffers::FlatBufferBuilder>> fbs_buffers;
+};
+
+static std::string bench_row_str(int id) { return "city_" + std::to_string(id % 50); }
+
+static std::shared_ptr<BenchRows<BenchRow>> make_struct_rows(size_t n) {
+  auto rows = std::make_shared<BenchRows<BenchRow>>();
+  std::mt19937 gen(1);
+  for (size_t i = 0; i < n; i++) {
+    int id = std::uniform_int_distribution<int>(0, kTableIdRange - 1)(gen);
+    rows->objs.emplace_back(BenchRow{id, bench_row_str(id)});
+  }
+  for (auto& obj : rows->objs) {
+    rows->rows.emplace_back(&obj);
+  }
+  return rows;
+}
+
+static std::shared_ptr<BenchRows<test::PBStruct>> make_pb_rows(size_t n) {
+  auto rows = std::make_shared<BenchRows<test::PBStruct>>();
+  std::mt19937 gen(1);
+  rows->objs.resize(n);
+  for (size_t i = 0; i < n; i++) {
+    int id = std::uniform_int_distribution<int>(0, kTableIdRange - 1)(gen);
+    rows->objs[i].set_id(id);
+    rows->objs[i].set_str(bench_row_str(id));
+    rows->rows.emplace_back(&rows->objs[i]);
+  }
+  return rows;
+}
+
+static std::shared_ptr<BenchRows<test_fbs::FBSStruct>> make_fbs_rows(size_t n) {
+  auto rows = std::make_shared<BenchRows<test_fbs::FBSStruct>>();
+  std::mt19937 gen(1);
+  for (size_t i = 0; i < n; i++) {
+    int id = std::uniform_int_distribution<int>(0, kTableIdRange - 1)(gen);
+    test_fbs::FBSStructT obj;
+    obj.id = static_cast<uint32_t>(id);
+    obj.str = bench_row_str(id);
+    auto builder = std::make_unique<flatbuffers::FlatBufferBuilder>();
+    builder->Finish(test_fbs::FBSStruct::Pack(*builder, &obj));
+    rows->rows.emplace_back(test_fbs::GetFBSStruct(builder->GetBufferPointer()));
+    rows->fbs_buffers.emplace_back(std::move(builder));
+  }
+  return rows;
+}
+
+enum TablePipeline {
+  kTableLoad,
+  kTableFilter,
+  kTableOrderBy,
+  kTableTopk,
+  kTableGroupBy,
+  kTableDedup,
+};
+static const char* kTablePipelineNames[] = {"load", "filter", "order_by", "topk", "group_by", "dedup"};
+
+template <typename T, typename ID>
+static void register_table_pipeline(const std::string& schema_name, TablePipeline pipeline,
+                                    std::shared_ptr<BenchRows<T>> (*make_rows)(size_t)) {
+  std::string name = "BM_table/" + std::string(kTablePipelineNames[pipeline]) + "/" + schema_name;
+  benchmark::RegisterBenchmark(
+      name.c_str(),
+      [schema_name, pipeline, make_rows](benchmark::State& state) {
+        const auto* schema = table::TableSchema::Get(schema_name);
+        size_t n = static_cast<size_t>(state.range(0));
+        auto rows = make_rows(n);
+        JitFunction<table::Table*, Context&, table::Table*> filter;
+        if (pipeline == kTableFilter) {
+          std::string source = fmt::format(R"(
+            table<{}> filter_rows(Context ctx, table<{}> x) {{
+              return x.filter(x.id < {});
+            }}
+          )",
+                                           schema_name, schema_name, kTableIdRange / 2);
+          JitCompiler compiler;
+          auto rc = compiler.CompileFunction<table::Table*, Context&, table::Table*>(source);
+          if (!rc.ok()) {
+            state.SkipWithError(rc.status().ToString().c_str());
+            return;
+          }
+          filter = std::move(rc.value());
+        }
+        Context ctx;
+        for (auto _ : state) {
+          ctx.Reset();
+          auto table = schema->NewTable(ctx);
+          auto status = table->AddRows(rows->rows);
+          if (!status.ok()) {
+            state.SkipWithError(status.ToString().c_str());
+            return;
+          }
+          switch (pipeline) {
+            case kTableLoad: {
+              benchmark::DoNotOptimize(table->template Get<ID>("id"));
+              benchmark::DoNotOptimize(table->template Get<StringView>("str"));
+              break;
+            }
+            case kTableFilter: {
+              benchmark::DoNotOptimize(filter(ctx, table.get()));
+              break;
+            }
+            case kTableOrderBy: {
+              benchmark::DoNotOptimize(table->OrderBy("id", true));
+              break;
+            }
+            case kTableTopk: {
+              auto by = table->template Get<ID>("id").value();
+              benchmark::DoNotOptimize(table->Topk(by, kTableTopk, true));
+              break;
+            }
+            case kTableGroupBy: {
+              benchmark::DoNotOptimize(table->GroupBy("str"));
+              break;
+            }
+            case kTableDedup: {
+              benchmark::DoNotOptimize(table->Filter(table->Dedup("str", 2)));
+              break;
+            }
+          }
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+      })
+      ->RangeMultiplier(10)
+      ->Range(1000, 100000)
+      ->Unit(benchmark::kMicrosecond);
+}
+
+static void register_table_pipelines() {
+  table::TableColumnOptions opts;
+  opts.include_fields = {"id", "str"};
+  table::TableSchema::GetOrCreate("bench_struct_rows",
+                                  [&](table::TableSchema* s) { std::ignore = s->AddColumns<BenchRow>(opts); });
+  table::TableSchema::GetOrCreate("bench_pb_rows",
+                                  [&](table::TableSchema* s) { std::ignore = s->AddColumns<test::PBStruct>(opts); });
+  table::TableSchema::GetOrCreate(
+      "bench_fbs_rows", [&](table::TableSchema* s) { std::ignore = s->AddColumns<test_fbs::FBSStruct>(opts); });
+  for (int i = kTableLoad; i <= kTableDedup; i++) {
+    auto pipeline = static_cast<TablePipeline>(i);
+    register_table_pipeline<BenchRow, int32_t>("bench_struct_rows", pipeline, make_struct_rows);
+    register_table_pipeline<test::PBStruct, int32_t>("bench_pb_rows", pipeline, make_pb_rows);
+    register_table_pipeline<test_fbs::FBSStruct, uint32_t>("bench_fbs_rows", pipeline, make_fbs_rows);
+  }
+}
+
+/**
+** Split/partition of tables with 5 loaded columns, `filter` is the former split by two filters which drop all
+** loaded columns, every output column is read once after splitting.
+*/
+struct BenchWideRow {
+  int id;
+  float score;
+  double weight;
+  int64_t ts;
+  std::string str;
+};
+RUDF_STRUCT_FIELDS(BenchWideRow, id, score, weight, ts, str)
+
+/**
+** Shared fixture of the wide row benches, ids are `j % kTableIdRange` or uniformly random if `random_ids`.
+*/
+static std::vector<BenchWideRow> make_wide_rows(size_t n, bool random_ids = false) {
+  std::mt19937 gen(1);
+  std::vector<BenchWideRow> objs;
+  objs.reserve(n);
+  for (size_t j = 0; j < n; j++) {
+    int id = random_ids ? std::uniform_int_distribution<int>(0, kTableIdRange - 1)(gen)
+                        : static_cast<int>(j % kTableIdRange);
+    objs.emplace_back(BenchWideRow{id, id * 0.5f, id * 0.25, static_cast<int64_t>(j), bench_row_str(id)});
+  }
+  return objs;
+}
+
+static const table::TableSchema* wide_rows_schema() {
+  return table::TableSchema::GetOrCreate("bench_wide_rows",
+                                         [](table::TableSchema* s) { std::ignore = s->AddColumns<BenchWideRow>(); });
+}
+
+enum TableSplitMode {
+  kSplitByFilter,
+  kSplitByPartition,
+  kPartition4,
+};
+static const char* kTableSplitModeNames[] = {"filter", "split", "partition4"};
+
+static void read_wide_columns(table::Table* table) {
+  benchmark::DoNotOptimize(table->Get<int>("id"));
+  benchmark::DoNotOptimize(table->Get<float>("score"));
+  benchmark::DoNotOptimize(table->Get<double>("weight"));
+  benchmark::DoNotOptimize(table->Get<int64_t>("ts"));
+  benchmark::DoNotOptimize(table->Get<StringView>("str"));
+}
+
+static void register_table_splits() {
+  for (int i = kSplitByFilter; i <= kPartition4; i++) {
+    auto mode = static_cast<TableSplitMode>(i);
+    std::string name = "BM_table_split/" + std::string(kTableSplitModeNames[mode]);
+    benchmark::RegisterBenchmark(
+        name.c_str(),
+        [mode](benchmark::State& state) {
+          const auto* schema = wide_rows_schema();
+          size_t n = static_cast<size_t>(state.range(0));
+          auto objs = make_wide_rows(n, true);
+          std::vector<const BenchWideRow*> rows;
+          for (auto& obj : objs) {
+            rows.emplace_back(&obj);
+          }
+          Context ctx;
+          for (auto _ : state) {
+            state.PauseTiming();
+            ctx.Reset();
+            auto table = schema->NewTable(ctx);
+            std::ignore = table->AddRows(rows);
+            read_wide_columns(table.get());
+            auto ids = table->Get<int>("id").value();
+            Vector<Bit> bits(ctx.NewVectorBuf<Bit>(n));
+            VectorBuf buckets = ctx.NewVectorBuf<uint32_t>(n);
+            for (size_t j = 0; j < n; j++) {
+              bits.Set(j, Bit(ids[j] < kTableIdRange / 2));
+              buckets.MutableData<uint32_t>()[j] = static_cast<uint32_t>(ids[j] % 4);
+            }
+            state.ResumeTiming();
+            switch (mode) {
+              case kSplitByFilter: {
+                Vector<Bit> other = ctx.NewVectorBuf<Bit>(n);
+                functions::simd_vector_bits_not(bits, other);
+                read_wide_columns(table->Filter(bits));
+                read_wide_columns(table->Filter(other));
+                break;
+              }
+              case kSplitByPartition: {
+                auto [first, second] = table->Split(bits);
+                read_wide_columns(first);
+                read_wide_columns(second);
+                break;
+              }
+              case kPartition4: {
+                for (auto* part : table->Partition(Vector<uint32_t>(buckets), 4)) {
+                  read_wide_columns(part);
+                }
+                break;
+              }
+            }
+          }
+          state.SetItemsProcessed(state.iterations() * n);
+        })
+        ->Arg(10000)
+        ->Arg(30000)
+        ->Arg(100000)
+        ->Unit(benchmark::kMicrosecond);
+  }
+}
+
+/**
+** Building a table of wide rows with the `id` column loaded, loaded columns are extended by new rows only.
+*/
+enum TableBuildMode {
+  kBuildRowByRow,
+  kBuildReservedRowByRow,
+  kBuildBatches,
+  kBuildInsertRows,
+};
+static const char* kTableBuildModeNames[] = {"row_by_row", "reserved_row_by_row", "batches", "insert_rows"};
+static constexpr size_t kTableBuildBatch = 1000;
+
+static void register_table_builds() {
+  for (int i = kBuildRowByRow; i <= kBuildInsertRows; i++) {
+    auto mode = static_cast<TableBuildMode>(i);
+    std::string name = "BM_table_build/" + std::string(kTableBuildModeNames[mode]);
+    benchmark::RegisterBenchmark(
+        name.c_str(),
+        [mode](benchmark::State& state) {
+          const auto* schema = wide_rows_schema();
+          size_t n = static_cast<size_t>(state.range(0));
+          auto objs = make_wide_rows(n);
+          std::vector<BenchWideRow> evens, odds;
+          std::vector<size_t> odd_positions;
+          for (size_t j = 0; j < n; j++) {
+            if (j % 2 == 0) {
+              evens.emplace_back(objs[j]);
+            } else {
+              odds.emplace_back(objs[j]);
+              odd_positions.emplace_back(j / 2 + 1);
+            }
+          }
+          Context ctx;
+          for (auto _ : state) {
+            ctx.Reset();
+            auto table = schema->NewTable(ctx);
+            switch (mode) {
+              case kBuildRowByRow:
+              case kBuildReservedRowByRow: {
+                if (mode == kBuildReservedRowByRow) {
+                  table->Reserve(n);
+                }
+                std::ignore = table->AppendRow(&objs[0]);
+                std::ignore = table->Get<int>("id");
+                for (size_t j = 1; j < n; j++) {
+                  std::ignore = table->AppendRow(&objs[j]);
+                }
+                break;
+              }
+              case kBuildBatches: {
+                for (size_t j = 0; j < n; j += kTableBuildBatch) {
+                  std::vector<const BenchWideRow*> batch;
+                  for (size_t k = j; k < std::min(n, j + kTableBuildBatch); k++) {
+                    batch.emplace_back(&objs[k]);
+                  }
+                  std::ignore = table->AppendRows(batch);
+                  benchmark::DoNotOptimize(table->Get<int>("id"));
+                }
+                break;
+              }
+              case kBuildInsertRows: {
+                std::ignore = table->AppendRows(evens);
+                std::ignore = table->Get<int>("id");
+                std::ignore = table->InsertRows(odd_positions, odds);
+                break;
+              }
+            }
+            benchmark::DoNotOptimize(table->Get<int>("id"));
+          }
+          state.SetItemsProcessed(state.iterations() * n);
+        })
+        ->Arg(50000)
+        ->Unit(benchmark::kMicrosecond);
+  }
+}
+
+/**
+** Merging 20 recall sources with loaded columns, `chained` concats tables one by one.
+*/
+static constexpr size_t kConcatSources = 20;
+
+static void register_table_concats() {
+  for (bool chained : {true, false}) {
+    std::string name = std::string("BM_table_concat/") + (chained ? "chained" : "span");
+    benchmark::RegisterBenchmark(
+        name.c_str(),
+        [chained](benchmark::State& state) {
+          const auto* schema = wide_rows_schema();
+          size_t n = static_cast<size_t>(state.range(0));
+          auto objs = make_wide_rows(n * kConcatSources);
+          Context ctx;
+          for (auto _ : state) {
+            state.PauseTiming();
+            ctx.Reset();
+            std::vector<table::Table::SmartPtr> sources;
+            std::vector<table::Table*> others;
+            for (size_t k = 0; k < kConcatSources; k++) {
+              std::vector<const BenchWideRow*> rows;
+              for (size_t j = k * n; j < (k + 1) * n; j++) {
+                rows.emplace_back(&objs[j]);
+              }
+              auto table = schema->NewTable(ctx);
+              std::ignore = table->AddRows(rows);
+              read_wide_columns(table.get());
+              if (k > 0) {
+                others.emplace_back(table.get());
+              }
+              sources.emplace_back(std::move(table));
+            }
+            state.ResumeTiming();
+            table::Table* merged = sources[0].get();
+            if (chained) {
+              for (auto* other : others) {
+                merged = merged->Concat(other);
+              }
+            } else {
+              merged = merged->Concat(absl::MakeSpan(others));
+            }
+            read_wide_columns(merged);
+          }
+          state.SetItemsProcessed(state.iterations() * n * kConcatSources);
+        })
+        ->Arg(100)
+        ->Arg(1000)
+        ->Unit(benchmark::kMicrosecond);
+  }
+}
+
+/**
+** Row operators over wide rows by per row `std::function` calls vs cached jit vector expressions over columns,
+** column loading is included in the jit path.
+*/
+enum TableRowOp {
+  kRowOpFilter,
+  kRowOpMap,
+  kRowOpForeachMasked,
+};
+static const char* kTableRowOpNames[] = {"filter", "map", "foreach_masked"};
+
+static void register_table_row_ops() {
+  for (int i = kRowOpFilter; i <= kRowOpForeachMasked; i++) {
+    for (bool jit : {false, true}) {
+      auto op = static_cast<TableRowOp>(i);
+      std::string name = "BM_table_row_op/" + std::string(kTableRowOpNames[op]) + "/" + (jit ? "jit" : "function");
+      benchmark::RegisterBenchmark(
+          name.c_str(),
+          [op, jit](benchmark::State& state) {
+            const auto* schema = wide_rows_schema();
+            size_t n = static_cast<size_t>(state.range(0));
+            auto objs = make_wide_rows(n);
+            std::string filter_expr = fmt::format("table.id < {}", kTableIdRange / 10);
+            std::string map_expr = "table.weight * table.weight + table.weight";
+            Context ctx;
+            for (auto _ : state) {
+              state.PauseTiming();
+              ctx.Reset();
+              auto table = schema->NewTable(ctx);
+              std::ignore = table->AddRows(objs);
+              state.ResumeTiming();
+              switch (op) {
+                case kRowOpFilter: {
+                  if (jit) {
+                    benchmark::DoNotOptimize(table->Filter(filter_expr));
+                  } else {
+                    benchmark::DoNotOptimize(table->Filter<BenchWideRow>(
+                        [](size_t, const BenchWideRow* row) { return row->id < kTableIdRange / 10; }));
+                  }
+                  break;
+                }
+                case kRowOpMap: {
+                  if (jit) {
+                    benchmark::DoNotOptimize(table->Map<double>(map_expr));
+                  } else {
+                    VectorBuf out = ctx.NewVectorBuf<double>(n);
+                    double* data = out.MutableData<double>();
+                    std::ignore = table->Foreach<void, BenchWideRow>([&](size_t idx, const BenchWideRow* row) {
+                      data[idx] = row->weight * row->weight + row->weight;
+                    });
+                    benchmark::DoNotOptimize(data);
+                  }
+                  break;
+                }
+                case kRowOpForeachMasked: {
+                  // 10% rows selected
+                  Vector<Bit> mask;
+                  if (jit) {
+                    mask = table->Filter(filter_expr).value();
+                  } else {
+                    mask = table->Filter<BenchWideRow>(
+                        [](size_t, const BenchWideRow* row) { return row->id < kTableIdRange / 10; });
+                  }
+                  int64_t sum = 0;
+                  std::ignore = table->Foreach<void, BenchWideRow>(
+                      [&](size_t, const BenchWideRow* row) { sum += row->ts; }, &mask);
+                  benchmark::DoNotOptimize(sum);
+                  break;
+                }
+              }
+            }
+            state.SetItemsProcessed(state.iterations() * n);
+          })
+          ->Arg(10000)
+          ->Arg(100000)
+          ->Unit(benchmark::kMicrosecond);
+    }
+  }
+}
+
+/**
+** Small table pipelines with builtin metrics on(default registry) vs off, metrics are recorded per table op and
+** context reset so small tables show the overhead most.
+*/
+static void register_table_metrics() {
+  for (bool enabled : {false, true}) {
+    std::string name = std::string("BM_table_metrics/") + (enabled ? "on" : "off");
+    benchmark::RegisterBenchmark(
+        name.c_str(),
+        [enabled](benchmark::State& state) {
+          const auto* schema = wide_rows_schema();
+          size_t n = static_cast<size_t>(state.range(0));
+          auto objs = make_wide_rows(n, true);
+          if (enabled) {
+            metrics::set_metrics_registry(metrics::get_default_metrics_registry());
+          } else {
+            metrics::set_metrics_registry(nullptr);
+          }
+          Context ctx;
+          for (auto _ : state) {
+            ctx.Reset();
+            auto table = schema->NewTable(ctx);
+            std::ignore = table->AddRows(objs);
+            auto ids = table->Get<int>("id").value();
+            Vector<Bit> bits(ctx.NewVectorBuf<Bit>(n));
+            for (size_t j = 0; j < n; j++) {
+              bits.Set(j, Bit(ids[j] < kTableIdRange / 2));
+            }
+            auto* filtered = table->Filter(bits);
+            benchmark::DoNotOptimize(filtered->OrderBy("score", true));
+          }
+          metrics::set_metrics_registry(metrics::get_default_metrics_registry());
+          state.SetItemsProcessed(state.iterations() * n);
+        })
+        ->Arg(100)
+        ->Arg(1000)
+        ->Arg(10000)
+        ->Unit(benchmark::kMicrosecond);
+  }
+}
+
+int main(int argc, char** argv) {
+  register_vector_ops<float>("f32");
+  register_vector_ops<double>("f64");
+  register_vector_ops<int32_t>("i32");
+  register_vector_ops<int64_t>("i64");
+  register_simd_dispatch_ops();
+  register_table_pipelines();
+  register_table_splits();
+  register_table_builds();
+  register_table_concats();
+  register_table_row_ops();
+  register_table_metrics();
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
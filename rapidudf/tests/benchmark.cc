@@ -265,4 +265,69 @@ static void BM_native_order_rule(benchmark::State& state) {
 BENCHMARK(BM_rapidudf_order_rule)->Setup(rapidudf_order_rule_setup);
 BENCHMARK(BM_native_order_rule);
 
+static int bench_check_input(int x) {
+  if (x < 0) {
+    RAISE_LOGIC_ERR(0, "negative input:{}", x);
+  }
+  return x * 2;
+}
+RUDF_FUNC_REGISTER(bench_check_input)
+
+static rapidudf::JitFunction<int, int> g_throw_func;
+static rapidudf::JitFunction<int, int> g_no_throw_func;
+static std::vector<int> g_failure_inputs;
+
+static void rapidudf_failure_rate_setup(const benchmark::State& state) {
+  std::string source = R"(
+    int test_func(int x){
+      return bench_check_input(x) + 1;
+    }
+  )";
+  rapidudf::JitCompiler compiler;
+  g_throw_func = std::move(compiler.CompileFunction<int, int>(source).value());
+  rapidudf::JitCompiler no_throw_compiler({.no_throw = true});
+  g_no_throw_func = std::move(no_throw_compiler.CompileFunction<int, int>(source).value());
+  // state.range(0) is the failure rate in per mille
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> dist(0, 999);
+  g_failure_inputs.clear();
+  for (size_t i = 0; i < test_n; i++) {
+    g_failure_inputs.emplace_back(dist(rng) < state.range(0) ? -1 : static_cast<int>(i));
+  }
+}
+
+static void BM_rapidudf_failure_rate_throw(benchmark::State& state) {
+  int64_t results = 0;
+  size_t failed = 0;
+  for (auto _ : state) {
+    for (int x : g_failure_inputs) {
+      try {
+        results += g_throw_func(x);
+      } catch (...) {
+        failed++;
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * g_failure_inputs.size());
+  RUDF_DEBUG("RapidUDF result:{}, failed:{}", results, failed);
+}
+static void BM_rapidudf_failure_rate_no_throw(benchmark::State& state) {
+  int64_t results = 0;
+  size_t failed = 0;
+  for (auto _ : state) {
+    for (int x : g_failure_inputs) {
+      auto result = g_no_throw_func.Call(x);
+      if (result.ok()) {
+        results += result.value();
+      } else {
+        failed++;
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * g_failure_inputs.size());
+  RUDF_DEBUG("RapidUDF result:{}, failed:{}", results, failed);
+}
+BENCHMARK(BM_rapidudf_failure_rate_throw)->Setup(rapidudf_failure_rate_setup)->Arg(0)->Arg(10)->Arg(100)->Arg(500);
+BENCHMARK(BM_rapidudf_failure_rate_no_throw)->Setup(rapidudf_failure_rate_setup)->Arg(0)->Arg(10)->Arg(100)->Arg(500);
+
 BENCHMARK_MAIN();
@@ -15,6 +15,10 @@
  */
 #include "rapidudf/exec/eval_engine.h"
 #include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
 #include "absl/strings/str_join.h"
 #include "rapidudf/rapidudf.h"
 
@@ -63,4 +67,62 @@ TEST(JitCompiler, expr_cache) {
 
   ASSERT_TRUE(rc.ok());
   ASSERT_TRUE(rc.value());
-}
\ No newline at end of file
+}
+TEST(JitCompiler, compiler_pool) {
+  JitCompilerPool pool(Options{}, 2, 4);
+  ASSERT_EQ(pool.IdleSize(), 2);
+  std::vector<std::thread> threads;
+  std::atomic<int> failed{0};
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([&pool, &failed, i]() {
+      for (int j = 0; j < 4; j++) {
+        std::string expr = fmt::format("x * {} + {}", i, j);
+        auto rc = pool.CompileExpression<int, int>(expr, {"x"});
+        if (!rc.ok() || rc.value()(3) != 3 * i + j) {
+          failed++;
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  ASSERT_EQ(failed.load(), 0);
+  ASSERT_GE(pool.IdleSize(), 1);
+  ASSERT_LE(pool.IdleSize(), 4);
+
+  {
+    auto compiler = pool.Acquire();
+    auto rc = compiler->CompileExpression<int, int>("x+", {"x"});
+    ASSERT_FALSE(rc.ok());
+  }
+  // compiler is reusable after failed compile
+  auto rc = pool.CompileExpression<int, int>("x + 1", {"x"});
+  ASSERT_TRUE(rc.ok());
+  ASSERT_EQ(rc.value()(1), 2);
+
+  auto f = compiler::get_global_compiler_pool().CompileFunction<int, int>("int test_func(int x){ return x * 2; }");
+  ASSERT_TRUE(f.ok());
+  ASSERT_EQ(f.value()(21), 42);
+}
+
+TEST(JitCompiler, compiler_reuse_jit) {
+  // compiles of one compiler share the jit, same function names of different compiles do not conflict
+  JitCompiler compiler;
+  auto f1 = compiler.CompileFunction<int, int>("int test_func(int x){ return x * 2; }");
+  ASSERT_TRUE(f1.ok());
+  compiler.Reset();
+  auto f2 = compiler.CompileFunction<int, int>("int test_func(int x){ return x * 3; }");
+  ASSERT_TRUE(f2.ok());
+  ASSERT_EQ(f1.value()(2), 4);
+  ASSERT_EQ(f2.value()(2), 6);
+  {
+    auto f3 = compiler.CompileFunction<int, int>("int test_func(int x){ return x * 4; }");
+    ASSERT_TRUE(f3.ok());
+    ASSERT_EQ(f3.value()(2), 8);
+  }
+  compiler.Reset();
+  // code of other sessions is still valid after one is freed
+  ASSERT_EQ(f1.value()(3), 6);
+  ASSERT_EQ(f2.value()(3), 9);
+}
@@ -118,4 +118,87 @@ TEST(JitCompiler, member_func_bind) {
   TestStruct t;
   auto f = std::move(rc.value());
   ASSERT_ANY_THROW(f(&t));
-}
\ No newline at end of file
+}
+static int g_no_throw_calls = 0;
+static int test_check_positive(int x) {
+  if (x < 0) {
+    RAISE_LOGIC_ERR(0, "negative input:{}", x);
+  }
+  return x;
+}
+static int test_count_call(int x) {
+  g_no_throw_calls++;
+  return x + 1;
+}
+RUDF_FUNC_REGISTER(test_check_positive)
+RUDF_FUNC_REGISTER(test_count_call)
+
+TEST(JitCompiler, no_throw) {
+  JitCompiler compiler({.no_throw = true});
+  std::string content = R"(
+    int test_func(int x){
+      return test_count_call(test_check_positive(x));
+    }
+   )";
+  auto rc = compiler.CompileFunction<int, int>(content);
+  ASSERT_TRUE(rc.ok());
+  auto f = std::move(rc.value());
+  auto result = f.Call(1);
+  ASSERT_TRUE(result.ok());
+  ASSERT_EQ(result.value(), 2);
+  ASSERT_EQ(g_no_throw_calls, 1);
+
+  result = f.Call(-1);
+  ASSERT_FALSE(result.ok());
+  ASSERT_TRUE(absl::IsInvalidArgument(result.status()));
+  // returned at the first error
+  ASSERT_EQ(g_no_throw_calls, 1);
+  ASSERT_EQ(GetErrorSlot().code, 0);
+
+  ASSERT_ANY_THROW(f(-1));
+  ASSERT_EQ(f(1), 2);
+}
+
+TEST(JitCompiler, no_throw_member_func) {
+  JitCompiler compiler({.no_throw = true});
+  std::string content = R"(
+    void test_func(TestStruct x){
+      x.test_funcx();
+    }
+   )";
+  auto rc = compiler.CompileFunction<void, TestStruct*>(content);
+  ASSERT_TRUE(rc.ok());
+  auto f = std::move(rc.value());
+  auto status = f.Call(nullptr);
+  ASSERT_TRUE(absl::IsFailedPrecondition(status));
+  // exceptions thrown by user funcs are returned as error too
+  TestStruct t;
+  status = f.Call(&t);
+  ASSERT_TRUE(absl::IsInternal(status));
+}
+
+TEST(JitCompiler, call_without_no_throw) {
+  JitCompiler compiler;
+  std::string content = R"(
+    simd_vector<f64> test_func(Context ctx, simd_vector<f64> x, simd_vector<f64> y){
+      return x + y;
+    }
+   )";
+  auto rc = compiler.CompileFunction<Vector<double>, Context&, Vector<double>, Vector<double>>(content);
+  ASSERT_TRUE(rc.ok());
+  auto f = std::move(rc.value());
+  std::vector<double> x(100, 1.0);
+  std::vector<double> y(10, 2.0);
+  Context ctx;
+  // jit code without error checks keeps the exception path, converted into status
+  auto result = f.Call(ctx, Vector<double>(x), Vector<double>(y));
+  ASSERT_FALSE(result.ok());
+  ASSERT_TRUE(absl::IsInvalidArgument(result.status()));
+  ASSERT_EQ(GetErrorSlot().code, 0);
+  ASSERT_FALSE(GetErrorSlot().no_throw);
+
+  result = f.Call(ctx, Vector<double>(x), Vector<double>(x));
+  ASSERT_TRUE(result.ok());
+  ASSERT_EQ(result.value().Size(), x.size());
+  ASSERT_DOUBLE_EQ(result.value()[99], 2.0);
+}
@@ -119,4 +119,31 @@ TEST(JitCompiler, unordered_map_access) {
   ASSERT_TRUE(get_f_result.ok());
   str_f = std::move(get_f_result.value());
   ASSERT_EQ(str_f(map), "v1");
-}
\ No newline at end of file
+}
+TEST(JitCompiler, stl_helper_lookup) {
+  std::vector<int64_t> vec;
+  for (int64_t i = 0; i < 1000; i++) {
+    vec.emplace_back(i * 3);
+  }
+  ASSERT_EQ(reflect::StdVectorHelper<int64_t>::find(&vec, 0), 0);
+  ASSERT_EQ(reflect::StdVectorHelper<int64_t>::find(&vec, 63 * 3), 63);
+  ASSERT_EQ(reflect::StdVectorHelper<int64_t>::find(&vec, 64 * 3), 64);
+  ASSERT_EQ(reflect::StdVectorHelper<int64_t>::find(&vec, 999 * 3), 999);
+  ASSERT_EQ(reflect::StdVectorHelper<int64_t>::find(&vec, 1), -1);
+  ASSERT_TRUE(reflect::StdVectorHelper<int64_t>::contains(&vec, 300));
+
+  std::unordered_map<std::string, int> map{{"t0", 0}, {"a_long_key_which_is_not_inlined", 1}};
+  using UnorderedMapHelper = reflect::StdUnorderedMapHelper<std::string, int>;
+  ASSERT_TRUE(UnorderedMapHelper::contains(&map, StringView("a_long_key_which_is_not_inlined")));
+  ASSERT_EQ(UnorderedMapHelper::get(&map, StringView("a_long_key_which_is_not_inlined")), 1);
+  ASSERT_FALSE(UnorderedMapHelper::contains(&map, StringView("t1")));
+
+  std::map<std::string, int, std::less<>> transparent_map{{"t0", 0}, {"t1", 1}};
+  using TransparentMapHelper = reflect::MapHelper<std::map<std::string, int, std::less<>>>;
+  ASSERT_EQ(TransparentMapHelper::get(&transparent_map, StringView("t1")), 1);
+  ASSERT_FALSE(TransparentMapHelper::contains(&transparent_map, StringView("t2")));
+
+  std::set<std::string> set{"s0", "s1"};
+  ASSERT_TRUE(reflect::StdSetHelper<std::string>::contains(&set, StringView("s1")));
+  ASSERT_FALSE(reflect::StdSetHelper<std::string>::contains(&set, StringView("s2")));
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rapidudf/rapidudf.h"
+
+using namespace rapidudf;
+
+TEST(Metrics, in_process_registry) {
+  metrics::InProcessRegistry registry;
+  auto* counter = registry.GetCounter("test_counter", {{"k", "v"}});
+  ASSERT_EQ(counter, registry.GetCounter("test_counter", {{"k", "v"}}));
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([counter]() {
+      for (int j = 0; j < 1000; j++) {
+        counter->Add(1);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  ASSERT_EQ(registry.GetValue("test_counter", {{"k", "v"}}), 4000);
+  ASSERT_EQ(registry.GetValue("test_counter"), 0);
+
+  auto* gauge = registry.GetGauge("test_gauge");
+  gauge->Add(10);
+  gauge->Add(-3);
+  ASSERT_EQ(registry.GetValue("test_gauge"), 7);
+  gauge->Set(100);
+  ASSERT_EQ(registry.GetValue("test_gauge"), 100);
+
+  auto* histogram = registry.GetHistogram("test_hist");
+  histogram->Observe(0);
+  histogram->Observe(3);
+  histogram->Observe(3);
+  histogram->Observe(1000);
+  ASSERT_EQ(registry.GetValue("test_hist"), 4);
+  std::string text = registry.ToPrometheusText();
+  RUDF_INFO("{}", text);
+  ASSERT_NE(text.find("test_counter{k=\"v\"} 4000"), std::string::npos);
+  ASSERT_NE(text.find("test_hist_bucket{le=\"1\"} 1"), std::string::npos);
+  ASSERT_NE(text.find("test_hist_bucket{le=\"4\"} 3"), std::string::npos);
+  ASSERT_NE(text.find("test_hist_bucket{le=\"+Inf\"} 4"), std::string::npos);
+  ASSERT_NE(text.find("test_hist_sum 1006"), std::string::npos);
+
+  // values equal to a bucket bound are counted in that bucket
+  auto* bound_histogram = registry.GetHistogram("test_bound_hist");
+  bound_histogram->Observe(1);
+  bound_histogram->Observe(2);
+  bound_histogram->Observe(4);
+  bound_histogram->Observe(5);
+  text = registry.ToPrometheusText();
+  ASSERT_NE(text.find("test_bound_hist_bucket{le=\"1\"} 1"), std::string::npos);
+  ASSERT_NE(text.find("test_bound_hist_bucket{le=\"2\"} 2"), std::string::npos);
+  ASSERT_NE(text.find("test_bound_hist_bucket{le=\"4\"} 3"), std::string::npos);
+  ASSERT_NE(text.find("test_bound_hist_bucket{le=\"8\"} 4"), std::string::npos);
+}
+
+TEST(Metrics, builtin) {
+  auto registry = metrics::get_default_metrics_registry();
+  int64_t resets = registry->GetValue("rapidudf_context_resets_total");
+  int64_t arena_bytes = registry->GetValue("rapidudf_context_arena_allocated_bytes_total");
+  {
+    Context ctx;
+    ctx.ArenaAllocate(128);
+    ctx.Reset();
+  }
+  // explicit reset & destructor
+  ASSERT_EQ(registry->GetValue("rapidudf_context_resets_total"), resets + 2);
+  ASSERT_EQ(registry->GetValue("rapidudf_context_arena_allocated_bytes_total"), arena_bytes + 128);
+
+  int64_t compiles = registry->GetValue("rapidudf_compile_total");
+  int64_t failed = registry->GetValue("rapidudf_compile_failed_total");
+  JitCompiler compiler;
+  auto f = compiler.CompileExpression<int, int>("x+1", {"x"});
+  ASSERT_TRUE(f.ok());
+  ASSERT_EQ(f.value()(1), 2);
+  auto bad = compiler.CompileExpression<int, int>("x+", {"x"});
+  ASSERT_FALSE(bad.ok());
+  ASSERT_EQ(registry->GetValue("rapidudf_compile_total"), compiles + 2);
+  ASSERT_EQ(registry->GetValue("rapidudf_compile_failed_total"), failed + 1);
+  ASSERT_GT(registry->GetValue("rapidudf_compile_phase_us", {{"phase", "optimize"}}), 0);
+  ASSERT_GT(registry->GetValue("rapidudf_jit_code_bytes"), 0);
+
+  int64_t hits = registry->GetValue("rapidudf_eval_cache_hits_total");
+  int64_t misses = registry->GetValue("rapidudf_eval_cache_misses_total");
+  std::string expr = "x * 3 + 1";
+  for (int i = 0; i < 3; i++) {
+    auto rc = exec::eval_expression<int, int>(expr, {"x"}, i);
+    ASSERT_TRUE(rc.ok());
+    ASSERT_EQ(rc.value(), i * 3 + 1);
+  }
+  ASSERT_EQ(registry->GetValue("rapidudf_eval_cache_misses_total"), misses + 1);
+  ASSERT_EQ(registry->GetValue("rapidudf_eval_cache_hits_total"), hits + 2);
+  ASSERT_GT(registry->GetValue("rapidudf_eval_cache_size"), 0);
+
+  int64_t logic_errs = registry->GetValue("rapidudf_exceptions_total", {{"type", "logic"}});
+  ASSERT_THROW(THROW_LOGIC_ERR("test error:{}", 1), std::logic_error);
+  ASSERT_EQ(registry->GetValue("rapidudf_exceptions_total", {{"type", "logic"}}), logic_errs + 1);
+}
+
+TEST(Metrics, custom_registry) {
+  auto custom = std::make_shared<metrics::InProcessRegistry>();
+  metrics::set_metrics_registry(custom);
+  {
+    Context ctx;
+  }
+  ASSERT_EQ(custom->GetValue("rapidudf_context_resets_total"), 1);
+
+  // disabled
+  metrics::set_metrics_registry(nullptr);
+  ASSERT_EQ(metrics::builtin_metrics(), nullptr);
+  {
+    Context ctx;
+  }
+  ASSERT_EQ(custom->GetValue("rapidudf_context_resets_total"), 1);
+  metrics::set_metrics_registry(metrics::get_default_metrics_registry());
+}
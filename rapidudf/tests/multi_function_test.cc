@@ -15,7 +15,12 @@
  */
 
 #include <gtest/gtest.h>
+#include <unistd.h>
+#include <atomic>
+#include <fstream>
 #include <functional>
+#include <string>
+#include <thread>
 #include <vector>
 #include "rapidudf/rapidudf.h"
 
@@ -38,4 +43,143 @@ TEST(JitCompiler, vector_size) {
   ASSERT_TRUE(func_result.ok());
   auto f = std::move(func_result.value());
   ASSERT_EQ(f(1), 12);
-}
\ No newline at end of file
+}
+TEST(JitCompiler, udf_shadow_builtin) {
+  // udfs named like builtin ops are called instead of the builtins
+  JitCompiler compiler;
+  std::string content = R"(
+    int rank(int x){
+       return x * 3;
+    }
+    int lag(int x, int n){
+       return x - n;
+    }
+    int test_func(int x){
+      return rank(x) + lag(x, 1);
+    }
+  )";
+  auto rc = compiler.CompileSource(content);
+  if (!rc.ok()) {
+    RUDF_ERROR("{}", rc.status().ToString());
+  }
+  ASSERT_TRUE(rc.ok());
+  auto func_result = compiler.LoadFunction<int, int>("test_func");
+  ASSERT_TRUE(func_result.ok());
+  auto f = std::move(func_result.value());
+  ASSERT_EQ(f(2), 7);
+}
+TEST(JitCompiler, jit_profiling) {
+  JitCompiler compiler({.jit_profiling = true, .jit_debug_info = true});
+  std::string content = R"(
+    int test_f(int x){
+       return x+1;
+    }
+    int test_func(int x){
+      if(x > 10){
+        return test_f(x);
+      }
+      return test_f(x) + 10;
+    }
+  )";
+  auto rc = compiler.CompileSource(content);
+  ASSERT_TRUE(rc.ok());
+  auto func_result = compiler.LoadFunction<int, int>("test_func");
+  ASSERT_TRUE(func_result.ok());
+  auto f = std::move(func_result.value());
+  ASSERT_EQ(f(1), 12);
+  ASSERT_EQ(f(11), 12);
+
+  std::ifstream perf_map(fmt::format("/tmp/perf-{}.map", getpid()));
+  ASSERT_TRUE(perf_map.is_open());
+  std::string line;
+  bool found = false;
+  while (std::getline(perf_map, line)) {
+    if (line.find(" test_func.") != std::string::npos) {
+      found = true;
+    }
+  }
+  ASSERT_TRUE(found);
+}
+
+TEST(JitCompiler, udf_library) {
+  UdfLibrary library;
+  std::string v1 = R"(
+    int base(int x){
+       return x + 1;
+    }
+    int twice(int x){
+      return base(x) * 2;
+    }
+    int other(int x){
+      return x - 1;
+    }
+  )";
+  auto rc = library.Load(v1);
+  ASSERT_TRUE(rc.ok());
+  ASSERT_EQ(rc.value().size(), 3);
+  auto twice = library.GetFunction<int, int>("twice").value();
+  auto other = library.GetFunction<int, int>("other").value();
+  ASSERT_EQ(twice(1), 4);
+  ASSERT_EQ(other(1), 0);
+  ASSERT_FALSE((library.GetFunction<int, float>("twice").ok()));
+  ASSERT_FALSE((library.GetFunction<int, int>("none").ok()));
+  auto snapshot = twice.Snapshot().value();
+
+  // only the changed function & its dependents recompiled
+  std::string v2 = v1;
+  v2.replace(v2.find("x + 1"), 5, "x + 2");
+  rc = library.Load(v2);
+  ASSERT_TRUE(rc.ok());
+  ASSERT_EQ(rc.value(), (std::vector<std::string>{"base", "twice"}));
+  ASSERT_EQ(twice(1), 6);
+  ASSERT_EQ(snapshot(1), 4);
+  ASSERT_EQ(library.GetVersion(), 2);
+
+  // failed reload keeps the loaded code
+  ASSERT_FALSE(library.Load("int twice(int x){ return y; }").ok());
+  ASSERT_EQ(twice(1), 6);
+
+  // removed & signature changed functions
+  rc = library.Load(R"(
+    int base(int x){
+       return x + 2;
+    }
+    float twice(float x){
+      return x * 3;
+    }
+  )");
+  ASSERT_TRUE(rc.ok());
+  ASSERT_EQ(rc.value(), (std::vector<std::string>{"twice"}));
+  ASSERT_THROW(twice(1), std::logic_error);
+  ASSERT_THROW(other(1), std::logic_error);
+  ASSERT_EQ((library.GetFunction<float, float>("twice").value()(2)), 6);
+  ASSERT_EQ(library.ListFunctions(), (std::vector<std::string>{"base", "twice"}));
+}
+
+TEST(JitCompiler, udf_library_switch_at_once) {
+  UdfLibrary library;
+  auto source = [](int v) {
+    return fmt::format("int f(int x){{ return x + {}; }}\nint g(int x){{ return x + {}; }}\n", v, v);
+  };
+  ASSERT_TRUE(library.Load(source(0)).ok());
+  std::atomic<bool> stop{false};
+  std::thread reader([&]() {
+    // every thread uses its own copies
+    auto f = library.GetFunction<int, int>("f").value();
+    auto g = library.GetFunction<int, int>("g").value();
+    while (!stop.load()) {
+      int fv = f(0);
+      int gv = g(0);
+      // `g` never runs older code than `f` called before it
+      ASSERT_GE(gv, fv);
+    }
+  });
+  for (int v = 1; v <= 20; v++) {
+    ASSERT_TRUE(library.Load(source(v)).ok());
+  }
+  stop = true;
+  reader.join();
+  auto f = library.GetFunction<int, int>("f").value();
+  ASSERT_EQ(f(0), 20);
+  ASSERT_EQ(library.GetVersion(), 21);
+}
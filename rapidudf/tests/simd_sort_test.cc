@@ -15,11 +15,15 @@
  */
 
 #include <gtest/gtest.h>
+#include <cmath>
 #include <functional>
+#include <limits>
+#include <random>
 #include <stdexcept>
 #include <vector>
 #include "absl/strings/str_join.h"
 
+#include "rapidudf/functions/simd/vector_sort.h"
 #include "rapidudf/rapidudf.h"
 #include "x86simdsort.h"
 
@@ -242,4 +246,65 @@ TEST(JitCompiler, topk_kv) {
   }
   const std::vector<double>& const_ref = data;
   ASSERT_THROW(f(ctx, const_ref), std::logic_error);
-}
\ No newline at end of file
+}
+template <typename T>
+static std::vector<T> random_sort_data(size_t n) {
+  std::mt19937_64 rng(n);
+  std::vector<T> data(n);
+  for (auto& v : data) {
+    if constexpr (std::is_floating_point_v<T>) {
+      v = static_cast<T>(static_cast<int64_t>(rng() % 2000000) - 1000000) / 7.0;
+    } else {
+      v = static_cast<T>(rng());
+    }
+  }
+  return data;
+}
+
+template <typename T>
+static void test_radix_argsort(size_t n, bool descending) {
+  Context ctx;
+  std::vector<T> data = random_sort_data<T>(n);
+  auto indices = functions::simd_vector_argsort_u32<T>(ctx, Vector<T>(data.data(), data.size()), descending);
+  ASSERT_EQ(indices.Size(), n);
+  for (size_t i = 1; i < n; i++) {
+    if (descending) {
+      ASSERT_GE(data[indices[i - 1]], data[indices[i]]);
+    } else {
+      ASSERT_LE(data[indices[i - 1]], data[indices[i]]);
+    }
+  }
+}
+
+TEST(JitCompiler, radix_argsort) {
+  for (bool descending : {false, true}) {
+    test_radix_argsort<float>(100000, descending);
+    test_radix_argsort<double>(100000, descending);
+    test_radix_argsort<int32_t>(100000, descending);
+    test_radix_argsort<uint32_t>(100000, descending);
+    test_radix_argsort<int64_t>(100000, descending);
+    test_radix_argsort<uint64_t>(100000, descending);
+    test_radix_argsort<int16_t>(10000, descending);
+    test_radix_argsort<uint16_t>(100, descending);
+    test_radix_argsort<int8_t>(1000, descending);
+    test_radix_argsort<float>(100, descending);
+  }
+  // NaNs are ordered by x86-simd-sort whatever the input size
+  for (size_t n : {100, 100000}) {
+    Context ctx;
+    ctx.SetHasNan();
+    std::vector<float> data = random_sort_data<float>(n);
+    for (size_t i = 0; i < n; i += 10) {
+      data[i] = std::numeric_limits<float>::quiet_NaN();
+    }
+    size_t nan_count = (n + 9) / 10;
+    auto indices = functions::simd_vector_argsort_u32<float>(ctx, Vector<float>(data.data(), data.size()), false);
+    ASSERT_EQ(indices.Size(), n);
+    for (size_t i = 1; i < n - nan_count; i++) {
+      ASSERT_LE(data[indices[i - 1]], data[indices[i]]);
+    }
+    for (size_t i = n - nan_count; i < n; i++) {
+      ASSERT_TRUE(std::isnan(data[indices[i]]));
+    }
+  }
+}
@@ -15,10 +15,14 @@
 //  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
+#include <numeric>
 #include <tuple>
 #include <unordered_map>
 #include <vector>
 #include "rapidudf/context/context.h"
+#include "rapidudf/functions/simd/vector_hash.h"
 #include "rapidudf/log/log.h"
 #include "rapidudf/meta/function.h"
 #include "rapidudf/rapidudf.h"
@@ -250,6 +254,72 @@ TEST(JitCompiler, table_topk) {
   }
 }
 
+TEST(JitCompiler, table_streaming_topk) {
+  auto schema = table::TableSchema::GetOrCreate(
+      "TestUser", [&](table::TableSchema* s) { std::ignore = s->AddColumns<TestUser>(); });
+
+  size_t N = 1000;
+  std::vector<std::string> candidate_citys{"sz", "sh", "bj", "gz"};
+  std::vector<TestUser> objs;
+  for (size_t i = 0; i < N; i++) {
+    objs.emplace_back(TestUser{static_cast<int>(i), 1.1 + (i * 7) % 100, candidate_citys[i % candidate_citys.size()]});
+  }
+
+  Context ctx;
+  auto table = schema->NewTable(ctx);
+  std::ignore = table->AddRows(objs);
+
+  std::vector<size_t> expected(N);
+  std::iota(expected.begin(), expected.end(), 0);
+  std::stable_sort(expected.begin(), expected.end(),
+                   [&](size_t left, size_t right) { return objs[left].score > objs[right].score; });
+
+  auto scores = table->Get<double>("score").value();
+  auto topk_table = table->Topk(scores, 20, true);
+  ASSERT_EQ(topk_table->Count(), 20);
+  for (size_t i = 0; i < topk_table->Count(); i++) {
+    ASSERT_EQ(topk_table->SlowGetRow<TestUser>(i)->id, objs[expected[i]].id);
+  }
+
+  // multi keys, score desc and id desc
+  std::vector<StringView> columns{"score", "id"};
+  std::vector<size_t> multi_key_expected = expected;
+  std::stable_sort(multi_key_expected.begin(), multi_key_expected.end(), [&](size_t left, size_t right) {
+    if (objs[left].score != objs[right].score) {
+      return objs[left].score > objs[right].score;
+    }
+    return objs[left].id > objs[right].id;
+  });
+  topk_table = table->Topk(columns, {true, true}, 20);
+  ASSERT_EQ(topk_table->Count(), 20);
+  for (size_t i = 0; i < topk_table->Count(); i++) {
+    ASSERT_EQ(topk_table->SlowGetRow<TestUser>(i)->id, objs[multi_key_expected[i]].id);
+  }
+
+  // fused with filter
+  std::string expr = R"(
+    table.topk_filter(table.score, 20, true, table.city == "sz")
+  )";
+  JitCompiler compiler;
+  auto rc = compiler.CompileDynObjExpression<table::Table*, table::Table*>(expr, {{"table", "TestUser"}});
+  if (!rc.ok()) {
+    RUDF_ERROR("{}", rc.status().ToString());
+  }
+  ASSERT_TRUE(rc.ok());
+  auto f = std::move(rc.value());
+  topk_table = f(table.get());
+  std::vector<size_t> filter_expected;
+  for (auto idx : expected) {
+    if (objs[idx].city == "sz") {
+      filter_expected.emplace_back(idx);
+    }
+  }
+  ASSERT_EQ(topk_table->Count(), 20);
+  for (size_t i = 0; i < topk_table->Count(); i++) {
+    ASSERT_EQ(topk_table->SlowGetRow<TestUser>(i)->id, objs[filter_expected[i]].id);
+  }
+}
+
 TEST(JitCompiler, table_take) {
   auto schema = table::TableSchema::GetOrCreate(
       "TestUser", [&](table::TableSchema* s) { std::ignore = s->AddColumns<TestUser>(); });
@@ -312,6 +382,347 @@ TEST(JitCompiler, group_by) {
   ASSERT_EQ(table_group.size(), 4);
 }
 
+TEST(JitCompiler, table_partition) {
+  auto schema = table::TableSchema::GetOrCreate(
+      "TestUser", [&](table::TableSchema* s) { std::ignore = s->AddColumns<TestUser>(); });
+
+  size_t N = 100;
+  std::vector<std::string> candidate_citys{"sz", "sh", "bj", "gz"};
+  std::vector<TestUser> objs;
+  for (size_t i = 0; i < N; i++) {
+    objs.emplace_back(TestUser{static_cast<int>(i), 1.1 + i, candidate_citys[i % candidate_citys.size()]});
+  }
+
+  Context ctx;
+  auto table = schema->NewTable(ctx);
+  std::ignore = table->AddRows(objs);
+  // load some columns before partition
+  auto scores = table->Get<double>("score").value();
+  ASSERT_EQ(scores.Size(), N);
+  std::ignore = table->Get<StringView>("city").value();
+
+  std::vector<uint32_t> bucket_ids(N);
+  for (size_t i = 0; i < N; i++) {
+    bucket_ids[i] = i % 3;
+  }
+  auto parts = table->Partition(ctx.NewVector(bucket_ids), 3);
+  ASSERT_EQ(parts.size(), 3);
+  for (uint32_t b = 0; b < 3; b++) {
+    auto ids = parts[b]->Get<int>("id").value();
+    auto part_scores = parts[b]->Get<double>("score").value();
+    auto citys = parts[b]->Get<StringView>("city").value();
+    ASSERT_EQ(parts[b]->Count(), (N - b + 2) / 3);
+    ASSERT_EQ(ids.Size(), parts[b]->Count());
+    for (size_t i = 0; i < ids.Size(); i++) {
+      size_t row = i * 3 + b;
+      ASSERT_EQ(ids[i], objs[row].id);
+      ASSERT_DOUBLE_EQ(part_scores[i], objs[row].score);
+      ASSERT_EQ(citys[i], StringView(objs[row].city));
+      ASSERT_EQ(parts[b]->SlowGetRow<TestUser>(i)->id, objs[row].id);
+    }
+  }
+  bucket_ids[0] = 3;
+  ASSERT_THROW(table->Partition(ctx.NewVector(bucket_ids), 3), std::logic_error);
+
+  Vector<Bit> is_sz(ctx.NewVectorBuf<Bit>(N));
+  for (size_t i = 0; i < N; i++) {
+    is_sz.Set(i, Bit(objs[i].city == "sz"));
+  }
+  auto [sz, others] = table->Split(is_sz);
+  ASSERT_EQ(sz->Count(), 25);
+  ASSERT_EQ(others->Count(), 75);
+  auto sz_citys = sz->Get<StringView>("city").value();
+  for (size_t i = 0; i < sz_citys.Size(); i++) {
+    ASSERT_EQ(sz_citys[i], "sz");
+    ASSERT_EQ(sz->SlowGetRow<TestUser>(i)->id, static_cast<int>(i * 4));
+  }
+}
+
+TEST(JitCompiler, table_append_insert_rows) {
+  auto schema = table::TableSchema::GetOrCreate(
+      "TestUser", [&](table::TableSchema* s) { std::ignore = s->AddColumns<TestUser>(); });
+
+  size_t N = 100;
+  std::vector<std::string> candidate_citys{"sz", "sh", "bj", "gz"};
+  std::vector<TestUser> objs;
+  for (size_t i = 0; i < N; i++) {
+    objs.emplace_back(TestUser{static_cast<int>(i), 1.1 + i, candidate_citys[i % candidate_citys.size()]});
+  }
+  std::vector<TestUser> head(objs.begin(), objs.begin() + N / 2);
+  std::vector<TestUser> tail(objs.begin() + N / 2, objs.end());
+
+  Context ctx;
+  auto table = schema->NewTable(ctx);
+  table->Reserve(N);
+  ASSERT_TRUE(table->AppendRows(head).ok());
+  ASSERT_EQ(table->Get<int>("id").value().Size(), N / 2);
+  // loaded columns are extended with new rows
+  ASSERT_TRUE(table->AppendRows(tail).ok());
+  auto ids = table->Get<int>("id").value();
+  ASSERT_EQ(ids.Size(), N);
+  for (size_t i = 0; i < N; i++) {
+    ASSERT_EQ(ids[i], objs[i].id);
+  }
+
+  std::vector<TestUser> inserts{TestUser{1000, 1.0, "hz"}, TestUser{1001, 1.0, "hz"}, TestUser{1002, 1.0, "hz"}};
+  std::vector<size_t> positions{0, 10, 10};
+  ASSERT_TRUE(table->InsertRows(positions, inserts).ok());
+  ASSERT_EQ(table->Count(), N + 3);
+  ids = table->Get<int>("id").value();
+  auto citys = table->Get<StringView>("city").value();
+  std::vector<int> expected_ids;
+  for (size_t i = 0; i < N; i++) {
+    if (i == 0) {
+      expected_ids.emplace_back(1000);
+    }
+    if (i == 10) {
+      expected_ids.emplace_back(1001);
+      expected_ids.emplace_back(1002);
+    }
+    expected_ids.emplace_back(objs[i].id);
+  }
+  ASSERT_EQ(ids.Size(), expected_ids.size());
+  for (size_t i = 0; i < expected_ids.size(); i++) {
+    ASSERT_EQ(ids[i], expected_ids[i]);
+    ASSERT_EQ(table->SlowGetRow<TestUser>(i)->id, expected_ids[i]);
+    ASSERT_EQ(citys[i], StringView(table->SlowGetRow<TestUser>(i)->city));
+  }
+
+  std::vector<size_t> unsorted_positions{10, 0, 0};
+  ASSERT_FALSE(table->InsertRows(unsorted_positions, inserts).ok());
+  ASSERT_EQ(table->Count(), N + 3);
+
+  TestUser last{2000, 1.0, "hz"};
+  ASSERT_TRUE(table->AppendRow(&last).ok());
+  ids = table->Get<int>("id").value();
+  ASSERT_EQ(ids.Size(), N + 4);
+  ASSERT_EQ(ids[N + 3], 2000);
+}
+
+TEST(JitCompiler, table_jit_filter_map) {
+  auto schema = table::TableSchema::GetOrCreate(
+      "TestUser", [&](table::TableSchema* s) { std::ignore = s->AddColumns<TestUser>(); });
+
+  size_t N = 200;
+  std::vector<std::string> candidate_citys{"sz", "sh", "bj", "gz"};
+  std::vector<TestUser> objs;
+  for (size_t i = 0; i < N; i++) {
+    objs.emplace_back(TestUser{static_cast<int>(i), 1.1 + i, candidate_citys[i % candidate_citys.size()]});
+  }
+
+  Context ctx;
+  auto table = schema->NewTable(ctx);
+  std::ignore = table->AddRows(objs);
+
+  auto mask_result = table->Filter(R"(table.id > 100 && table.city == "sz")");
+  if (!mask_result.ok()) {
+    RUDF_ERROR("{}", mask_result.status().ToString());
+  }
+  ASSERT_TRUE(mask_result.ok());
+  auto mask = mask_result.value();
+  auto expected_mask = table->Filter<TestUser>(
+      [](size_t, const TestUser* user) { return user->id > 100 && user->city == "sz"; });
+  ASSERT_EQ(mask.Size(), N);
+  for (size_t i = 0; i < N; i++) {
+    ASSERT_EQ(static_cast<bool>(mask[i]), static_cast<bool>(expected_mask[i]));
+  }
+  // visit set bits of the mask only
+  std::vector<int> visited;
+  auto status = table->Foreach<void, TestUser>([&](size_t, const TestUser* user) { visited.emplace_back(user->id); },
+                                               &mask);
+  ASSERT_TRUE(status.ok());
+  ASSERT_EQ(visited.size(), 25);
+  for (size_t i = 0; i < visited.size(); i++) {
+    ASSERT_EQ(visited[i], 104 + static_cast<int>(i) * 4);
+  }
+
+  auto scores = table->Map<double>("table.score + table.score");
+  if (!scores.ok()) {
+    RUDF_ERROR("{}", scores.status().ToString());
+  }
+  ASSERT_TRUE(scores.ok());
+  ASSERT_EQ(scores.value().Size(), N);
+  for (size_t i = 0; i < N; i++) {
+    ASSERT_DOUBLE_EQ(scores.value()[i], objs[i].score * 2);
+  }
+  ASSERT_FALSE(table->Map<double>("table.no_such_column").ok());
+}
+
+TEST(JitCompiler, table_computed_columns) {
+  absl::Status self_ref_status;
+  absl::Status forward_ref_status;
+  auto schema = table::TableSchema::GetOrCreate("TestUserComputed", [&](table::TableSchema* s) {
+    std::ignore = s->AddColumns<TestUser>();
+    std::ignore = s->AddComputedColumn<double>("score2", "table.score + table.score");
+    std::ignore = s->AddComputedColumn<bool>("high_score", "table.score2 > 100.0");
+    self_ref_status = s->AddComputedColumn<int>("self_ref", "table.self_ref + 1");
+    forward_ref_status = s->AddComputedColumn<int>("forward_ref", "table.id2 + 1");
+    std::ignore = s->AddComputedColumn<int>("id2", "table.id + table.id");
+  });
+  ASSERT_FALSE(self_ref_status.ok());
+  ASSERT_FALSE(forward_ref_status.ok());
+
+  size_t N = 100;
+  std::vector<std::string> candidate_citys{"sz", "sh", "bj", "gz"};
+  std::vector<TestUser> objs;
+  for (size_t i = 0; i < 2 * N; i++) {
+    objs.emplace_back(TestUser{static_cast<int>(i), 1.1 + i, candidate_citys[i % candidate_citys.size()]});
+  }
+  std::vector<TestUser> first(objs.begin(), objs.begin() + N);
+  std::vector<TestUser> second(objs.begin() + N, objs.end());
+
+  Context ctx;
+  auto table = schema->NewTable(ctx);
+  std::ignore = table->AddRows(first);
+
+  auto score2 = table->Get<double>("score2");
+  if (!score2.ok()) {
+    RUDF_ERROR("{}", score2.status().ToString());
+  }
+  ASSERT_TRUE(score2.ok());
+  ASSERT_EQ(score2.value().Size(), N);
+  for (size_t i = 0; i < N; i++) {
+    ASSERT_DOUBLE_EQ(score2.value()[i], objs[i].score * 2);
+  }
+  // computed columns are read in expressions like other columns
+  auto high = table->Filter("table.high_score");
+  if (!high.ok()) {
+    RUDF_ERROR("{}", high.status().ToString());
+  }
+  ASSERT_TRUE(high.ok());
+  auto filtered = table->Filter(high.value());
+  ASSERT_EQ(filtered->Count(), 51);
+
+  // cached until a dependency changes, only direct & indirect dependents are evaluated again
+  auto id2 = table->Get<int>("id2").value();
+  auto high_score = table->Get<bool>("high_score").value();
+  ASSERT_EQ(table->Get<double>("score2").value().Data(), score2.value().Data());
+  ASSERT_TRUE(table->UnloadColumn("score").ok());
+  ASSERT_EQ(table->Get<int>("id2").value().Data(), id2.Data());
+  ASSERT_NE(table->Get<double>("score2").value().Data(), score2.value().Data());
+  ASSERT_NE(table->Get<bool>("high_score").value().Data(), high_score.Data());
+
+  // evaluated again for all rows after rows appended
+  std::ignore = table->AddRows(second);
+  auto new_score2 = table->Get<double>("score2").value();
+  auto new_id2 = table->Get<int>("id2").value();
+  ASSERT_EQ(new_score2.Size(), 2 * N);
+  ASSERT_EQ(new_id2.Size(), 2 * N);
+  for (size_t i = 0; i < 2 * N; i++) {
+    ASSERT_DOUBLE_EQ(new_score2[i], objs[i].score * 2);
+    ASSERT_EQ(new_id2[i], objs[i].id * 2);
+  }
+
+  // set a source column
+  std::vector<double> new_scores(2 * N, 60.0);
+  high_score = table->Get<bool>("high_score").value();
+  ASSERT_TRUE(table->Set("score", Vector<double>(new_scores)).ok());
+  ASSERT_EQ(table->Get<int>("id2").value().Data(), new_id2.Data());
+  auto set_high_score = table->Get<bool>("high_score").value();
+  ASSERT_NE(set_high_score.Data(), high_score.Data());
+  ASSERT_EQ(set_high_score.Size(), 2 * N);
+  for (size_t i = 0; i < 2 * N; i++) {
+    ASSERT_TRUE(static_cast<bool>(set_high_score[i]));
+  }
+}
+
+struct TestSplitStruct {
+  std::string line;
+  int64_t uid = 0;
+  std::string tag;
+  double score = 0;
+};
+RUDF_STRUCT_FIELDS(TestSplitStruct, line, uid, tag, score)
+TEST(JitCompiler, table_split_to_columns) {
+  auto schema = table::TableSchema::GetOrCreate("TestSplitStruct", [&](table::TableSchema* s) {
+    std::ignore = s->AddColumns<TestSplitStruct>();
+    std::ignore = s->AddComputedColumn<double>("score2", "table.score + table.score");
+  });
+  std::vector<TestSplitStruct> objs{{"3950308951:sz:0.25"}, {"-17:sh:1.5e3"}, {"42"}, {""}, {"7::2.5"}};
+
+  Context ctx;
+  auto table = schema->NewTable(ctx);
+  std::ignore = table->AddRows(objs);
+  ASSERT_DOUBLE_EQ(table->Get<double>("score2").value()[1], 0);
+
+  std::string expr = R"(
+      table<TestSplitStruct> test_func(table<TestSplitStruct> x){
+      return x.split_to_columns("line", ":", "uid,tag,score");
+    }
+  )";
+  JitCompiler compiler;
+  auto rc = compiler.CompileFunction<table::Table*, table::Table*>(expr);
+  if (!rc.ok()) {
+    RUDF_ERROR("{}", rc.status().ToString());
+  }
+  ASSERT_TRUE(rc.ok());
+  auto f = std::move(rc.value());
+  table::Table* split_table = f(table.get());
+  ASSERT_EQ(split_table, table.get());
+  auto uid = table->Get<int64_t>("uid").value();
+  auto tag = table->Get<StringView>("tag").value();
+  auto score = table->Get<double>("score").value();
+  auto score2 = table->Get<double>("score2").value();
+  ASSERT_EQ(uid.Size(), objs.size());
+  ASSERT_EQ(uid[0], 3950308951);
+  ASSERT_EQ(uid[1], -17);
+  ASSERT_EQ(uid[2], 42);
+  ASSERT_EQ(uid[3], 0);
+  ASSERT_EQ(tag[0], "sz");
+  ASSERT_EQ(tag[2].size(), 0);
+  ASSERT_DOUBLE_EQ(score[0], 0.25);
+  ASSERT_DOUBLE_EQ(score2[1], 3000);
+  // empty field keeps its column
+  ASSERT_EQ(uid[4], 7);
+  ASSERT_EQ(tag[4].size(), 0);
+  ASSERT_DOUBLE_EQ(score[4], 2.5);
+
+  ASSERT_FALSE(table->SplitToColumns("line", ":", {"score2"}).ok());
+  ASSERT_FALSE(table->SplitToColumns("line", ":", {"no_such_column"}).ok());
+}
+
+TEST(JitCompiler, table_half_float_columns) {
+  table::TableColumnOptions f16_opts;
+  f16_opts.f16_fields.emplace("score");
+  auto f16_schema = table::TableSchema::GetOrCreate(
+      "TestUserF16", [&](table::TableSchema* s) { std::ignore = s->AddColumns<TestUser>(f16_opts); });
+  table::TableColumnOptions bf16_opts;
+  bf16_opts.bf16_fields.emplace("score");
+  auto bf16_schema = table::TableSchema::GetOrCreate(
+      "TestUserBF16", [&](table::TableSchema* s) { std::ignore = s->AddColumns<TestUser>(bf16_opts); });
+  ASSERT_TRUE(f16_schema->ExistColumn("score", get_dtype<Vector<Float16>>()));
+  ASSERT_TRUE(bf16_schema->ExistColumn("score", get_dtype<Vector<BFloat16>>()));
+
+  size_t N = 100;
+  std::vector<TestUser> objs;
+  for (size_t i = 0; i < N; i++) {
+    objs.emplace_back(TestUser{static_cast<int>(i), 1.1 + i, "sz"});
+  }
+  Context ctx;
+  auto f16_table = f16_schema->NewTable(ctx);
+  std::ignore = f16_table->AddRows(objs);
+  auto bf16_table = bf16_schema->NewTable(ctx);
+  std::ignore = bf16_table->AddRows(objs);
+
+  auto f16_scores = f16_table->Get<Float16>("score");
+  auto bf16_scores = bf16_table->Get<BFloat16>("score");
+  ASSERT_TRUE(f16_scores.ok());
+  ASSERT_TRUE(bf16_scores.ok());
+  ASSERT_EQ(f16_scores.value().Size(), N);
+  ASSERT_EQ(bf16_scores.value().Size(), N);
+  for (size_t i = 0; i < N; i++) {
+    float score = static_cast<float>(objs[i].score);
+    ASSERT_EQ(f16_scores.value()[i].Bits(), Float16(score).Bits());
+    ASSERT_EQ(bf16_scores.value()[i].Bits(), BFloat16(score).Bits());
+  }
+
+  // group/dedup keys of half floats are hashed & compared by bits
+  Float16 a(1.25f), b(1.5f), nan(std::numeric_limits<float>::quiet_NaN());
+  DType f16_dtype = get_dtype<Float16>();
+  ASSERT_NE(f16_dtype.Hash(reinterpret_cast<const uint8_t*>(&a)), f16_dtype.Hash(reinterpret_cast<const uint8_t*>(&b)));
+  ASSERT_TRUE(f16_dtype.Equal(reinterpret_cast<const uint8_t*>(&nan), reinterpret_cast<const uint8_t*>(&nan)));
+}
+
 TEST(JitCompiler, dedup) {
   auto schema = table::TableSchema::GetOrCreate(
       "TestUser", [&](table::TableSchema* s) { std::ignore = s->AddColumns<TestUser>(); });
@@ -332,6 +743,201 @@ TEST(JitCompiler, dedup) {
   ASSERT_EQ(after_dedup->Count(), 8);
 }
 
+TEST(JitCompiler, multi_columns_distinct) {
+  auto schema = table::TableSchema::GetOrCreate(
+      "TestUser", [&](table::TableSchema* s) { std::ignore = s->AddColumns<TestUser>(); });
+
+  size_t N = 100;
+  std::vector<std::string> candidate_citys{"sz", "sh", "bj", "gz"};
+  std::vector<TestUser> objs;
+  for (size_t i = 0; i < N; i++) {
+    objs.emplace_back(TestUser{static_cast<int>(i % 10), 1.1 + i, candidate_citys[i % candidate_citys.size()]});
+  }
+
+  Context ctx;
+  auto table = schema->NewTable(ctx);
+  std::ignore = table->AddRows(objs);
+
+  std::vector<StringView> columns{"id", "city"};
+  auto hashes = table->HashColumns(columns);
+  ASSERT_EQ(hashes.Size(), N);
+  ASSERT_EQ(hashes[0], hashes[20]);
+  ASSERT_NE(hashes[0], hashes[10]);
+  // same as the vector hash builtins
+  auto id_hashes = functions::simd_vector_hash(ctx, table->Get<int>("id").value());
+  auto city_hashes = functions::simd_vector_hash(ctx, table->Get<StringView>("city").value());
+  auto combined_hashes = functions::simd_vector_hash_combine(ctx, id_hashes, city_hashes);
+  for (size_t i = 0; i < N; i++) {
+    ASSERT_EQ(hashes[i], combined_hashes[i]);
+  }
+  auto empty_hashes = table->HashColumns({});
+  ASSERT_EQ(empty_hashes.Size(), N);
+  for (size_t i = 0; i < N; i++) {
+    ASSERT_EQ(empty_hashes[i], 0);
+  }
+
+  // (id, city) repeats every 20 rows
+  auto table_group = table->GroupBy(columns);
+  ASSERT_EQ(table_group.size(), 20);
+  for (auto* group : table_group) {
+    ASSERT_EQ(group->Count(), 5);
+  }
+
+  auto after_dedup = table->Filter(table->Dedup(absl::Span<const StringView>(columns), 2));
+  ASSERT_EQ(after_dedup->Count(), 40);
+
+  absl::Status s = table->Distinct(columns);
+  ASSERT_TRUE(s.ok());
+  ASSERT_EQ(table->Count(), 20);
+  for (size_t i = 0; i < table->Count(); i++) {
+    ASSERT_EQ(table->SlowGetRow<TestUser>(i)->id, objs[i].id);
+    ASSERT_EQ(table->SlowGetRow<TestUser>(i)->city, objs[i].city);
+  }
+}
+
+TEST(JitCompiler, table_rank) {
+  auto schema = table::TableSchema::GetOrCreate(
+      "TestUser", [&](table::TableSchema* s) { std::ignore = s->AddColumns<TestUser>(); });
+  std::vector<std::string> citys{"bj", "bj", "gz", "sh", "sh", "sz"};
+  std::vector<TestUser> objs;
+  for (size_t i = 0; i < citys.size(); i++) {
+    objs.emplace_back(TestUser{static_cast<int>(i), 1.1 + i, citys[i]});
+  }
+  Context ctx;
+  auto table = schema->NewTable(ctx);
+  std::ignore = table->AddRows(objs);
+
+  auto row_number = table->RowNumber();
+  auto rank = table->Rank("city");
+  auto dense_rank = table->Rank("city", true);
+  std::vector<uint32_t> expected_rank{1, 1, 3, 4, 4, 6};
+  std::vector<uint32_t> expected_dense_rank{1, 1, 2, 3, 3, 4};
+  for (size_t i = 0; i < citys.size(); i++) {
+    ASSERT_EQ(row_number[i], i + 1);
+    ASSERT_EQ(rank[i], expected_rank[i]);
+    ASSERT_EQ(dense_rank[i], expected_dense_rank[i]);
+  }
+
+  std::string expr = R"(
+    table.dense_rank("city") + table.row_number()
+  )";
+  JitCompiler compiler;
+  auto rc = compiler.CompileDynObjExpression<Vector<uint32_t>, Context&, table::Table*>(
+      expr, {{"_"}, {"table", "TestUser"}});
+  if (!rc.ok()) {
+    RUDF_ERROR("{}", rc.status().ToString());
+  }
+  ASSERT_TRUE(rc.ok());
+  auto f = std::move(rc.value());
+  auto result = f(ctx, table.get());
+  ASSERT_EQ(result.Size(), citys.size());
+  for (size_t i = 0; i < citys.size(); i++) {
+    ASSERT_EQ(result[i], expected_dense_rank[i] + i + 1);
+  }
+}
+
+TEST(JitCompiler, table_diversify) {
+  auto schema = table::TableSchema::GetOrCreate(
+      "TestUser", [&](table::TableSchema* s) { std::ignore = s->AddColumns<TestUser>(); });
+  std::vector<std::string> citys{"bj", "bj", "bj", "bj", "sh", "sh", "sz", "sz"};
+  std::vector<TestUser> objs;
+  for (size_t i = 0; i < citys.size(); i++) {
+    objs.emplace_back(TestUser{static_cast<int>(i), 10.0 - i, citys[i]});
+  }
+  Context ctx;
+  auto table = schema->NewTable(ctx);
+  std::ignore = table->AddRows(objs);
+
+  auto diversified = table->Diversify("city", 3, 1);
+  std::vector<int> expected_ids{0, 4, 6, 1, 5, 7, 2, 3};
+  ASSERT_EQ(diversified->Count(), expected_ids.size());
+  for (size_t i = 0; i < expected_ids.size(); i++) {
+    ASSERT_EQ(diversified->SlowGetRow<TestUser>(i)->id, expected_ids[i]);
+  }
+
+  std::string expr = R"(
+    table.diversify("city", 5, 2)
+  )";
+  JitCompiler compiler;
+  auto rc = compiler.CompileDynObjExpression<table::Table*, table::Table*>(expr, {{"table", "TestUser"}});
+  if (!rc.ok()) {
+    RUDF_ERROR("{}", rc.status().ToString());
+  }
+  ASSERT_TRUE(rc.ok());
+  auto f = std::move(rc.value());
+  auto* new_table = f(table.get());
+  expected_ids = {0, 1, 4, 5, 6, 2, 3, 7};
+  auto new_id_column = new_table->Get<int>("id").value();
+  for (size_t i = 0; i < expected_ids.size(); i++) {
+    ASSERT_EQ(new_id_column[i], expected_ids[i]);
+  }
+
+  // row 1 is a near duplicate of row 0, mmr prefers the lower scored but dissimilar row 2.
+  auto mmr_table = schema->NewTable(ctx);
+  std::ignore = mmr_table->AddRows(std::vector<TestUser>{objs[0], objs[1], objs[2]});
+  std::vector<double> scores{1.0, 0.99, 0.5};
+  std::vector<double> embeddings{1.0, 0.0, 1.0, 0.01, 0.0, 1.0};
+  auto mmr_result = mmr_table->Mmr<double>(scores, embeddings, 2, 0.5);
+  ASSERT_EQ(mmr_result->Count(), 2);
+  ASSERT_EQ(mmr_result->SlowGetRow<TestUser>(0)->id, 0);
+  ASSERT_EQ(mmr_result->SlowGetRow<TestUser>(1)->id, 2);
+}
+
+TEST(JitCompiler, table_shuffle_sample) {
+  auto schema = table::TableSchema::GetOrCreate(
+      "TestUser", [&](table::TableSchema* s) { std::ignore = s->AddColumns<TestUser>(); });
+  std::vector<TestUser> objs;
+  for (int i = 0; i < 100; i++) {
+    objs.emplace_back(TestUser{i, static_cast<double>(i % 10), "bj"});
+  }
+  Context ctx;
+  ctx.SetRequestId(1001);
+  auto table = schema->NewTable(ctx);
+  std::ignore = table->AddRows(objs);
+
+  auto shuffled = table->Shuffle(7);
+  auto ids = shuffled->Get<int>("id").value();
+  ASSERT_EQ(ids.Size(), objs.size());
+  std::vector<int> sorted_ids(ids.Data(), ids.Data() + ids.Size());
+  std::sort(sorted_ids.begin(), sorted_ids.end());
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(sorted_ids[i], i);
+  }
+  auto again = table->Shuffle(7)->Get<int>("id").value();
+  auto other = table->Shuffle(8)->Get<int>("id").value();
+  bool same_as_other = true;
+  for (size_t i = 0; i < ids.Size(); i++) {
+    ASSERT_EQ(ids[i], again[i]);
+    same_as_other = same_as_other && ids[i] == other[i];
+  }
+  ASSERT_FALSE(same_as_other);
+
+  std::string expr = R"(
+    table.weighted_sample(table.score, 5, 42)
+  )";
+  JitCompiler compiler;
+  auto rc = compiler.CompileDynObjExpression<table::Table*, table::Table*>(expr, {{"table", "TestUser"}});
+  if (!rc.ok()) {
+    RUDF_ERROR("{}", rc.status().ToString());
+  }
+  ASSERT_TRUE(rc.ok());
+  auto sampled = rc.value()(table.get());
+  ASSERT_EQ(sampled->Count(), 5);
+  auto sampled_ids = sampled->Get<int>("id").value();
+  auto expected_ids = table->WeightedSample(table->Get<double>("score").value(), 5, 42)->Get<int>("id").value();
+  for (size_t i = 0; i < sampled_ids.Size(); i++) {
+    // zero weight rows are never selected
+    ASSERT_NE(sampled_ids[i] % 10, 0);
+    ASSERT_EQ(sampled_ids[i], expected_ids[i]);
+  }
+  // only 9 rows with positive weight
+  std::vector<double> weights(100, 0.0);
+  for (int i = 0; i < 9; i++) {
+    weights[i * 11] = 1.0;
+  }
+  ASSERT_EQ(table->WeightedSample<double>(weights, 20, 42)->Count(), 9);
+}
+
 struct FilterStruct {
   std::string city;
   int id;
@@ -459,6 +1065,53 @@ TEST(JitCompiler, distinct) {
   ASSERT_EQ(table3->Count(), 150);
 }
 
+TEST(JitCompiler, table_concat_many) {
+  auto schema = table::TableSchema::GetOrCreate(
+      "TestUser", [&](table::TableSchema* s) { std::ignore = s->AddColumns<TestUser>(); });
+
+  size_t N = 30;
+  std::vector<std::string> candidate_citys{"sz", "sh", "bj", "gz"};
+  std::vector<TestUser> objs;
+  for (size_t i = 0; i < N; i++) {
+    objs.emplace_back(TestUser{static_cast<int>(i), 1.1 + i, candidate_citys[i % candidate_citys.size()]});
+  }
+
+  Context ctx;
+  std::vector<table::Table::SmartPtr> sources;
+  std::vector<table::Table*> others;
+  for (size_t i = 0; i < 3; i++) {
+    std::vector<TestUser*> rows;
+    for (size_t j = i * 10; j < i * 10 + 10; j++) {
+      rows.emplace_back(&objs[j]);
+    }
+    auto table = schema->NewTable(ctx);
+    std::ignore = table->AddRows(rows);
+    std::ignore = table->Get<int>("id");
+    // `city` is not loaded in the last table, reloaded lazily after concat
+    if (i < 2) {
+      std::ignore = table->Get<StringView>("city");
+    }
+    if (i > 0) {
+      others.emplace_back(table.get());
+    }
+    sources.emplace_back(std::move(table));
+  }
+  auto empty_table = schema->NewTable(ctx);
+  others.emplace_back(empty_table.get());
+
+  auto* merged = sources[0]->Concat(absl::MakeSpan(others));
+  ASSERT_EQ(merged->Count(), N);
+  auto ids = merged->Get<int>("id").value();
+  auto citys = merged->Get<StringView>("city").value();
+  ASSERT_EQ(ids.Size(), N);
+  ASSERT_EQ(citys.Size(), N);
+  for (size_t i = 0; i < N; i++) {
+    ASSERT_EQ(ids[i], objs[i].id);
+    ASSERT_EQ(citys[i], StringView(objs[i].city));
+    ASSERT_EQ(merged->SlowGetRow<TestUser>(i)->id, objs[i].id);
+  }
+}
+
 TEST(JitCompiler, distinct_merge) {
   auto schema = table::TableSchema::GetOrCreate(
       "TestUser", [&](table::TableSchema* s) { std::ignore = s->AddColumns<TestUser>(); });
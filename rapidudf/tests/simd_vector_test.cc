@@ -15,13 +15,23 @@
  */
 
 #include <gtest/gtest.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <functional>
+#include <numeric>
 #include <random>
 #include <vector>
 
 #include "rapidudf/context/context.h"
+#include "rapidudf/functions/simd/vector_convert.h"
+#include "rapidudf/functions/simd/vector_hash.h"
 #include "rapidudf/functions/simd/vector_misc.h"
+#include "rapidudf/functions/simd/vector_random.h"
+#include "rapidudf/functions/simd/vector_time.h"
+#include "rapidudf/functions/simd/vector_window.h"
 #include "rapidudf/log/log.h"
 #include "rapidudf/meta/function.h"
 #include "rapidudf/meta/optype.h"
@@ -683,6 +693,72 @@ TEST(JitCompiler, user_vector_func) {
   }
 }
 
+static double test_scalar_score(double x, int y, TestParams* params) { return x * 0.5 + y + params->boost; }
+RUDF_SCALAR_VECTOR_FUNC_REGISTER(test_scalar_score)
+static size_t test_scalar_div_calls = 0;
+static int test_scalar_div(int x, int y) {
+  test_scalar_div_calls++;
+  return x / y;
+}
+RUDF_SCALAR_VECTOR_FUNC_REGISTER(test_scalar_div)
+
+TEST(JitCompiler, scalar_vector_func) {
+  auto* desc = FunctionFactory::GetFunction(GetVectorFunctionName("test_scalar_score"));
+  ASSERT_TRUE(desc != nullptr);
+  ASSERT_TRUE(desc->is_vector_func);
+
+  std::string source = R"(
+     test_scalar_score(x, y, params) + 1
+  )";
+
+  rapidudf::JitCompiler compiler;
+  using simd_vector_f64 = rapidudf::Vector<double>;
+  using simd_vector_i32 = rapidudf::Vector<int>;
+  auto result = compiler.CompileExpression<simd_vector_f64, Context&, simd_vector_f64, simd_vector_i32, TestParams&>(
+      source, {"_", "x", "y", "params"});
+  if (!result.ok()) {
+    RUDF_ERROR("{}", result.status().ToString());
+  }
+  ASSERT_TRUE(result.ok());
+  auto f = std::move(result.value());
+  Context ctx;
+
+  std::vector<double> test_x;
+  std::vector<int> test_y;
+  for (size_t i = 0; i < 150; i++) {
+    test_x.emplace_back(i * 1.5);
+    test_y.emplace_back(i);
+  }
+  TestParams params;
+  auto z = f(ctx, test_x, test_y, params);
+  ASSERT_EQ(z.Size(), test_x.size());
+  for (size_t i = 0; i < test_x.size(); i++) {
+    ASSERT_DOUBLE_EQ(z[i], test_scalar_score(test_x[i], test_y[i], &params) + 1);
+  }
+
+  auto scalar_result = compiler.CompileExpression<double, double, int, TestParams&>("test_scalar_score(x, y, params)",
+                                                                                    {"x", "y", "params"});
+  ASSERT_TRUE(scalar_result.ok());
+  auto scalar_f = std::move(scalar_result.value());
+  ASSERT_DOUBLE_EQ(scalar_f(2.0, 3, params), test_scalar_score(2.0, 3, &params));
+
+  // padding lanes of the tail block are not passed to the scalar func
+  auto div_result = compiler.CompileExpression<simd_vector_i32, Context&, simd_vector_i32, simd_vector_i32>(
+      "test_scalar_div(x, y)", {"_", "x", "y"});
+  ASSERT_TRUE(div_result.ok());
+  auto div_f = std::move(div_result.value());
+  std::vector<int> divisors;
+  for (size_t i = 0; i < test_y.size(); i++) {
+    divisors.emplace_back(static_cast<int>(i % 7) + 1);
+  }
+  auto div_z = div_f(ctx, test_y, divisors);
+  ASSERT_EQ(div_z.Size(), test_y.size());
+  ASSERT_EQ(test_scalar_div_calls, test_y.size());
+  for (size_t i = 0; i < test_y.size(); i++) {
+    ASSERT_EQ(div_z[i], test_y[i] / divisors[i]);
+  }
+}
+
 TEST(JitCompiler, vector_l2_distance) {
   std::vector<float> vec1, vec2;
   for (size_t i = 0; i < 100; i++) {
@@ -705,3 +781,472 @@ TEST(JitCompiler, vector_cos_distance) {
   RUDF_INFO("{} {}", score, score1);
   ASSERT_FLOAT_EQ(score, score1);
 }
+
+template <typename T>
+static void test_bucketize(Context& ctx, size_t bounds_count) {
+  // negative values/boundaries for signed types, wrapped huge values for unsigned types
+  int64_t offset = std::is_signed_v<T> ? -50 : 0;
+  std::vector<T> boundaries;
+  for (size_t i = 0; i < bounds_count; i++) {
+    boundaries.emplace_back(static_cast<T>(offset + static_cast<int64_t>(i) * 3));
+  }
+  if (bounds_count > 2) {
+    boundaries.emplace_back(boundaries.back());
+  }
+  // more than lanes with a ragged tail, every 3rd value equals a boundary
+  std::vector<T> values;
+  for (size_t i = 0; i < 1003; i++) {
+    T v = static_cast<T>(offset + static_cast<int64_t>(i % 131) - 10);
+    if constexpr (std::is_floating_point_v<T>) {
+      if (i % 262 >= 131) {
+        v += static_cast<T>(0.5);
+      }
+    }
+    values.emplace_back(v);
+  }
+  auto bucket_ids = functions::simd_vector_bucketize<T>(ctx, values, boundaries);
+  ASSERT_EQ(bucket_ids.Size(), values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    auto expected = std::upper_bound(boundaries.begin(), boundaries.end(), values[i]) - boundaries.begin();
+    ASSERT_EQ(bucket_ids[i], static_cast<uint32_t>(expected)) << "bounds:" << boundaries.size() << ",idx:" << i;
+  }
+}
+
+TEST(JitCompiler, vector_hash) {
+  rapidudf::JitCompiler compiler;
+  rapidudf::Context ctx;
+  std::string source = R"(
+    simd_vector<u32> test_func(Context ctx, simd_vector<i32> x, simd_vector<string_view> y){
+      return mod_bucket(hash_combine(hash(x), hash(y)), 1000);
+    }
+  )";
+  auto rc = compiler.CompileFunction<Vector<uint32_t>, Context&, Vector<int32_t>, Vector<StringView>>(source);
+  if (!rc.ok()) {
+    RUDF_ERROR("{}", rc.status().ToString());
+  }
+  ASSERT_TRUE(rc.ok());
+  std::vector<int32_t> ids;
+  std::vector<std::string> tags;
+  for (int32_t i = 0; i < 100; i++) {
+    ids.emplace_back(i - 50);
+    tags.emplace_back("tag_" + std::to_string(i % 7));
+  }
+  std::vector<StringView> tag_views(tags.begin(), tags.end());
+  auto buckets = rc.value()(ctx, ids, tag_views);
+  ASSERT_EQ(buckets.Size(), ids.size());
+  std::vector<int64_t> ids64(ids.begin(), ids.end());
+  auto id_hashes = functions::simd_vector_hash<int64_t>(ctx, ids64);
+  for (size_t i = 0; i < ids.size(); i++) {
+    uint64_t tag_hash = functions::xxhash64(tags[i].data(), tags[i].size());
+    auto crossed = functions::simd_vector_hash_combine(ctx, std::vector<uint64_t>{id_hashes[i]},
+                                                       std::vector<uint64_t>{tag_hash});
+    ASSERT_EQ(buckets[i], crossed[0] % 1000);
+  }
+  ASSERT_EQ(functions::xxhash64("abc", 3), 0x44BC2CF5AD770999ULL);
+
+  std::vector<float> values{-1.0f, 0.0f, 0.5f, 1.0f, 2.5f, 10.0f};
+  std::vector<float> boundaries{0.0f, 1.0f, 2.5f};
+  auto bucket_ids = functions::simd_vector_bucketize<float>(ctx, values, boundaries);
+  std::vector<uint32_t> expected{0, 1, 1, 2, 3, 3};
+  for (size_t i = 0; i < values.size(); i++) {
+    ASSERT_EQ(bucket_ids[i], expected[i]);
+  }
+  std::vector<float> unsorted{1.0f, 0.0f};
+  ASSERT_THROW(functions::simd_vector_bucketize<float>(ctx, values, unsorted), std::logic_error);
+  for (size_t bounds_count : {0, 1, 2, 37}) {
+    test_bucketize<float>(ctx, bounds_count);
+    test_bucketize<double>(ctx, bounds_count);
+    test_bucketize<uint64_t>(ctx, bounds_count);
+    test_bucketize<int64_t>(ctx, bounds_count);
+    test_bucketize<uint32_t>(ctx, bounds_count);
+    test_bucketize<int32_t>(ctx, bounds_count);
+  }
+}
+
+TEST(JitCompiler, vector_time) {
+  rapidudf::JitCompiler compiler;
+  rapidudf::Context ctx;
+  std::string source = R"(
+    simd_vector<i32> test_func(Context ctx, simd_vector<i64> ts){
+      return hour_of_day(ts, 28800) * 1000 + day_of_week(ts, 0) * 100 + days_since(ts);
+    }
+  )";
+  auto rc = compiler.CompileFunction<Vector<int32_t>, Context&, Vector<int64_t>>(source);
+  if (!rc.ok()) {
+    RUDF_ERROR("{}", rc.status().ToString());
+  }
+  ASSERT_TRUE(rc.ok());
+  // 2023-11-14 22:13:20 UTC, tuesday
+  int64_t now = 1700000000;
+  ctx.SetNow(now * 1000000);
+  std::vector<int64_t> ts;
+  for (int64_t i = 0; i < 67; i++) {
+    ts.emplace_back(now - i * 12345);
+  }
+  ts.emplace_back(-1);
+  auto result = rc.value()(ctx, ts);
+  ASSERT_EQ(result.Size(), ts.size());
+  for (size_t i = 0; i < ts.size(); i++) {
+    time_t local_ts = ts[i] + 28800;
+    time_t utc_ts = ts[i];
+    struct tm local, utc;
+    gmtime_r(&local_ts, &local);
+    gmtime_r(&utc_ts, &utc);
+    int64_t days = (now - ts[i]) / 86400;
+    ASSERT_EQ(result[i], local.tm_hour * 1000 + utc.tm_wday * 100 + days);
+  }
+
+  auto now_rc = compiler.CompileExpression<uint64_t, Context&>("ctx_now_s() + ctx_now_ms() / 1000", {"ctx"});
+  ASSERT_TRUE(now_rc.ok());
+  ASSERT_EQ(now_rc.value()(ctx), now * 2);
+  ctx.Reset();
+  ASSERT_GT(ctx.NowUs(), now * 1000000);
+  ASSERT_EQ(ctx.NowUs(), ctx.NowUs());
+}
+
+static void check_tz_offset(Context& ctx, const std::vector<int64_t>& ts) {
+  auto offsets = functions::simd_vector_tz_offset(ctx, ts);
+  ASSERT_EQ(offsets.Size(), ts.size());
+  for (size_t i = 0; i < ts.size(); i++) {
+    time_t t = ts[i];
+    struct tm local;
+    localtime_r(&t, &local);
+    ASSERT_EQ(offsets[i], local.tm_gmtoff) << "ts:" << ts[i];
+  }
+}
+
+TEST(JitCompiler, vector_tz_offset) {
+  std::string saved_tz = getenv("TZ") != nullptr ? getenv("TZ") : "";
+  bool has_tz = getenv("TZ") != nullptr;
+  // posix rule, no tzdata needed
+  setenv("TZ", "EST5EDT,M3.2.0,M11.1.0", 1);
+  tzset();
+  rapidudf::Context ctx;
+  auto utc = [](int year, int mon, int day, int hour) {
+    struct tm tm = {};
+    tm.tm_year = year - 1900;
+    tm.tm_mon = mon - 1;
+    tm.tm_mday = day;
+    tm.tm_hour = hour;
+    return static_cast<int64_t>(timegm(&tm));
+  };
+  // 2024-03-10 02:00 EST -> EDT, 2024-11-03 02:00 EDT -> EST
+  int64_t spring = utc(2024, 3, 10, 7);
+  int64_t fall = utc(2024, 11, 3, 6);
+  auto offsets = functions::simd_vector_tz_offset(ctx, std::vector<int64_t>{spring - 1, spring, fall - 1, fall});
+  ASSERT_EQ(offsets[0], -18000);
+  ASSERT_EQ(offsets[1], -14400);
+  ASSERT_EQ(offsets[2], -14400);
+  ASSERT_EQ(offsets[3], -18000);
+
+  // every second around the transitions & the epoch
+  for (int64_t center : {spring, fall, int64_t(0)}) {
+    std::vector<int64_t> ts;
+    for (int64_t t = center - 1000; t <= center + 1000; t++) {
+      ts.emplace_back(t);
+    }
+    check_tz_offset(ctx, ts);
+  }
+
+  // posix rules have no dst before 1970, pre-epoch transitions come from tzdata:
+  // 1969-04-27 02:00 EST -> EDT, 1969-10-26 02:00 EDT -> EST
+  if (access("/usr/share/zoneinfo/America/New_York", R_OK) == 0) {
+    setenv("TZ", "America/New_York", 1);
+    tzset();
+    int64_t pre_spring = utc(1969, 4, 27, 7);
+    int64_t pre_fall = utc(1969, 10, 26, 6);
+    offsets =
+        functions::simd_vector_tz_offset(ctx, std::vector<int64_t>{pre_spring - 1, pre_spring, pre_fall - 1, pre_fall});
+    ASSERT_EQ(offsets[0], -18000);
+    ASSERT_EQ(offsets[1], -14400);
+    ASSERT_EQ(offsets[2], -14400);
+    ASSERT_EQ(offsets[3], -18000);
+    for (int64_t center : {pre_spring, pre_fall}) {
+      std::vector<int64_t> ts;
+      for (int64_t t = center - 1000; t <= center + 1000; t++) {
+        ts.emplace_back(t);
+      }
+      check_tz_offset(ctx, ts);
+    }
+  }
+
+  if (has_tz) {
+    setenv("TZ", saved_tz.c_str(), 1);
+  } else {
+    unsetenv("TZ");
+  }
+  tzset();
+}
+
+TEST(JitCompiler, vector_random) {
+  // Random123 known answer of philox4x32-10 with zero key & counter
+  ASSERT_EQ(functions::philox_random(0, 0, 0), 0xe169c58d6627e8d5ULL);
+  rapidudf::JitCompiler compiler;
+  rapidudf::Context ctx;
+  ctx.SetRequestId(12345);
+  std::string source = R"(
+    simd_vector<f64> test_func(Context ctx, simd_vector<u64> rows){
+      return rand_uniform(rows, 42) + rand_normal(rows, 42);
+    }
+  )";
+  auto rc = compiler.CompileFunction<Vector<double>, Context&, Vector<uint64_t>>(source);
+  if (!rc.ok()) {
+    RUDF_ERROR("{}", rc.status().ToString());
+  }
+  ASSERT_TRUE(rc.ok());
+  std::vector<uint64_t> rows(1001);
+  std::iota(rows.begin(), rows.end(), 0);
+  auto result = rc.value()(ctx, rows);
+  auto uniforms = functions::simd_vector_rand_uniform(ctx, rows, 42);
+  auto normals = functions::simd_vector_rand_normal(ctx, rows, 42);
+  double sum = 0;
+  for (size_t i = 0; i < rows.size(); i++) {
+    ASSERT_GE(uniforms[i], 0.0);
+    ASSERT_LT(uniforms[i], 1.0);
+    ASSERT_DOUBLE_EQ(result[i], uniforms[i] + normals[i]);
+    sum += uniforms[i];
+  }
+  ASSERT_NEAR(sum / rows.size(), 0.5, 0.05);
+
+  // same row gets same value regardless of batch layout
+  std::vector<uint64_t> sub_rows{500, 7, 1000};
+  auto sub_uniforms = functions::simd_vector_rand_uniform(ctx, sub_rows, 42);
+  for (size_t i = 0; i < sub_rows.size(); i++) {
+    ASSERT_EQ(sub_uniforms[i], uniforms[sub_rows[i]]);
+  }
+  ctx.SetRequestId(12346);
+  ASSERT_NE(functions::simd_vector_rand_uniform(ctx, sub_rows, 42)[0], sub_uniforms[0]);
+
+  auto bits = functions::simd_vector_rand_bernoulli(ctx, rows, 42, 0.25);
+  size_t trues = 0;
+  for (size_t i = 0; i < rows.size(); i++) {
+    trues += bits[i] ? 1 : 0;
+  }
+  ASSERT_NEAR(static_cast<double>(trues) / rows.size(), 0.25, 0.05);
+}
+
+TEST(JitCompiler, vector_half_float) {
+  rapidudf::JitCompiler compiler;
+  rapidudf::Context ctx;
+  std::string source = R"(
+    simd_vector<f16> test_func(Context ctx, simd_vector<f16> x, simd_vector<f32> y){
+      return x * y + 1;
+    }
+  )";
+  auto rc = compiler.CompileFunction<Vector<Float16>, Context&, Vector<Float16>, Vector<float>>(source);
+  if (!rc.ok()) {
+    RUDF_ERROR("{}", rc.status().ToString());
+  }
+  ASSERT_TRUE(rc.ok());
+  std::vector<float> xs, ys;
+  for (size_t i = 0; i < 101; i++) {
+    xs.emplace_back(static_cast<float>(i) * 0.25f - 10);
+    ys.emplace_back(static_cast<float>(i % 7) * 0.5f);
+  }
+  auto x_f16 = functions::simd_vector_to_f16(ctx, xs);
+  auto result = rc.value()(ctx, x_f16, ys);
+  ASSERT_EQ(result.Size(), xs.size());
+  auto widened = functions::simd_vector_to_f32(ctx, result);
+  for (size_t i = 0; i < xs.size(); i++) {
+    ASSERT_NEAR(widened[i], xs[i] * ys[i] + 1, 0.05f);
+  }
+
+  auto x_bf16 = functions::simd_vector_to_bf16(ctx, xs);
+  auto x_bf16_f32 = functions::simd_vector_to_f32(ctx, x_bf16);
+  for (size_t i = 0; i < xs.size(); i++) {
+    ASSERT_EQ(x_bf16[i].Bits(), BFloat16(xs[i]).Bits());
+    ASSERT_NEAR(x_bf16_f32[i], xs[i], std::fabs(xs[i]) / 128);
+  }
+
+  auto q = functions::simd_vector_quantize(ctx, xs, 0.0625f);
+  auto dq = functions::simd_vector_dequantize(ctx, q, 0.0625f);
+  for (size_t i = 0; i < xs.size(); i++) {
+    float expected = std::min(std::max(std::nearbyint(xs[i] / 0.0625f), -128.0f), 127.0f);
+    ASSERT_EQ(q[i], static_cast<int8_t>(expected));
+    ASSERT_FLOAT_EQ(dq[i], expected * 0.0625f);
+  }
+  ASSERT_THROW(functions::simd_vector_quantize(ctx, xs, 0), std::logic_error);
+}
+
+TEST(JitCompiler, vector_bf16) {
+  rapidudf::JitCompiler compiler;
+  rapidudf::Context ctx;
+  std::string source = R"(
+    simd_vector<bf16> test_func(Context ctx, simd_vector<bf16> x, simd_vector<f32> y){
+      return x * y + 1;
+    }
+  )";
+  auto rc = compiler.CompileFunction<Vector<BFloat16>, Context&, Vector<BFloat16>, Vector<float>>(source);
+  if (!rc.ok()) {
+    RUDF_ERROR("{}", rc.status().ToString());
+  }
+  ASSERT_TRUE(rc.ok());
+  std::vector<float> xs, ys;
+  for (size_t i = 0; i < 101; i++) {
+    xs.emplace_back(static_cast<float>(i) * 0.25f - 10);
+    ys.emplace_back(static_cast<float>(i % 7) * 0.5f);
+  }
+  auto x_bf16 = functions::simd_vector_to_bf16(ctx, xs);
+  auto result = rc.value()(ctx, x_bf16, ys);
+  ASSERT_EQ(result.Size(), xs.size());
+  auto widened = functions::simd_vector_to_f32(ctx, result);
+  for (size_t i = 0; i < xs.size(); i++) {
+    // computed in f32 from the bf16 input, then narrowed once
+    float expected = static_cast<float>(BFloat16(static_cast<float>(x_bf16[i]) * ys[i] + 1));
+    ASSERT_FLOAT_EQ(widened[i], expected);
+  }
+}
+
+TEST(JitCompiler, vector_direct_dispatch) {
+  rapidudf::Context ctx;
+  std::vector<float> xs, ys;
+  for (size_t i = 0; i < 37; i++) {
+    xs.emplace_back(static_cast<float>(i) * 0.5f - 3);
+    ys.emplace_back(static_cast<float>(i % 5) + 1);
+  }
+  std::string expr = "clamp(hypot(x, y) + sin(x), y, 10)";
+  std::vector<std::vector<float>> results;
+  for (bool direct : {true, false}) {
+    compiler::Options opts;
+    opts.direct_simd_dispatch = direct;
+    rapidudf::JitCompiler compiler(opts);
+    auto rc = compiler.CompileExpression<Vector<float>, Context&, Vector<float>, Vector<float>>(expr, {"_", "x", "y"});
+    ASSERT_TRUE(rc.ok());
+    auto result = rc.value()(ctx, xs, ys);
+    ASSERT_EQ(result.Size(), xs.size());
+    results.emplace_back();
+    for (size_t i = 0; i < result.Size(); i++) {
+      results.back().emplace_back(result[i]);
+    }
+  }
+  for (size_t i = 0; i < xs.size(); i++) {
+    ASSERT_FLOAT_EQ(results[0][i], results[1][i]);
+    ASSERT_NEAR(results[0][i], std::clamp(std::hypot(xs[i], ys[i]) + std::sin(xs[i]), ys[i], 10.0f), 1e-4);
+  }
+
+  auto* desc = FunctionFactory::GetFunction(GetFunctionName(OP_SIN, get_dtype<float>().ToSimdVector()));
+  ASSERT_TRUE(desc != nullptr);
+  ASSERT_TRUE(desc->GetJitFunc() != nullptr);
+  ASSERT_NE(desc->GetJitFunc(), desc->func);
+}
+
+template <typename T>
+static void check_window_values(const std::vector<T>& expected, Vector<T> result) {
+  ASSERT_EQ(result.Size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    if constexpr (std::is_floating_point_v<T>) {
+      ASSERT_NEAR(result[i], expected[i], 1e-4);
+    } else {
+      ASSERT_EQ(result[i], expected[i]);
+    }
+  }
+}
+
+template <typename T>
+static void test_window_funcs(size_t n) {
+  rapidudf::Context ctx;
+  std::vector<T> data;
+  for (size_t i = 0; i < n; i++) {
+    if constexpr (std::is_floating_point_v<T>) {
+      data.emplace_back(static_cast<T>((i * 7) % 13) * 0.5 - 3);
+    } else {
+      data.emplace_back(static_cast<T>((i * 7) % 13) - 6);
+    }
+  }
+  Vector<T> vec(data);
+
+  std::vector<T> sums(n), maxs(n), mins(n);
+  for (size_t i = 0; i < n; i++) {
+    sums[i] = i == 0 ? data[i] : sums[i - 1] + data[i];
+    maxs[i] = i == 0 ? data[i] : std::max(maxs[i - 1], data[i]);
+    mins[i] = i == 0 ? data[i] : std::min(mins[i - 1], data[i]);
+  }
+  check_window_values(sums, functions::simd_vector_cumsum(ctx, vec));
+  check_window_values(maxs, functions::simd_vector_cummax(ctx, vec));
+  check_window_values(mins, functions::simd_vector_cummin(ctx, vec));
+
+  for (size_t k : {size_t(0), size_t(1), size_t(5), n, n + 3}) {
+    std::vector<T> lags(n), leads(n);
+    for (size_t i = 0; i < n; i++) {
+      lags[i] = i >= k ? data[i - k] : T{};
+      leads[i] = i + k < n ? data[i + k] : T{};
+    }
+    check_window_values(lags, functions::simd_vector_lag(ctx, vec, k));
+    check_window_values(leads, functions::simd_vector_lead(ctx, vec, k));
+  }
+
+  for (size_t window : {size_t(1), size_t(3), size_t(16), n + 5}) {
+    std::vector<T> rolling_sums(n), rolling_avgs(n);
+    for (size_t i = 0; i < n; i++) {
+      size_t start = i + 1 > window ? i + 1 - window : 0;
+      T sum = 0;
+      for (size_t j = start; j <= i; j++) {
+        sum += data[j];
+      }
+      rolling_sums[i] = sum;
+      rolling_avgs[i] = sum / static_cast<T>(i + 1 - start);
+    }
+    check_window_values(rolling_sums, functions::simd_vector_rolling_sum(ctx, vec, window));
+    if constexpr (std::is_floating_point_v<T>) {
+      check_window_values(rolling_avgs, functions::simd_vector_rolling_avg(ctx, vec, window));
+    }
+  }
+}
+
+TEST(JitCompiler, vector_window_funcs) {
+  // sizes not multiple of any simd width
+  for (size_t n : {1, 7, 37, 101}) {
+    test_window_funcs<int32_t>(n);
+    test_window_funcs<int64_t>(n);
+    test_window_funcs<float>(n);
+    test_window_funcs<double>(n);
+  }
+}
+
+TEST(JitCompiler, vector_window_funcs_expr) {
+  rapidudf::JitCompiler compiler;
+  rapidudf::Context ctx;
+  std::string source = R"(
+    simd_vector<f64> test_func(Context ctx, simd_vector<f64> x){
+      return cumsum(x) + cummax(x) - cummin(x) + lag(x, 1) - lead(x, 2) + rolling_sum(x, 3) * rolling_avg(x, 4);
+    }
+  )";
+  auto rc = compiler.CompileFunction<Vector<double>, Context&, Vector<double>>(source);
+  if (!rc.ok()) {
+    RUDF_ERROR("{}", rc.status().ToString());
+  }
+  ASSERT_TRUE(rc.ok());
+  std::vector<double> data;
+  for (size_t i = 0; i < 37; i++) {
+    data.emplace_back(static_cast<double>((i * 7) % 13) * 0.5 - 3);
+  }
+  auto result = rc.value()(ctx, data);
+  auto cumsum = functions::simd_vector_cumsum<double>(ctx, data);
+  auto cummax = functions::simd_vector_cummax<double>(ctx, data);
+  auto cummin = functions::simd_vector_cummin<double>(ctx, data);
+  auto lag = functions::simd_vector_lag<double>(ctx, data, 1);
+  auto lead = functions::simd_vector_lead<double>(ctx, data, 2);
+  auto rolling_sum = functions::simd_vector_rolling_sum<double>(ctx, data, 3);
+  auto rolling_avg = functions::simd_vector_rolling_avg<double>(ctx, data, 4);
+  ASSERT_EQ(result.Size(), data.size());
+  for (size_t i = 0; i < data.size(); i++) {
+    ASSERT_DOUBLE_EQ(result[i], cumsum[i] + cummax[i] - cummin[i] + lag[i] - lead[i] + rolling_sum[i] * rolling_avg[i]);
+  }
+
+  source = R"(
+    simd_vector<u32> test_func(Context ctx, simd_vector<string_view> x){
+      return rank(x) * 100 + dense_rank(x);
+    }
+  )";
+  auto rank_rc = compiler.CompileFunction<Vector<uint32_t>, Context&, Vector<StringView>>(source);
+  if (!rank_rc.ok()) {
+    RUDF_ERROR("{}", rank_rc.status().ToString());
+  }
+  ASSERT_TRUE(rank_rc.ok());
+  std::vector<StringView> strs{"a", "a", "b", "c", "c", "c", "d"};
+  auto ranks = rank_rc.value()(ctx, strs);
+  std::vector<uint32_t> expected{101, 101, 302, 403, 403, 403, 704};
+  for (size_t i = 0; i < strs.size(); i++) {
+    ASSERT_EQ(ranks[i], expected[i]);
+  }
+}
@@ -18,10 +18,12 @@
 #include <array>
 #include <cmath>
 #include <random>
+#include <regex>
 #include <string_view>
 #include <vector>
 
 #include "rapidudf/functions/simd/string.h"
+#include "rapidudf/functions/simd/string_match.h"
 #include "rapidudf/log/log.h"
 #include "rapidudf/rapidudf.h"
 
@@ -47,6 +49,39 @@ static void BM_rapidudf_simd_string_split(benchmark::State& state) {
 }
 BENCHMARK(BM_rapidudf_simd_string_split);
 
+static void BM_rapidudf_simd_string_split_arena(benchmark::State& state) {
+  size_t n = 0;
+  rapidudf::Context ctx;
+  for (auto _ : state) {
+    auto ss = rapidudf::functions::simd_string_split(ctx, rapidudf::StringView(test_str), ",");
+    for (size_t i = 0; i < ss.Size(); i++) {
+      auto tag_list = rapidudf::functions::simd_string_split(ctx, ss[i], ";");
+      n += tag_list.Size();
+    }
+    ctx.Reset();
+  }
+  RUDF_DEBUG("{}", n);
+}
+BENCHMARK(BM_rapidudf_simd_string_split_arena);
+
+static void BM_rapidudf_simd_split_to_columns(benchmark::State& state) {
+  rapidudf::Context ctx;
+  std::vector<rapidudf::StringView> rows;
+  for (auto s : rapidudf::functions::simd_string_split_by_char(test_str, ',')) {
+    rows.emplace_back(s);
+  }
+  std::vector<rapidudf::DType> dtypes{rapidudf::DType(rapidudf::DATA_STRING_VIEW), rapidudf::DType(rapidudf::DATA_U64),
+                                      rapidudf::DType(rapidudf::DATA_STRING_VIEW),
+                                      rapidudf::DType(rapidudf::DATA_STRING_VIEW)};
+  std::vector<rapidudf::VectorBuf> columns;
+  for (auto _ : state) {
+    auto status = rapidudf::functions::simd_vector_split_to_columns(ctx, rows, ":", dtypes, columns);
+    benchmark::DoNotOptimize(status);
+    ctx.Reset();
+  }
+}
+BENCHMARK(BM_rapidudf_simd_split_to_columns);
+
 static void BM_rapidudf_absl_string_split(benchmark::State& state) {
   size_t n = 0;
   for (auto _ : state) {
@@ -61,4 +96,57 @@ static void BM_rapidudf_absl_string_split(benchmark::State& state) {
 
 BENCHMARK(BM_rapidudf_absl_string_split);
 
+static std::vector<std::string> get_match_test_strs() {
+  std::vector<std::string> strs;
+  std::mt19937 gen(1);
+  for (size_t i = 0; i < 4096; i++) {
+    std::string s = "user_" + std::to_string(gen() % 100000);
+    if (i % 4 == 0) {
+      s.append("@mail.example.com");
+    } else {
+      s.append("#tag_").append(std::to_string(gen()));
+    }
+    strs.emplace_back(std::move(s));
+  }
+  return strs;
+}
+static const char* kMatchRegex = "^user_[0-9]+@[a-z]+\\.example\\.com$";
+
+static void BM_rapidudf_regex_match(benchmark::State& state) {
+  auto strs = get_match_test_strs();
+  std::vector<rapidudf::StringView> views(strs.begin(), strs.end());
+  rapidudf::Context ctx;
+  for (auto _ : state) {
+    auto bits = rapidudf::functions::simd_vector_regex_match(ctx, views, kMatchRegex);
+    benchmark::DoNotOptimize(bits);
+    ctx.Reset();
+  }
+}
+BENCHMARK(BM_rapidudf_regex_match);
+
+static void BM_std_regex_match(benchmark::State& state) {
+  auto strs = get_match_test_strs();
+  std::regex re(kMatchRegex);
+  for (auto _ : state) {
+    size_t n = 0;
+    for (const auto& s : strs) {
+      n += std::regex_search(s, re);
+    }
+    benchmark::DoNotOptimize(n);
+  }
+}
+BENCHMARK(BM_std_regex_match);
+
+static void BM_rapidudf_like(benchmark::State& state) {
+  auto strs = get_match_test_strs();
+  std::vector<rapidudf::StringView> views(strs.begin(), strs.end());
+  rapidudf::Context ctx;
+  for (auto _ : state) {
+    auto bits = rapidudf::functions::simd_vector_like(ctx, views, "user_%@mail%");
+    benchmark::DoNotOptimize(bits);
+    ctx.Reset();
+  }
+}
+BENCHMARK(BM_rapidudf_like);
+
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "rapidudf/functions/simd/string.h"
+#include "rapidudf/functions/simd/string_match.h"
 #include "rapidudf/log/log.h"
 #include "rapidudf/rapidudf.h"
 
@@ -83,4 +84,144 @@ TEST(JitCompiler, find_by_ch) {
   auto pos = functions::simd_string_find_char(str, ',');
 
   ASSERT_EQ(pos, 3);
-}
\ No newline at end of file
+}
+
+TEST(JitCompiler, split_to_columns) {
+  Context ctx;
+  std::vector<std::string> rows{"v3:3950308951:tag:0.25", "v4:-17:x:1.5e3", "v5", ""};
+  std::vector<StringView> strs(rows.begin(), rows.end());
+  std::vector<DType> dtypes{DType(DATA_STRING_VIEW), DType(DATA_I64), DType(DATA_STRING_VIEW), DType(DATA_F64)};
+  std::vector<VectorBuf> columns;
+  auto status = functions::simd_vector_split_to_columns(ctx, strs, ":", dtypes, columns);
+  ASSERT_TRUE(status.ok());
+  ASSERT_EQ(columns.size(), 4);
+  Vector<StringView> c0(columns[0]);
+  Vector<int64_t> c1(columns[1]);
+  Vector<double> c3(columns[3]);
+  ASSERT_EQ(c0[1], "v4");
+  ASSERT_EQ(c1[0], 3950308951);
+  ASSERT_EQ(c1[1], -17);
+  ASSERT_EQ(c1[2], 0);
+  ASSERT_DOUBLE_EQ(c3[0], 0.25);
+  ASSERT_DOUBLE_EQ(c3[1], 1500);
+  ASSERT_EQ(c0[3].size(), 0);
+
+  // empty fields keep their position
+  rows = {"a::c:1.5", ":7", "x:8::"};
+  strs = std::vector<StringView>(rows.begin(), rows.end());
+  status = functions::simd_vector_split_to_columns(ctx, strs, ":", dtypes, columns);
+  ASSERT_TRUE(status.ok());
+  Vector<StringView> e0(columns[0]);
+  Vector<int64_t> e1(columns[1]);
+  Vector<StringView> e2(columns[2]);
+  Vector<double> e3(columns[3]);
+  ASSERT_EQ(e0[0], "a");
+  ASSERT_EQ(e1[0], 0);
+  ASSERT_EQ(e2[0], "c");
+  ASSERT_DOUBLE_EQ(e3[0], 1.5);
+  ASSERT_EQ(e0[1].size(), 0);
+  ASSERT_EQ(e1[1], 7);
+  ASSERT_EQ(e2[1].size(), 0);
+  ASSERT_EQ(e1[2], 8);
+  ASSERT_EQ(e2[2].size(), 0);
+  ASSERT_DOUBLE_EQ(e3[2], 0);
+  // `split` still skips empty parts
+  auto split_parts = functions::simd_string_split(ctx, "a::c", ":");
+  ASSERT_EQ(split_parts.Size(), 2);
+  ASSERT_EQ(split_parts[1], "c");
+
+  dtypes = {DType(DATA_JSON)};
+  ASSERT_FALSE(functions::simd_vector_split_to_columns(ctx, strs, ":", dtypes, columns).ok());
+}
+
+TEST(JitCompiler, to_int_to_float) {
+  JitCompiler compiler;
+  Context ctx;
+  std::vector<std::string> nums{"0", "-9223372036854775808", "1234567812345678", "+7", "abc", "0.5"};
+  std::vector<StringView> strs(nums.begin(), nums.end());
+  auto rc = compiler.CompileExpression<Vector<int64_t>, Context&, Vector<StringView>>("to_int(x)", {"_", "x"});
+  if (!rc.ok()) {
+    RUDF_ERROR("{}", rc.status().ToString());
+  }
+  ASSERT_TRUE(rc.ok());
+  auto ints = rc.value()(ctx, strs);
+  ASSERT_EQ(ints[1], std::numeric_limits<int64_t>::min());
+  ASSERT_EQ(ints[2], 1234567812345678);
+  ASSERT_EQ(ints[3], 7);
+  ASSERT_EQ(ints[4], 0);
+  ASSERT_EQ(ints[5], 0);
+
+  auto floats = functions::simd_vector_to_float(ctx, strs);
+  ASSERT_DOUBLE_EQ(floats[2], 1234567812345678.0);
+  ASSERT_DOUBLE_EQ(floats[5], 0.5);
+  ASSERT_DOUBLE_EQ(floats[4], 0);
+
+  auto parts = functions::simd_vector_split_part(ctx, strs, "5", 1);
+  ASSERT_EQ(parts[2], "678123");
+  ASSERT_EQ(parts[0].size(), 0);
+}
+
+TEST(JitCompiler, like) {
+  JitCompiler compiler;
+  Context ctx;
+  std::vector<std::string> strs{"abc", "abcd", "xabc", "a_c", "ac", ""};
+  std::vector<StringView> views(strs.begin(), strs.end());
+  auto rc = compiler.CompileExpression<Vector<Bit>, Context&, Vector<StringView>>(R"(like(x, "abc%"))", {"_", "x"});
+  if (!rc.ok()) {
+    RUDF_ERROR("{}", rc.status().ToString());
+  }
+  ASSERT_TRUE(rc.ok());
+  auto bits = rc.value()(ctx, views);
+  ASSERT_EQ(bits[0], true);
+  ASSERT_EQ(bits[1], true);
+  ASSERT_EQ(bits[2], false);
+
+  bits = functions::simd_vector_like(ctx, views, "a_c");
+  ASSERT_EQ(bits[0], true);
+  ASSERT_EQ(bits[3], true);
+  ASSERT_EQ(bits[1], false);
+  ASSERT_EQ(bits[4], false);
+  bits = functions::simd_vector_like(ctx, views, "%");
+  ASSERT_EQ(bits[5], true);
+  ASSERT_TRUE(functions::string_like("a%c", "a\\%c"));
+  ASSERT_FALSE(functions::string_like("abc", "a\\%c"));
+  ASSERT_TRUE(functions::string_like("xaybz", "%a%b%"));
+  ASSERT_FALSE(functions::string_like("xbyaz", "%a%b%"));
+
+  auto rc2 = compiler.CompileExpression<bool, StringView>(R"(x.like("%bc"))", {"x"});
+  ASSERT_TRUE(rc2.ok());
+  ASSERT_TRUE(rc2.value()("xabc"));
+  ASSERT_FALSE(rc2.value()("xab"));
+}
+
+TEST(JitCompiler, regex_match) {
+  JitCompiler compiler;
+  Context ctx;
+  std::vector<std::string> strs{"id=123", "id=", "ID=9", "xid=42y", "abab", "ba"};
+  std::vector<StringView> views(strs.begin(), strs.end());
+  auto rc = compiler.CompileExpression<Vector<Bit>, Context&, Vector<StringView>>(R"(regex_match(x, "id=[0-9]+"))",
+                                                                                 {"_", "x"});
+  if (!rc.ok()) {
+    RUDF_ERROR("{}", rc.status().ToString());
+  }
+  ASSERT_TRUE(rc.ok());
+  auto bits = rc.value()(ctx, views);
+  ASSERT_EQ(bits[0], true);
+  ASSERT_EQ(bits[1], false);
+  ASSERT_EQ(bits[2], false);
+  ASSERT_EQ(bits[3], true);
+
+  bits = functions::simd_vector_regex_match(ctx, views, "^(ab)+$");
+  ASSERT_EQ(bits[0], false);
+  ASSERT_EQ(bits[4], true);
+  ASSERT_EQ(bits[5], false);
+  ASSERT_TRUE(functions::string_regex_match("ba", "[^a]a$"));
+  ASSERT_TRUE(functions::string_regex_match("aaa", "^a{2,3}$"));
+  ASSERT_FALSE(functions::string_regex_match("aaaa", "^a{2,3}$"));
+  ASSERT_THROW(functions::string_regex_match("a", "a("), std::logic_error);
+
+  auto matcher = functions::StringMatcher::CompileRegex("(a|b)*a(a|b){8}");
+  ASSERT_TRUE(matcher.ok());
+  ASSERT_TRUE(matcher.value()->Match("bbbabbbbbbbb"));
+  ASSERT_FALSE(matcher.value()->Match("bbbbbabbbbb"));
+}
@@ -16,7 +16,9 @@
 
 #pragma once
 #include <stddef.h>
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 namespace rapidudf {
 class Bit {
  public:
@@ -64,6 +66,24 @@ inline void bits_set(uint64_t* bits, size_t k, bool v) {
   }
 }
 
+inline bool bits_get(const uint8_t* bits, size_t k) { return (bits[k / 8] >> (k % 8)) & 1; }
+
+// position of first set bit in [from, n), or n if none, scans 64 bits a time
+inline size_t bits_next_set(const uint8_t* bits, size_t from, size_t n) {
+  size_t bytes = (n + 7) / 8;
+  while (from < n) {
+    size_t word_idx = from / 64;
+    uint64_t word = 0;
+    memcpy(&word, bits + word_idx * 8, std::min<size_t>(8, bytes - word_idx * 8));
+    word &= ~0ULL << (from % 64);
+    if (word != 0) {
+      return std::min(n, word_idx * 64 + __builtin_ctzll(word));
+    }
+    from = (word_idx + 1) * 64;
+  }
+  return n;
+}
+
 inline void bits_set(uint8_t* bits, size_t k, bool v) {
   size_t idx = k / 8;
   size_t cursor = k % 8;
@@ -54,6 +54,12 @@ std::vector<std::string> DynObjectSchema::ListAll() {
   return names;
 }
 
+size_t DynObjectSchema::Size() {
+  auto& [table_mutex, table] = get_schema_table();
+  std::lock_guard<std::mutex> guard(table_mutex);
+  return table.size();
+}
+
 DynObjectSchema::DynObjectSchema(const std::string& name, Options opts) : name_(name), opts_(opts) {
   allocated_offset_ = opts_.object_header_byte_size;
 }
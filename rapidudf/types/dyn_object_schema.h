@@ -49,6 +49,7 @@ class DynObjectSchema {
   static const DynObjectSchema* Get(const std::string& name);
   static DynObjectSchema* GetMutable(const std::string& name);
   static std::vector<std::string> ListAll();
+  static size_t Size();
 
   typename DynObject::SmartPtr NewObject() const;
   bool ExistField(const std::string& name, const DType& dtype) const;
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2024 yinqiwen yinqiwen@gmail.com. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+namespace rapidudf {
+namespace detail {
+inline uint32_t f32_bits(float v) {
+  uint32_t bits;
+  memcpy(&bits, &v, sizeof(bits));
+  return bits;
+}
+inline float f32_from_bits(uint32_t bits) {
+  float v;
+  memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+}  // namespace detail
+
+/**
+** IEEE 754 half precision storage type, only used to store values, computations are done in float.
+** Same layout as `hwy::float16_t`.
+*/
+class Float16 {
+ public:
+  Float16() = default;
+  explicit Float16(float v) : bits_(FromFloat(v)) {}
+  operator float() const { return ToFloat(bits_); }
+  uint16_t Bits() const { return bits_; }
+  static Float16 FromBits(uint16_t bits) {
+    Float16 v;
+    v.bits_ = bits;
+    return v;
+  }
+
+  // round to nearest even, overflow to inf.
+  static uint16_t FromFloat(float v) {
+    constexpr uint32_t kF32Inf = 255u << 23;
+    constexpr uint32_t kF16Max = (127u + 16) << 23;
+    constexpr uint32_t kDenormMagic = ((127u - 15) + (23 - 10) + 1) << 23;
+    uint32_t x = detail::f32_bits(v);
+    uint32_t sign = x & 0x80000000u;
+    x ^= sign;
+    uint16_t h = 0;
+    if (x >= kF16Max) {
+      h = x > kF32Inf ? 0x7e00 : 0x7c00;
+    } else if (x < (113u << 23)) {
+      // subnormal half, let the float adder do the rounding
+      h = static_cast<uint16_t>(
+          detail::f32_bits(detail::f32_from_bits(x) + detail::f32_from_bits(kDenormMagic)) - kDenormMagic);
+    } else {
+      uint32_t mant_odd = (x >> 13) & 1;
+      x += ((15u - 127u) << 23) + 0xfff + mant_odd;
+      h = static_cast<uint16_t>(x >> 13);
+    }
+    return h | static_cast<uint16_t>(sign >> 16);
+  }
+  static float ToFloat(uint16_t h) {
+    constexpr uint32_t kShiftedExp = 0x7c00u << 13;
+    uint32_t x = (h & 0x7fffu) << 13;
+    uint32_t exp = kShiftedExp & x;
+    x += (127u - 15) << 23;
+    if (exp == kShiftedExp) {
+      x += (128u - 16) << 23;
+    } else if (exp == 0) {
+      x += 1u << 23;
+      x = detail::f32_bits(detail::f32_from_bits(x) - detail::f32_from_bits(113u << 23));
+    }
+    x |= (h & 0x8000u) << 16;
+    return detail::f32_from_bits(x);
+  }
+
+ private:
+  uint16_t bits_ = 0;
+};
+
+/**
+** bfloat16 storage type, the upper 16 bits of a float, same layout as `hwy::bfloat16_t`.
+*/
+class BFloat16 {
+ public:
+  BFloat16() = default;
+  explicit BFloat16(float v) : bits_(FromFloat(v)) {}
+  operator float() const { return ToFloat(bits_); }
+  uint16_t Bits() const { return bits_; }
+  static BFloat16 FromBits(uint16_t bits) {
+    BFloat16 v;
+    v.bits_ = bits;
+    return v;
+  }
+
+  // round to nearest even, nan stays quiet nan.
+  static uint16_t FromFloat(float v) {
+    uint32_t x = detail::f32_bits(v);
+    if ((x & 0x7fffffffu) > 0x7f800000u) {
+      return static_cast<uint16_t>((x >> 16) | 0x40);
+    }
+    x += 0x7fff + ((x >> 16) & 1);
+    return static_cast<uint16_t>(x >> 16);
+  }
+  static float ToFloat(uint16_t h) { return detail::f32_from_bits(static_cast<uint32_t>(h) << 16); }
+
+ private:
+  uint16_t bits_ = 0;
+};
+
+template <typename T>
+constexpr bool is_half_float_v = std::is_same_v<Float16, T> || std::is_same_v<BFloat16, T>;
+
+static_assert(sizeof(Float16) == 2, "sizeof(Float16) != 2");
+static_assert(sizeof(BFloat16) == 2, "sizeof(BFloat16) != 2");
+}  // namespace rapidudf